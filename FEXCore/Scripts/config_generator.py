@@ -30,6 +30,9 @@ def print_header():
 #ifndef OPT_STRENUM
 #define OPT_STRENUM(group, enum, json, default) OPT_BASE(uint64_t, group, enum, json, default)
 #endif
+#ifndef OPT_CODEGEN
+#define OPT_CODEGEN(enum)
+#endif
 '''
     output_file.write(header)
 
@@ -43,6 +46,7 @@ def print_tail():
 #undef OPT_STR
 #undef OPT_STRARRAY
 #undef OPT_STRENUM
+#undef OPT_CODEGEN
 '''
     output_file.write(tail)
 
@@ -65,6 +69,20 @@ def print_options(options):
 
         output_file.write("\n")
 
+def print_codegen_options(options, unnamed_options):
+    output_file.write("// Configuration options that affect generated code\n")
+    for op_group, group_vals in options.items():
+        for op_key, op_vals in group_vals.items():
+            if op_vals.get("AffectsCodegen", False):
+                output_file.write("OPT_CODEGEN ({0})\n".format(op_key.upper()))
+
+    for op_group, group_vals in unnamed_options.items():
+        for op_key, op_vals in group_vals.items():
+            if op_vals.get("AffectsCodegen", False):
+                output_file.write("OPT_CODEGEN ({0})\n".format(op_key.upper()))
+
+    output_file.write("\n")
+
 def print_unnamed_options(options):
     output_file.write("// Unnamed configuration options\n")
     for op_group, group_vals in options.items():
@@ -428,6 +446,7 @@ output_file = open(output_filename, "w")
 print_header()
 print_options(options)
 print_unnamed_options(unnamed_options)
+print_codegen_options(options, unnamed_options)
 print_tail()
 output_file.close()
 
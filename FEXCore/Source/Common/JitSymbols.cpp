@@ -1,29 +1,156 @@
 // SPDX-License-Identifier: MIT
+#include <FEXCore/HLE/SourcecodeResolver.h>
+#include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/Syscalls.h>
 
 #include "Common/JitSymbols.h"
+#include "Interface/Core/JIT/DebugData.h"
 
+#include <cstring>
+#include <ctime>
 #include <fcntl.h>
+#include <limits>
 #include <unistd.h>
 
+#ifndef _WIN32
+#include <elf.h>
+#include <sys/mman.h>
+#endif
+
 namespace FEXCore {
+namespace {
+  // Layouts from perf's jitdump specification (tools/perf/Documentation/jitdump-specification.txt)
+  constexpr uint32_t JITDUMP_MAGIC = 0x4A695444;
+  constexpr uint32_t JITDUMP_VERSION = 1;
+
+  enum JitDumpRecordType : uint32_t {
+    JIT_CODE_LOAD = 0,
+    JIT_CODE_DEBUG_INFO = 2,
+  };
+
+  struct JitDumpHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t TotalSize;
+    uint32_t ElfMachine;
+    uint32_t Pad;
+    uint32_t PID;
+    uint64_t Timestamp;
+    uint64_t Flags;
+  };
+
+  struct JitDumpRecordHeader {
+    uint32_t ID;
+    uint32_t TotalSize;
+    uint64_t Timestamp;
+  };
+
+  // Followed by the null terminated symbol name and the code bytes
+  struct JitDumpCodeLoad {
+    JitDumpRecordHeader Header;
+    uint32_t PID;
+    uint32_t TID;
+    uint64_t VMA;
+    uint64_t CodeAddr;
+    uint64_t CodeSize;
+    uint64_t CodeIndex;
+  };
+
+  // Followed by NumEntries debug entries
+  struct JitDumpDebugInfo {
+    JitDumpRecordHeader Header;
+    uint64_t CodeAddr;
+    uint64_t NumEntries;
+  };
+
+  // Followed by the null terminated source file name
+  struct JitDumpDebugEntry {
+    uint64_t Addr;
+    int32_t LineNumber;
+    int32_t Discriminator;
+  };
+
+  // perf needs to be recording with the same clock (`perf record -k mono`) to match these up with samples
+  uint64_t GetMonotonicNS() {
+    timespec Time {};
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+    return Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec;
+  }
+
+  fextl::string GetPerfFolder() {
+#ifdef __ANDROID__
+    // Android simpleperf looks in /data/local/tmp instead of /tmp
+    return "/data/local/tmp";
+#else
+    return "/tmp";
+#endif
+  }
+} // namespace
+
 JITSymbols::JITSymbols() {}
 
 JITSymbols::~JITSymbols() {
   if (fd != -1) {
     close(fd);
   }
+  CloseJitDump();
 }
 
 void JITSymbols::InitFile() {
   // We can't use FILE here since we must be robust against forking processes closing our FD from under us.
-#ifdef __ANDROID__
-  // Android simpleperf looks in /data/local/tmp instead of /tmp
-  const auto PerfMap = fextl::fmt::format("/data/local/tmp/perf-{}.map", getpid());
+  const auto PerfMap = fextl::fmt::format("{}/perf-{}.map", GetPerfFolder(), getpid());
+  fd = open(PerfMap.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_APPEND, 0644);
+}
+
+void JITSymbols::InitJitDump() {
+#ifndef _WIN32
+  const auto JitDump = fextl::fmt::format("{}/jit-{}.dump", GetPerfFolder(), getpid());
+  // O_APPEND keeps the records of each write together when multiple threads flush their buffers.
+  JitDumpFD = open(JitDump.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_APPEND | O_CLOEXEC, 0644);
+  if (JitDumpFD == -1) {
+    LogMan::Msg::EFmt("Failed to open {}: {}", JitDump, strerror(errno));
+    return;
+  }
+
+  const JitDumpHeader Header {
+    .Magic = JITDUMP_MAGIC,
+    .Version = JITDUMP_VERSION,
+    .TotalSize = sizeof(JitDumpHeader),
+#ifdef ARCHITECTURE_arm64
+    .ElfMachine = EM_AARCH64,
 #else
-  const auto PerfMap = fextl::fmt::format("/tmp/perf-{}.map", getpid());
+    .ElfMachine = EM_X86_64,
+#endif
+    .PID = static_cast<uint32_t>(getpid()),
+    .Timestamp = GetMonotonicNS(),
+  };
+  if (write(JitDumpFD, &Header, sizeof(Header)) != sizeof(Header)) {
+    CloseJitDump();
+    return;
+  }
+
+  // perf only finds the jitdump through an executable mapping of it in the recorded mmap events.
+  JitDumpMarker = ::mmap(nullptr, FEXCore::Utils::FEX_PAGE_SIZE, PROT_READ | PROT_EXEC, MAP_PRIVATE, JitDumpFD, 0);
+  if (JitDumpMarker == MAP_FAILED) {
+    LogMan::Msg::EFmt("Failed to map {}, perf won't be able to find it. Is {} mounted noexec?", JitDump, GetPerfFolder());
+    JitDumpMarker = nullptr;
+  }
+#endif
+}
+
+void JITSymbols::CloseJitDump() {
+#ifndef _WIN32
+  if (JitDumpMarker) {
+    ::munmap(JitDumpMarker, FEXCore::Utils::FEX_PAGE_SIZE);
+    JitDumpMarker = nullptr;
+  }
+  if (JitDumpFD != -1) {
+    close(JitDumpFD);
+    JitDumpFD = -1;
+  }
 #endif
-  fd = open(PerfMap.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_APPEND, 0644);
 }
 
 void JITSymbols::RegisterNamedRegion(const void* HostAddr, uint32_t CodeSize, std::string_view Name) {
@@ -128,19 +255,137 @@ void JITSymbols::RegisterNamedRegion(FEXCore::JITSymbolBuffer* Buffer, const voi
   WriteBuffer(Buffer);
 }
 
-void JITSymbols::WriteBuffer(FEXCore::JITSymbolBuffer* Buffer, bool ForceWrite) {
+void JITSymbols::RegisterJitDump(FEXCore::JITSymbolBuffer* Buffer, const void* HostAddr, uint32_t CodeSize, uint64_t GuestRIP,
+                                 std::string_view Name, const FEXCore::Core::DebugData& DebugData, std::string_view ModuleName,
+                                 uintptr_t ModuleBase, const HLE::SourcecodeMap* Map) {
+  if (JitDumpFD == -1) {
+    return;
+  }
+
+  // Without source lines, the guest offset into the module stands in for the line number, or the guest RIP for anonymous code.
+  const std::string_view SourceFile = Map ? std::string_view {Map->SourceFile} : !ModuleName.empty() ? ModuleName : "[anonymous]";
+  fextl::vector<JitDumpDebugEntry> Entries;
+  Entries.reserve(DebugData.GuestOpcodes.size());
+  for (const auto& GuestOpcode : DebugData.GuestOpcodes) {
+    const uint64_t InstRIP = GuestRIP + GuestOpcode.GuestEntryOffset;
+    uint64_t LineNumber = ModuleName.empty() ? InstRIP : InstRIP - ModuleBase;
+    if (Map) {
+      auto Line = Map->FindLineMapping(InstRIP - ModuleBase);
+      if (!Line) {
+        continue;
+      }
+      LineNumber = Line->LineNumber;
+    }
+
+    if (LineNumber > std::numeric_limits<int32_t>::max()) {
+      continue;
+    }
+
+    Entries.push_back({
+      .Addr = reinterpret_cast<uint64_t>(HostAddr) + GuestOpcode.HostEntryOffset,
+      .LineNumber = static_cast<int32_t>(LineNumber),
+    });
+  }
+
+  const size_t DebugInfoSize = Entries.empty() ? 0 : sizeof(JitDumpDebugInfo) + Entries.size() * (sizeof(JitDumpDebugEntry) + SourceFile.size() + 1);
+  const size_t CodeLoadSize = sizeof(JitDumpCodeLoad) + Name.size() + 1 + CodeSize;
+  const size_t TotalSize = DebugInfoSize + CodeLoadSize;
+  const auto Timestamp = GetMonotonicNS();
+
+  // perf attaches a debug info record to the code load that directly follows it, so both are always written with a single write.
+  auto Serialize = [&](char* Out) {
+    if (DebugInfoSize) {
+      const JitDumpDebugInfo DebugInfo {
+        .Header = {JIT_CODE_DEBUG_INFO, static_cast<uint32_t>(DebugInfoSize), Timestamp},
+        .CodeAddr = reinterpret_cast<uint64_t>(HostAddr),
+        .NumEntries = Entries.size(),
+      };
+      memcpy(Out, &DebugInfo, sizeof(DebugInfo));
+      Out += sizeof(DebugInfo);
+
+      for (const auto& Entry : Entries) {
+        memcpy(Out, &Entry, sizeof(Entry));
+        Out += sizeof(Entry);
+        memcpy(Out, SourceFile.data(), SourceFile.size());
+        Out += SourceFile.size();
+        *Out++ = '\0';
+      }
+    }
+
+    const JitDumpCodeLoad CodeLoad {
+      .Header = {JIT_CODE_LOAD, static_cast<uint32_t>(CodeLoadSize), Timestamp},
+      .PID = static_cast<uint32_t>(getpid()),
+      .TID = static_cast<uint32_t>(FHU::Syscalls::gettid()),
+      .VMA = reinterpret_cast<uint64_t>(HostAddr),
+      .CodeAddr = reinterpret_cast<uint64_t>(HostAddr),
+      .CodeSize = CodeSize,
+      .CodeIndex = JitDumpCodeIndex.fetch_add(1, std::memory_order_relaxed),
+    };
+    memcpy(Out, &CodeLoad, sizeof(CodeLoad));
+    Out += sizeof(CodeLoad);
+    memcpy(Out, Name.data(), Name.size());
+    Out += Name.size();
+    *Out++ = '\0';
+    memcpy(Out, HostAddr, CodeSize);
+  };
+
+  if (TotalSize > Buffer->BUFFER_SIZE - Buffer->Offset) {
+    // Couldn't fit, need to force a write.
+    WriteBuffer(JitDumpFD, Buffer, true);
+  }
+
+  if (TotalSize > Buffer->BUFFER_SIZE) {
+    // Larger than the whole buffer, write it out directly.
+    fextl::vector<char> Records(TotalSize);
+    Serialize(Records.data());
+    auto Result = write(JitDumpFD, Records.data(), Records.size());
+    if (Result == -1 && errno == EBADF) {
+      JitDumpFD = -1;
+    }
+    return;
+  }
+
+  Serialize(&Buffer->Buffer[Buffer->Offset]);
+  Buffer->Offset += TotalSize;
+  WriteBuffer(JitDumpFD, Buffer);
+}
+
+void JITSymbols::Flush(FEXCore::JITSymbolBuffer* Buffer, FEXCore::JITSymbolBuffer* JitDumpBuffer) {
+  if (Buffer && Buffer->Offset && fd != -1) {
+    WriteBuffer(fd, Buffer, true);
+  }
+
+  if (JitDumpBuffer && JitDumpBuffer->Offset && JitDumpFD != -1) {
+    WriteBuffer(JitDumpFD, JitDumpBuffer, true);
+  }
+}
+
+void JITSymbols::ResetJitDumpAfterFork(FEXCore::JITSymbolBuffer* JitDumpBuffer) {
+  if (JitDumpFD == -1) {
+    return;
+  }
+
+  if (JitDumpBuffer) {
+    JitDumpBuffer->Offset = 0;
+  }
+
+  CloseJitDump();
+  InitJitDump();
+}
+
+void JITSymbols::WriteBuffer(int& FD, FEXCore::JITSymbolBuffer* Buffer, bool ForceWrite) {
   auto Now = std::chrono::steady_clock::now();
   if (!ForceWrite) {
-    if (((Buffer->LastWrite - Now) < Buffer->MAXIMUM_THRESHOLD) && Buffer->Offset < Buffer->NEEDS_WRITE_DISTANCE) {
+    if (((Now - Buffer->LastWrite) < Buffer->MAXIMUM_THRESHOLD) && Buffer->Offset < Buffer->NEEDS_WRITE_DISTANCE) {
       // Still buffering, no need to write.
       return;
     }
   }
 
   Buffer->LastWrite = Now;
-  auto Result = write(fd, Buffer->Buffer, Buffer->Offset);
+  auto Result = write(FD, Buffer->Buffer, Buffer->Offset);
   if (Result == -1 && errno == EBADF) {
-    fd = -1;
+    FD = -1;
   }
 
   Buffer->Offset = 0;
@@ -4,11 +4,20 @@
 
 #include <FEXCore/fextl/memory.h>
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
 
+namespace FEXCore::Core {
+struct DebugData;
+}
+
+namespace FEXCore::HLE {
+struct SourcecodeMap;
+}
+
 namespace FEXCore {
 // Buffered JIT symbol tracking.
 struct JITSymbolBuffer {
@@ -36,6 +45,8 @@ public:
   ~JITSymbols();
 
   void InitFile();
+  // Creates jit-<pid>.dump for `perf inject --jit`
+  void InitJitDump();
   void RegisterNamedRegion(const void* HostAddr, uint32_t CodeSize, std::string_view Name);
   void RegisterJITSpace(const void* HostAddr, uint32_t CodeSize);
 
@@ -48,8 +59,28 @@ public:
   void Register(FEXCore::JITSymbolBuffer* Buffer, const void* HostAddr, uint32_t CodeSize, std::string_view Name, uintptr_t Offset);
   void RegisterNamedRegion(FEXCore::JITSymbolBuffer* Buffer, const void* HostAddr, uint32_t CodeSize, std::string_view Name);
 
+  // Buffered jitdump records.
+  // Emits a JIT_CODE_DEBUG_INFO record mapping the block's host instructions to guest source lines if Map is provided,
+  // or to guest offsets in the module (guest RIPs for anonymous code) otherwise, followed by a JIT_CODE_LOAD record with the code bytes.
+  void RegisterJitDump(FEXCore::JITSymbolBuffer* Buffer, const void* HostAddr, uint32_t CodeSize, uint64_t GuestRIP, std::string_view Name,
+                       const FEXCore::Core::DebugData& DebugData, std::string_view ModuleName, uintptr_t ModuleBase, const HLE::SourcecodeMap* Map);
+
+  // Writes out anything left in the buffers of a thread.
+  void Flush(FEXCore::JITSymbolBuffer* Buffer, FEXCore::JITSymbolBuffer* JitDumpBuffer);
+
+  // The child starts its own jitdump file and drops records still buffered from the parent.
+  void ResetJitDumpAfterFork(FEXCore::JITSymbolBuffer* JitDumpBuffer);
+
 private:
   int fd {-1};
-  void WriteBuffer(FEXCore::JITSymbolBuffer* Buffer, bool ForceWrite = false);
+  int JitDumpFD {-1};
+  void* JitDumpMarker {};
+  std::atomic<uint64_t> JitDumpCodeIndex {};
+
+  void CloseJitDump();
+  void WriteBuffer(FEXCore::JITSymbolBuffer* Buffer, bool ForceWrite = false) {
+    WriteBuffer(fd, Buffer, ForceWrite);
+  }
+  static void WriteBuffer(int& FD, FEXCore::JITSymbolBuffer* Buffer, bool ForceWrite = false);
 };
 } // namespace FEXCore
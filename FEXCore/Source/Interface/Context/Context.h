@@ -4,6 +4,9 @@
 #include "Common/JitSymbols.h"
 #include "Interface/Core/CPUBackend.h"
 #include "Interface/Core/CPUID.h"
+#include "Interface/Core/JIT/Relocations.h"
+#include "Interface/Core/BlockStats.h"
+#include "Interface/Core/CompileTrace.h"
 #include "Interface/Core/SharedCodeBufferManager.h"
 #include <Interface/IR/IntrusiveIRList.h>
 #include <FEXCore/Config/Config.h>
@@ -84,7 +87,21 @@ public:
   FEX_CONFIG_OPT(EnableCodeCacheValidation, ENABLECODECACHEVALIDATION);
 
   uint64_t ComputeCodeMapId(std::string_view Filename, int FD) override;
-  bool SaveData(Core::InternalThreadState&, int TargetFD, const ExecutableFileSectionInfo&, uint64_t SerializedBaseAddress) override;
+  bool SaveData(std::span<Core::InternalThreadState* const> CompileThreads, int TargetFD, const ExecutableFileSectionInfo&,
+                uint64_t SerializedBaseAddress) override;
+
+  fextl::set<uint64_t> ImportBlocks(Core::InternalThreadState*, std::span<const std::byte> PreviousCache, const ExecutableFileSectionInfo&,
+                                    const fextl::set<uint64_t>& Blocks) override;
+
+  uint64_t GetConfigId() const override {
+    return ConfigId;
+  }
+
+  // Set up by InitCore, see ComputeConfigId
+  uint64_t ConfigId {};
+
+  // Relocations for code added by ImportBlocks, rebased to the current CodeBuffer. Consumed by SaveData.
+  fextl::vector<CPU::Relocation> ImportedRelocations;
 
   fextl::unique_ptr<MappedCodeCacheFile> LoadCache(std::span<std::byte> CacheFile, const ExecutableFileInfo&, uint64_t FileStartVA) override;
 
@@ -92,6 +109,10 @@ public:
 
   void FinalizeCodePages(MappedCodeCacheFile&, std::span<std::byte> CodeRange) override;
 
+  int CreateSharedCodeBuffer(MappedCodeCacheFile&) override;
+  std::optional<size_t> MapSharedCodeBuffer(MappedCodeCacheFile&, int FD) override;
+  std::optional<size_t> MapCodeBufferFromFile(MappedCodeCacheFile&, int FD) override;
+
   /**
    * Performs expensive extra validation on the loaded code cache data.
    *
@@ -103,7 +124,7 @@ public:
    * - incorrect instruction padding
    */
   void Validate(const ExecutableFileSectionInfo&, fextl::set<uint64_t> GuestBlocks, const fextl::set<uint64_t>& HostBlocks,
-                std::span<std::byte> CachedCode);
+                std::span<std::byte> CachedCode, uint32_t ModuleTableOffset);
 
   void InitiateCacheGeneration() override {
     IsGeneratingCache = true;
@@ -130,6 +151,29 @@ public:
   [[nodiscard]]
   bool ApplyCodeRelocations(uint64_t GuestDelta, std::span<std::byte> Code, std::span<const CPU::Relocation> Relocations,
                             uint32_t RelocationOffset, bool ForStorage);
+
+  /**
+   * Rewrites guest RIP relocations in serialized code to be computed relative to a module table.
+   *
+   * Guest RIP moves load the module base address from the table via adrp+ldr, guest RIP literals
+   * are tagged as described for DecodeGuestRIPLiteral. This leaves the table as the only data that
+   * depends on the guest base address.
+   *
+   * @param CodeOffset Offset of the given Code within the cache code buffer
+   * @param ModuleTableOffset Offset of the PICModuleTable within the cache code buffer
+   */
+  void MakePositionIndependent(std::span<std::byte> Code, std::span<const CPU::Relocation> Relocations, uint64_t CodeOffset,
+                               uint64_t ModuleTableOffset);
+
+  /**
+   * Maps code directly from the given file descriptor and applies the given kind of relocations in place.
+   *
+   * Only pages touched by relocations are copied, all others remain shared with the page cache and are mapped read-only
+   * until they're written to, see SharedPages.
+   *
+   * @return Number of privately copied pages, or std::nullopt on failure (leaving the code buffer unmapped)
+   */
+  std::optional<size_t> MapCodeBufferPrivately(MappedCodeCacheFile&, int FD, uint64_t FileOffset, bool OnlyHostRelocations);
 };
 
 class ContextImpl final : public FEXCore::Context::Context, public CPU::SharedCodeBufferManager {
@@ -219,6 +263,16 @@ public:
     }
   }
 
+  void WriteBlockStats(FEXCore::Core::InternalThreadState* Thread) override;
+
+  void FlushCompileTrace() override {
+    if (CompileTraceWriter) {
+      CompileTraceWriter->Flush();
+    }
+  }
+
+  void FlushJITSymbols(FEXCore::Core::InternalThreadState* Thread) override;
+
   void OnCodeBufferAllocated(const std::shared_ptr<CPU::CodeBuffer>&) override;
   void ClearCodeCache(FEXCore::Core::InternalThreadState* Thread, bool NewCodeBuffer = true) override;
   void InvalidateCodeBuffersCodeRange(uint64_t Start, uint64_t Length) override;
@@ -354,17 +408,23 @@ public:
     FEX_CONFIG_OPT(MemcpySetTSOEnabled, MEMCPYSETTSOENABLED);
     FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
     FEX_CONFIG_OPT(MaxInstPerBlock, MAXINST);
+    FEX_CONFIG_OPT(SpinWaitLoops, SPINWAITLOOPS);
+    FEX_CONFIG_OPT(SpinWaitFutex, SPINWAITFUTEX);
     FEX_CONFIG_OPT(RootFSPath, ROOTFS);
     FEX_CONFIG_OPT(GlobalJITNaming, GLOBALJITNAMING);
     FEX_CONFIG_OPT(LibraryJITNaming, LIBRARYJITNAMING);
     FEX_CONFIG_OPT(BlockJITNaming, BLOCKJITNAMING);
+    FEX_CONFIG_OPT(PerfJitDump, PERFJITDUMP);
     FEX_CONFIG_OPT(GDBSymbols, GDBSYMBOLS);
+    FEX_CONFIG_OPT(BlockStats, BLOCKSTATS);
+    FEX_CONFIG_OPT(CompileTrace, COMPILETRACE);
     FEX_CONFIG_OPT(x87ReducedPrecision, X87REDUCEDPRECISION);
     FEX_CONFIG_OPT(DisableTelemetry, DISABLETELEMETRY);
     FEX_CONFIG_OPT(DisableVixlIndirectCalls, DISABLE_VIXL_INDIRECT_RUNTIME_CALLS);
     FEX_CONFIG_OPT(SmallTSCScale, SMALLTSCSCALE);
     FEX_CONFIG_OPT(StrictInProcessSplitLocks, STRICTINPROCESSSPLITLOCKS);
     FEX_CONFIG_OPT(MonoHacks, MONOHACKS);
+    FEX_CONFIG_OPT(CodeCachePositionIndependent, CODECACHEPOSITIONINDEPENDENT);
   } Config;
 
   FEXCore::Utils::WritePriorityMutex::Mutex CodeInvalidationMutex {};
@@ -393,6 +453,11 @@ public:
   // even if faulting is disabled.
   static void MonoBackpatcherWrite(FEXCore::Core::CpuStateFrame* Frame, uint8_t Size, uint64_t Address, uint64_t Value);
 
+  // Called on the back-edge of a detected guest spin-wait loop. Waits for a while for the polled location to change from
+  // Observed, the value the loop compared, so a release since then returns right away. The wait grows exponentially while
+  // the same location keeps being polled.
+  static void SpinWait(FEXCore::Core::CpuStateFrame* Frame, uint8_t Size, uint64_t Address, uint64_t Observed);
+
   void RemoveCustomIREntrypoint(FEXCore::Core::InternalThreadState* Thread, uintptr_t Entrypoint);
 
   struct GenerateIRResult {
@@ -404,7 +469,8 @@ public:
     bool NeedsAddGuestCodeRanges;
   };
   [[nodiscard]]
-  GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint64_t MaxInst);
+  GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint64_t MaxInst,
+                              CompileTrace::BlockRecord* Trace = nullptr);
 
   struct CompileCodeResult {
     CPU::CPUBackend::CompiledCode CompiledCode;
@@ -413,8 +479,10 @@ public:
     uint64_t Length;
     bool NeedsAddGuestCodeRanges;
   };
+  // Section is the result of LookupExecutableFileSection for GuestRIP if the caller already has it, otherwise it's looked up as needed
   [[nodiscard]]
-  CompileCodeResult CompileCode(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, uint64_t MaxInst = 0);
+  CompileCodeResult CompileCode(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, uint64_t MaxInst = 0,
+                                CompileTrace::BlockRecord* Trace = nullptr, const std::optional<ExecutableFileSectionInfo>* Section = nullptr);
   uintptr_t CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_t GuestRIP, uint64_t MaxInst = 0);
   uintptr_t CompileSingleStep(FEXCore::Core::CpuStateFrame* Frame, uint64_t GuestRIP);
 
@@ -504,6 +572,9 @@ private:
   bool MonoDetected = false;
   std::atomic<uint64_t> MonoBackpatcherBlock;
 
+  CPU::BlockStatsCollector BlockStats;
+  fextl::unique_ptr<CPU::CompileTraceWriter> CompileTraceWriter;
+
   std::mutex CodeBufferListLock;
   fextl::vector<std::weak_ptr<CPU::CodeBuffer>> CodeBufferList;
 };
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: backend|shared
+desc: Per-block execution counts and JIT expansion statistics
+$end_info$
+*/
+
+#include "Interface/Core/BlockStats.h"
+#include "Interface/Core/JIT/DebugData.h"
+#include "Interface/Core/SharedCodeBufferManager.h"
+
+#include <FEXCore/Core/CodeCache.h>
+#include <FEXCore/HLE/SyscallHandler.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+
+namespace FEXCore::CPU {
+void BlockStatsCollector::AddBlock(uint64_t GuestRIP, uint64_t GuestSize, const uint8_t* BlockBegin, const Core::DebugData& DebugData) {
+  if (!DebugData.ExecutionCounterOffset) {
+    return;
+  }
+
+  std::scoped_lock lk {Mutex};
+  if (!CurrentBuffer || BlockBegin < CurrentBuffer->GetBufferBase() || BlockBegin >= CurrentBuffer->GetBufferBase() + CurrentBuffer->UsableSize()) {
+    // Compiled to a CodeBuffer that was retired in the meantime, which only happens if we raced with a cache clear
+    return;
+  }
+
+  LiveBlocks.push_back({
+    .GuestRIP = GuestRIP,
+    .ExecutionCounter = reinterpret_cast<uint64_t*>(const_cast<uint8_t*>(BlockBegin) + DebugData.ExecutionCounterOffset),
+    .Info =
+      {
+        .Executions = 0,
+        .GuestSize = static_cast<uint32_t>(GuestSize),
+        .GuestInstructions = DebugData.GuestInstructions,
+        .HostInstructions = DebugData.HostInstructions,
+        .FallbackCalls = DebugData.FallbackCalls,
+      },
+  });
+}
+
+void BlockStatsCollector::OnCodeBufferAllocated(const fextl::shared_ptr<CodeBuffer>& Buffer) {
+  std::scoped_lock lk {Mutex};
+
+  // Executions that happen in the old CodeBuffer after this point aren't counted
+  FoldLiveBlocks(RetiredBlocks);
+  LiveBlocks.clear();
+  CurrentBuffer = Buffer;
+}
+
+void BlockStatsCollector::FoldLiveBlocks(fextl::robin_map<uint64_t, BlockInfo>& Into) const {
+  for (const auto& Block : LiveBlocks) {
+    const auto Executions = std::atomic_ref(*Block.ExecutionCounter).load(std::memory_order_relaxed);
+    if (!Executions) {
+      continue;
+    }
+
+    // Recompiled blocks keep the code statistics of their most recent compilation
+    auto& Info = Into[Block.GuestRIP];
+    const auto PreviousExecutions = Info.Executions;
+    Info = Block.Info;
+    Info.Executions = PreviousExecutions + Executions;
+  }
+}
+
+void BlockStatsCollector::Dump(FEXCore::HLE::SyscallHandler* Handler, FEXCore::Core::InternalThreadState* Thread, uint32_t NumBlocks) {
+  fextl::robin_map<uint64_t, BlockInfo> Blocks;
+  {
+    std::scoped_lock lk {Mutex};
+    Blocks = RetiredBlocks;
+    FoldLiveBlocks(Blocks);
+  }
+
+  // Host instructions are used as a cheap estimate of the time spent in a block
+  const auto EstimatedCost = [](const BlockInfo& Info) {
+    return Info.Executions * Info.HostInstructions;
+  };
+
+  fextl::vector<std::pair<uint64_t, BlockInfo>> Sorted(Blocks.begin(), Blocks.end());
+  uint64_t TotalExecutions = 0;
+  uint64_t TotalCost = 0;
+  for (const auto& [RIP, Info] : Sorted) {
+    TotalExecutions += Info.Executions;
+    TotalCost += EstimatedCost(Info);
+  }
+
+  const size_t NumShown = std::min<size_t>(NumBlocks, Sorted.size());
+  std::partial_sort(Sorted.begin(), Sorted.begin() + NumShown, Sorted.end(),
+                    [&](const auto& LHS, const auto& RHS) { return EstimatedCost(LHS.second) > EstimatedCost(RHS.second); });
+
+  LogMan::Msg::IFmt("Block statistics: {} blocks executed {} times, top {} by estimated host instructions executed", Sorted.size(),
+                    TotalExecutions, NumShown);
+  LogMan::Msg::IFmt("{:>7} {:>14} {:>6} {:>6} {:>7} {:>9}  {}", "Est%", "Executions", "Guest", "Host", "Ratio", "Fallbacks", "Block");
+
+  for (size_t i = 0; i < NumShown; ++i) {
+    const auto& [RIP, Info] = Sorted[i];
+
+    fextl::string Name;
+    if (auto Section = Handler ? Handler->LookupExecutableFileSection(Thread, RIP) : std::nullopt) {
+      std::string_view Filename = Section->FileInfo.Filename;
+      Filename = Filename.substr(Filename.find_last_of('/') + 1);
+      Name = fextl::fmt::format("{:#x} ({}+{:#x})", RIP, Filename, RIP - Section->FileStartVA);
+    } else {
+      Name = fextl::fmt::format("{:#x}", RIP);
+    }
+
+    const double Percent = TotalCost ? 100.0 * EstimatedCost(Info) / TotalCost : 0.0;
+    const double Ratio = Info.GuestInstructions ? double(Info.HostInstructions) / Info.GuestInstructions : 0.0;
+    LogMan::Msg::IFmt("{:>6.2f}% {:>14} {:>6} {:>6} {:>6.2f}x {:>9}  {}", Percent, Info.Executions, Info.GuestInstructions,
+                      Info.HostInstructions, Ratio, Info.FallbackCalls, Name);
+  }
+}
+
+void BlockStatsCollector::UnlockAfterFork(bool Child) {
+  if (Child) {
+    RetiredBlocks.clear();
+    for (auto& Block : LiveBlocks) {
+      std::atomic_ref(*Block.ExecutionCounter).store(0, std::memory_order_relaxed);
+    }
+  }
+  Mutex.unlock();
+}
+} // namespace FEXCore::CPU
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: backend|shared
+desc: Per-block execution counts and JIT expansion statistics
+$end_info$
+*/
+#pragma once
+
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstdint>
+#include <mutex>
+
+namespace FEXCore::Core {
+struct DebugData;
+struct InternalThreadState;
+} // namespace FEXCore::Core
+
+namespace FEXCore::HLE {
+class SyscallHandler;
+}
+
+namespace FEXCore::CPU {
+struct CodeBuffer;
+
+/**
+ * Tracks the execution counters the JIT emits into every block when BlockStats is enabled.
+ *
+ * Counters live in CodeBuffer memory, so they are folded into per-RIP totals before a CodeBuffer is released.
+ * Only blocks compiled by the JIT are tracked; blocks loaded from code caches don't carry counters.
+ */
+class BlockStatsCollector final {
+public:
+  // Registers a block that was just compiled. BlockBegin is the start of the block's JITCodeHeader.
+  void AddBlock(uint64_t GuestRIP, uint64_t GuestSize, const uint8_t* BlockBegin, const Core::DebugData& DebugData);
+
+  // Called when a new CodeBuffer becomes the one all threads compile to
+  void OnCodeBufferAllocated(const fextl::shared_ptr<CodeBuffer>& Buffer);
+
+  // Logs the top NumBlocks blocks ordered by their estimated number of executed host instructions
+  void Dump(FEXCore::HLE::SyscallHandler* Handler, FEXCore::Core::InternalThreadState* Thread, uint32_t NumBlocks);
+
+  void LockBeforeFork() {
+    Mutex.lock();
+  }
+  // The child drops statistics inherited from the parent process
+  void UnlockAfterFork(bool Child);
+
+private:
+  struct BlockInfo {
+    uint64_t Executions;
+    uint32_t GuestSize;
+    uint32_t GuestInstructions;
+    uint32_t HostInstructions;
+    uint32_t FallbackCalls;
+  };
+
+  struct LiveBlock {
+    uint64_t GuestRIP;
+    uint64_t* ExecutionCounter;
+    BlockInfo Info;
+  };
+
+  void FoldLiveBlocks(fextl::robin_map<uint64_t, BlockInfo>& Into) const;
+
+  std::mutex Mutex;
+
+  // Held until the next CodeBuffer is allocated, so that counters can be read before the buffer is freed
+  fextl::shared_ptr<CodeBuffer> CurrentBuffer;
+  fextl::vector<LiveBlock> LiveBlocks;
+
+  // Totals of blocks whose CodeBuffer has been retired, keyed by guest RIP
+  fextl::robin_map<uint64_t, BlockInfo> RetiredBlocks;
+};
+} // namespace FEXCore::CPU
@@ -26,7 +26,31 @@ struct BlobEntryPoint;
 
 namespace FEXCore::CPU {
 union Relocation;
+
+/**
+ * Guest RIP literals in the JIT data of position-independent code caches (block tails, link records)
+ * are encoded relative to the module table of the cache, see CodeCache::MakePositionIndependent.
+ *
+ * Bit 63 marks encoded values, bits [32, 63) hold the distance from the literal to the module table
+ * in 8-byte units, and bits [0, 32) hold the guest RIP relative to the module base address.
+ */
+constexpr uint64_t PIC_GUEST_RIP_TAG = 1ULL << 63;
+
+struct PICModuleTable {
+  // Guest base address of the module, written when the cache is loaded
+  uint64_t GuestBase;
+  uint64_t Pad;
+};
+
+inline uint64_t DecodeGuestRIPLiteral(uintptr_t Location, uint64_t Value) {
+  if (!(Value & PIC_GUEST_RIP_TAG)) [[likely]] {
+    return Value;
+  }
+
+  auto Table = reinterpret_cast<const PICModuleTable*>(Location + ((Value & ~PIC_GUEST_RIP_TAG) >> 32) * 8);
+  return Table->GuestBase + (Value & 0xFFFF'FFFF);
 }
+} // namespace FEXCore::CPU
 
 namespace FEXCore {
 
@@ -100,6 +124,10 @@ namespace CPU {
       bool SingleInst;
 
       uint8_t _Pad[3];
+
+      uint64_t GetRIP() const {
+        return DecodeGuestRIPLiteral(reinterpret_cast<uintptr_t>(&RIP), RIP);
+      }
     };
 
     /**
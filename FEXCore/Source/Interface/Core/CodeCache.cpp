@@ -3,7 +3,12 @@
 #include "FEXCore/Utils/MathUtils.h"
 #include "FEXCore/Utils/TypeDefines.h"
 #include "FEXCore/fextl/memory.h"
+#include "FEXCore/fextl/unordered_map.h"
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/HostFeatures.h>
+#include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/SHMStats.h>
 #include <FEXCore/Utils/SpinWaitLock.h>
 
 #include <Interface/Context/Context.h>
@@ -22,11 +27,21 @@
 #include <FEXHeaderUtils/Filesystem.h>
 
 #include <algorithm>
+#include <functional>
 #include <git_version.h>
+#include <iterator>
+#include <numeric>
 
 #include <span>
+#include <type_traits>
 #include <xxhash.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include <FEXCore/Utils/AllocatorHooks.h>
 
 #include <fstream>
@@ -61,10 +76,59 @@ void AbstractCodeCache::RegisterMappedCodeBuffer(MappedCodeCacheFile& Code) {
   MappedCodeBuffers.push_back(Code.CodeBuffer);
   // Unregister on destruction of Code
   Code.CacheManager = this;
+
+  if (!Code.SharedPages.empty()) {
+    auto lk = MaskSignalsAndLockMutex<std::unique_lock>(SharedCodeBuffersMutex);
+    SharedCodeBuffers.push_back(&Code);
+  }
 }
 
 void AbstractCodeCache::UnregisterMappedCodeBuffer(MappedCodeCacheFile& Code) {
   std::erase_if(MappedCodeBuffers, [&](const auto& Elem) { return Elem.data() == Code.CodeBuffer.data(); });
+
+  if (!Code.SharedPages.empty()) {
+    auto lk = MaskSignalsAndLockMutex<std::unique_lock>(SharedCodeBuffersMutex);
+    std::erase(SharedCodeBuffers, &Code);
+  }
+}
+
+bool AbstractCodeCache::HandleSharedCodePageWriteFault(Core::InternalThreadState* Thread, uintptr_t Address) {
+#ifndef _WIN32
+  auto lk = MaskSignalsAndLockMutex<std::unique_lock>(SharedCodeBuffersMutex);
+  for (auto* Code : SharedCodeBuffers) {
+    auto Start = reinterpret_cast<uintptr_t>(Code->CodeBuffer.data());
+    if (Address < Start || Address >= Start + Code->CodeBuffer.size_bytes()) {
+      continue;
+    }
+
+    const size_t PageIdx = (Address - Start) / Utils::FEX_PAGE_SIZE;
+    if (!Code->SharedPages[PageIdx]) {
+      // Another thread made the page writable since the fault, so just retry the write
+      return true;
+    }
+
+    auto Page = Code->CodeBuffer.data() + PageIdx * Utils::FEX_PAGE_SIZE;
+    if (::mprotect(Page, Utils::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+      ERROR_AND_DIE_FMT("{}: mprotect failed: {}", __FUNCTION__, errno);
+    }
+    Code->SharedPages[PageIdx] = false;
+    FEXCORE_PROFILE_INSTANT_INCREMENT(Thread, AccumulatedCodeCacheUnsharedBytes, Utils::FEX_PAGE_SIZE);
+    return true;
+  }
+#endif
+  return false;
+}
+
+void AbstractCodeCache::LockBeforeFork() {
+  SharedCodeBuffersMutex.lock();
+}
+
+void AbstractCodeCache::UnlockAfterFork(bool Child) {
+  if (Child) {
+    SharedCodeBuffersMutex.StealAndDropActiveLocks();
+  } else {
+    SharedCodeBuffersMutex.unlock();
+  }
 }
 
 bool AbstractCodeCache::IsAddressInMappedCodeBuffer(uintptr_t Address) const {
@@ -287,14 +351,21 @@ struct CodeCacheHeader {
   // Version history:
   // 1: Initial version
   // 2: Padding code buffer data to enable direct mapping
-  uint32_t FormatVersion = 2;
+  // 3: Per-block guest code hashes and configuration id for incremental regeneration
+  // 4: Position-independent code caches
+  uint32_t FormatVersion = 4;
   uint8_t FEXVersion[20] = {};
   uint32_t NumBlocks;
   uint32_t NumCodePages;
   uint32_t CodeBufferSize;
   uint32_t NumRelocations;
-  uint32_t padding;
+  // Relocations resolved by MakePositionIndependent, stored after the regular ones. Only used for cache regeneration.
+  uint32_t NumPositionIndependentRelocations;
   uint64_t SerializedBaseAddress;
+  uint64_t ConfigId;
+  // Offset of the PICModuleTable in the code buffer, or 0 if the cache isn't position-independent
+  uint32_t ModuleTableOffset;
+  uint32_t padding;
   // TODO: Consider including information from LookupCache.BlockLinks
 
   static constexpr std::array<char, 4> ExpectedMagic = {'F', 'X', 'C', 'C'};
@@ -303,10 +374,115 @@ struct CodeCacheHeader {
 template<typename T>
 concept OrderedContainer = requires { typename T::key_compare; };
 
-bool CodeCache::SaveData(Core::InternalThreadState& Thread, int fd, const ExecutableFileSectionInfo& SourceBinary, uint64_t SerializedBaseAddress) {
+/**
+ * Hashes the contents of the given guest code pages.
+ *
+ * Data patched by ELF/PE relocations is normalized to be relative to FileStartVA first,
+ * so that hashes don't depend on where the binary was mapped.
+ */
+static fextl::unordered_map<uint64_t, uint64_t> HashGuestCodePages(const ExecutableFileSectionInfo& Section, const fextl::set<uint64_t>& CodePages) {
+  const fextl::vector<uint64_t> Pages(CodePages.begin(), CodePages.end());
+  fextl::vector<std::byte> Data(Pages.size() * Utils::FEX_PAGE_SIZE);
+  for (size_t i = 0; i < Pages.size(); ++i) {
+    memcpy(&Data[i * Utils::FEX_PAGE_SIZE], reinterpret_cast<const void*>(Pages[i]), Utils::FEX_PAGE_SIZE);
+  }
+
+  auto FindPage = [&](uint64_t Address) -> std::byte* {
+    auto It = std::ranges::lower_bound(Pages, Address & Utils::FEX_PAGE_MASK);
+    if (It == Pages.end() || *It != (Address & Utils::FEX_PAGE_MASK)) {
+      return nullptr;
+    }
+    return &Data[(It - Pages.begin()) * Utils::FEX_PAGE_SIZE + (Address & ~Utils::FEX_PAGE_MASK)];
+  };
+
+  for (auto& [Offset, Type] : Section.FileInfo.Relocations) {
+    const uint64_t Address = Section.FileStartVA + Offset;
+    const size_t Size = Type == GuestRelocationType::Rel32 ? 4 : Type == GuestRelocationType::Rel64 ? 8 : 0;
+    if (Size == 0) {
+      continue;
+    }
+
+    auto* Begin = FindPage(Address);
+    auto* End = FindPage(Address + Size - 1);
+    if (Begin && End == Begin + Size - 1) {
+      uint64_t Value {};
+      memcpy(&Value, Begin, Size);
+      Value -= Section.FileStartVA;
+      memcpy(Begin, &Value, Size);
+    } else {
+      // Page-crossing slot, just mask out the parts that we have copies of
+      for (size_t i = 0; i < Size; ++i) {
+        if (auto* Byte = FindPage(Address + i)) {
+          *Byte = std::byte {};
+        }
+      }
+    }
+  }
+
+  fextl::unordered_map<uint64_t, uint64_t> Hashes;
+  for (size_t i = 0; i < Pages.size(); ++i) {
+    Hashes[Pages[i]] = XXH3_64bits(&Data[i * Utils::FEX_PAGE_SIZE], Utils::FEX_PAGE_SIZE);
+  }
+  return Hashes;
+}
+
+/**
+ * Checks if MakePositionIndependent can resolve the given (module-relative) relocation.
+ *
+ * Guest RIP moves are limited to 24-bit offsets by the two ADD immediates used to materialize them,
+ * guest RIP literals to the 32 bits reserved in their encoding.
+ */
+static bool IsPositionIndependentRelocation(const CPU::Relocation& Reloc) {
+  switch (Reloc.Header.Type) {
+  case CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE: return Reloc.GuestRIP.GuestRIP < (1ULL << 24);
+  case CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL: return Reloc.GuestRIP.GuestRIP < (1ULL << 32);
+  default: return false;
+  }
+}
+
+static uint64_t HashBlockGuestCode(const fextl::unordered_map<uint64_t, uint64_t>& PageHashes, std::span<const uint64_t> CodePages) {
+  uint64_t Hash = 0;
+  for (auto CodePage : CodePages) {
+    const auto PageHash = PageHashes.at(CodePage);
+    Hash = XXH3_64bits_withSeed(&PageHash, sizeof(PageHash), Hash);
+  }
+  return Hash;
+}
+
+bool CodeCache::SaveData(std::span<Core::InternalThreadState* const> CompileThreads, int fd, const ExecutableFileSectionInfo& SourceBinary,
+                         uint64_t SerializedBaseAddress) {
+  LOGMAN_THROW_A_FMT(!CompileThreads.empty(), "Need at least one compile thread to save a cache");
   auto CodeBuffer = CTX.GetLatest();
-  auto& LookupCache = *Thread.LookupCache->Shared;
-  auto Relocations = Thread.CPUBackend->TakeRelocations(SourceBinary.FileStartVA);
+  auto& LookupCache = *CompileThreads.front()->LookupCache->Shared;
+
+  // All compile threads share the CodeBuffer, so their relocation offsets are in the same space.
+  // Loading groups relocations by page and requires them to be sorted by offset.
+  auto Relocations = CompileThreads.front()->CPUBackend->TakeRelocations(SourceBinary.FileStartVA);
+  if (CompileThreads.size() > 1 || !ImportedRelocations.empty()) {
+    for (auto* Thread : CompileThreads.subspan(1)) {
+      auto ThreadRelocations = Thread->CPUBackend->TakeRelocations(SourceBinary.FileStartVA);
+      Relocations.insert(Relocations.end(), ThreadRelocations.begin(), ThreadRelocations.end());
+    }
+    Relocations.insert(Relocations.end(), ImportedRelocations.begin(), ImportedRelocations.end());
+    ImportedRelocations.clear();
+    std::ranges::stable_sort(Relocations, std::less {}, [](const CPU::Relocation& Reloc) -> uint64_t { return Reloc.Header.Offset; });
+  }
+
+  // In position-independent mode, guest addresses are computed relative to a module table placed after the code.
+  // Its guest base address is the only data left to relocate at load time for the code that could be transformed.
+  uint32_t ModuleTableOffset = 0;
+  fextl::vector<CPU::Relocation> PICRelocations;
+  CPU::Relocation ModuleTableRelocation {};
+  if (CTX.Config.CodeCachePositionIndependent) {
+    ModuleTableOffset = FEXCore::AlignUp(CodeBuffer->GetAllocatedSize(), alignof(CPU::PICModuleTable));
+    auto PICRange = std::ranges::stable_partition(Relocations, std::not_fn(IsPositionIndependentRelocation));
+    PICRelocations.assign(PICRange.begin(), PICRange.end());
+    Relocations.erase(PICRange.begin(), PICRange.end());
+
+    ModuleTableRelocation.GuestRIP.Header = {.Offset = ModuleTableOffset + offsetof(CPU::PICModuleTable, GuestBase),
+                                             .Type = CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL};
+    ModuleTableRelocation.GuestRIP.GuestRIP = 0;
+  }
 
   // Write file header
   CodeCacheHeader header {};
@@ -314,9 +490,13 @@ bool CodeCache::SaveData(Core::InternalThreadState& Thread, int fd, const Execut
   std::ranges::copy(GIT_HASH, header.FEXVersion);
   header.NumBlocks = LookupCache.BlockList.size();
   header.NumCodePages = LookupCache.CodePages.size();
-  header.CodeBufferSize = FEXCore::AlignUp(CodeBuffer->GetAllocatedSize(), Utils::FEX_PAGE_SIZE);
-  header.NumRelocations = Relocations.size();
+  header.CodeBufferSize = FEXCore::AlignUp(ModuleTableOffset ? ModuleTableOffset + sizeof(CPU::PICModuleTable) : CodeBuffer->GetAllocatedSize(),
+                                           Utils::FEX_PAGE_SIZE);
+  header.NumRelocations = Relocations.size() + (ModuleTableOffset ? 1 : 0);
+  header.NumPositionIndependentRelocations = PICRelocations.size();
   header.SerializedBaseAddress = SerializedBaseAddress;
+  header.ConfigId = ConfigId;
+  header.ModuleTableOffset = ModuleTableOffset;
   ::write(fd, &header, sizeof(header));
 
   // Dump guest<->host block mappings
@@ -331,12 +511,20 @@ bool CodeCache::SaveData(Core::InternalThreadState& Thread, int fd, const Execut
     }
     std::ranges::sort(BlockList);
 
+    fextl::set<uint64_t> GuestCodePages;
+    for (auto [Guest, Host] : BlockList) {
+      GuestCodePages.insert(Host->CodePages.begin(), Host->CodePages.end());
+    }
+    const auto PageHashes = HashGuestCodePages(SourceBinary, GuestCodePages);
+
     for (auto [Guest, Host] : BlockList) {
       static_assert(sizeof(Host->HostCode) == 8, "Breaking change in code cache data layout");
       static_assert(sizeof(Host->CodePages[0]) == 8, "Breaking change in code cache data layout");
 
+      uint64_t GuestHash = HashBlockGuestCode(PageHashes, Host->CodePages);
       Guest -= SourceBinary.FileStartVA;
       ::write(fd, &Guest, sizeof(Guest));
+      ::write(fd, &GuestHash, sizeof(GuestHash));
       uint64_t HostCode = Host->HostCode - reinterpret_cast<uintptr_t>(CodeBuffer->GetBufferBase());
       ::write(fd, &HostCode, sizeof(HostCode));
       uint64_t NumCodePages = Host->CodePages.size();
@@ -352,6 +540,10 @@ bool CodeCache::SaveData(Core::InternalThreadState& Thread, int fd, const Execut
   // Dump relocations
   static_assert(sizeof(Relocations[0]) == 48, "Breaking change in code cache data layout");
   ::write(fd, Relocations.data(), Relocations.size() * sizeof(Relocations[0]));
+  if (ModuleTableOffset) {
+    ::write(fd, &ModuleTableRelocation, sizeof(ModuleTableRelocation));
+    ::write(fd, PICRelocations.data(), PICRelocations.size() * sizeof(PICRelocations[0]));
+  }
 
   // Pad to next page in file so that the CodeBuffer can be mmap'ed into process on load
   {
@@ -363,11 +555,19 @@ bool CodeCache::SaveData(Core::InternalThreadState& Thread, int fd, const Execut
   // Dump the host code (relocated for position-independent serialization)
   std::span CodeBufferData(reinterpret_cast<std::byte*>(CodeBuffer->GetBufferBase()),
                            reinterpret_cast<std::byte*>(CodeBuffer->GetBufferBase()) + CodeBuffer->GetAllocatedSize());
-  if (!ApplyCodeRelocations(SerializedBaseAddress, CodeBufferData, Relocations, 0, true)) {
+  if (!ApplyCodeRelocations(SerializedBaseAddress, CodeBufferData, Relocations, 0, true) ||
+      !ApplyCodeRelocations(SerializedBaseAddress, CodeBufferData, PICRelocations, 0, true)) {
     LOGMAN_THROW_A_FMT(false, "Failed to apply code relocations");
     return false;
   }
+  MakePositionIndependent(CodeBufferData, PICRelocations, 0, ModuleTableOffset);
   ::write(fd, CodeBufferData.data(), CodeBufferData.size());
+  if (ModuleTableOffset) {
+    // Module table in the same form ApplyCodeRelocations produces for storage
+    const CPU::PICModuleTable Table {.GuestBase = SerializedBaseAddress};
+    lseek(fd, ModuleTableOffset - CodeBufferData.size(), SEEK_CUR);
+    ::write(fd, &Table, sizeof(Table));
+  }
   // Pad to next page in file for mmap
   {
     auto PaddedSize = AlignUp(lseek(fd, 0, SEEK_CUR), Utils::FEX_PAGE_SIZE);
@@ -391,11 +591,128 @@ bool CodeCache::SaveData(Core::InternalThreadState& Thread, int fd, const Execut
   return true;
 }
 
+fextl::set<uint64_t> CodeCache::ImportBlocks(Core::InternalThreadState* Thread, std::span<const std::byte> PreviousCache,
+                                             const ExecutableFileSectionInfo& Section, const fextl::set<uint64_t>& Blocks) {
+  FEXCORE_PROFILE_SCOPED("ImportBlocks");
+
+  if (!IsCompatibleCacheFile(PreviousCache, ConfigId)) {
+    LogMan::Msg::IFmt("Previous cache was generated from a different FEX version or configuration; not reusing any blocks");
+    return {};
+  }
+
+  CodeCacheHeader header {};
+  ::memcpy(&header, PreviousCache.data(), sizeof(header));
+
+  // Read block list, checking bounds since the previous cache may be truncated
+  struct PreviousBlock {
+    uint64_t Guest;
+    uint64_t GuestHash;
+    uint64_t HostCode;
+    fextl::vector<uint64_t> CodePages;
+  };
+  fextl::vector<PreviousBlock> PreviousBlocks(header.NumBlocks);
+  size_t Offset = sizeof(header);
+  auto Read = [&](void* Dest, size_t Size) {
+    if (Offset + Size > PreviousCache.size_bytes()) {
+      return false;
+    }
+    ::memcpy(Dest, PreviousCache.data() + Offset, Size);
+    Offset += Size;
+    return true;
+  };
+  for (auto& Block : PreviousBlocks) {
+    uint64_t NumCodePages;
+    if (!Read(&Block.Guest, sizeof(Block.Guest)) || !Read(&Block.GuestHash, sizeof(Block.GuestHash)) ||
+        !Read(&Block.HostCode, sizeof(Block.HostCode)) || !Read(&NumCodePages, sizeof(NumCodePages)) ||
+        NumCodePages > (PreviousCache.size_bytes() - Offset) / sizeof(uint64_t)) {
+      LogMan::Msg::EFmt("Previous cache is truncated");
+      return {};
+    }
+    Block.CodePages.resize(NumCodePages);
+    (void)Read(Block.CodePages.data(), std::span {Block.CodePages}.size_bytes());
+    for (auto& CodePage : Block.CodePages) {
+      CodePage += Section.FileStartVA;
+    }
+  }
+
+  // Relocations resolved by MakePositionIndependent are restored by SaveData, so import them along with the regular ones
+  fextl::vector<CPU::Relocation> Relocations(header.NumRelocations + header.NumPositionIndependentRelocations);
+  if (!Read(Relocations.data(), std::span {Relocations}.size_bytes())) {
+    LogMan::Msg::EFmt("Previous cache is truncated");
+    return {};
+  }
+  if (header.ModuleTableOffset) {
+    // The previous module table is kept as dead data, SaveData creates a new one
+    std::erase_if(Relocations, [&](const CPU::Relocation& Reloc) { return Reloc.Header.Offset == header.ModuleTableOffset; });
+  }
+  Offset = AlignUp(Offset, Utils::FEX_PAGE_SIZE);
+  if (Offset + header.CodeBufferSize > PreviousCache.size_bytes()) {
+    LogMan::Msg::EFmt("Previous cache is truncated");
+    return {};
+  }
+  auto CodeData = PreviousCache.subspan(Offset, header.CodeBufferSize);
+
+  // Check which of the requested blocks still match the guest code they were compiled from
+  fextl::set<uint64_t> GuestCodePages;
+  for (auto& Block : PreviousBlocks) {
+    if (Blocks.contains(Block.Guest)) {
+      GuestCodePages.insert(Block.CodePages.begin(), Block.CodePages.end());
+    }
+  }
+  const auto PageHashes = HashGuestCodePages(Section, GuestCodePages);
+  std::erase_if(PreviousBlocks, [&](const PreviousBlock& Block) {
+    return !Blocks.contains(Block.Guest) || Block.GuestHash != HashBlockGuestCode(PageHashes, Block.CodePages);
+  });
+
+  // The previous code buffer is imported as a whole, so code of stale blocks is kept around as dead data.
+  // Rebuild from scratch instead if that would waste too much space.
+  if (PreviousBlocks.size() * 2 < header.NumBlocks) {
+    LogMan::Msg::IFmt("Only {} of {} previously cached blocks are still valid; not reusing any blocks", PreviousBlocks.size(), header.NumBlocks);
+    return {};
+  }
+
+  auto LoadedCode = Thread->CPUBackend->LoadCachedCode(std::span {reinterpret_cast<const uint8_t*>(CodeData.data()), CodeData.size_bytes()}, {});
+  if (!LoadedCode.BlockBegin) {
+    return {};
+  }
+
+  // Relocations of the previous cache are already relative to FileStartVA, so only the host offset needs rebasing
+  for (auto& Reloc : Relocations) {
+    Reloc.Header.Offset += LoadedCode.HostCodeOffset;
+  }
+  ImportedRelocations.insert(ImportedRelocations.end(), Relocations.begin(), Relocations.end());
+
+  // Register imported blocks to the LookupCache so that they are skipped during compilation and serialized by SaveData
+  fextl::set<uint64_t> ImportedBlocks;
+  {
+    auto& LookupCache = *CTX.GetLatest()->LookupCache;
+    auto WriteLock = LookupCache.AcquireWriteLock();
+
+    fextl::map<uint64_t, fextl::vector<uint64_t>> PageEntrypoints;
+    for (auto& Block : PreviousBlocks) {
+      for (auto CodePage : Block.CodePages) {
+        PageEntrypoints[CodePage].push_back(Block.Guest + Section.FileStartVA);
+      }
+      LookupCache.AddBlockMapping(Block.Guest + Section.FileStartVA, std::move(Block.CodePages), LoadedCode.BlockBegin + Block.HostCode, WriteLock);
+      ImportedBlocks.insert(Block.Guest);
+    }
+
+    for (auto& [CodePage, Entrypoints] : PageEntrypoints) {
+      if (LookupCache.AddBlockExecutableRange(Entrypoints, CodePage, FEXCore::Utils::FEX_PAGE_SIZE, WriteLock)) {
+        CTX.SyscallHandler->MarkGuestExecutableRange(Thread, CodePage, FEXCore::Utils::FEX_PAGE_SIZE);
+      }
+    }
+  }
+
+  return ImportedBlocks;
+}
+
 void CodeCache::Validate(const ExecutableFileSectionInfo& Section, fextl::set<uint64_t> GuestBlocks, const fextl::set<uint64_t>& HostBlocks,
-                         std::span<std::byte> CachedCode) {
+                         std::span<std::byte> CachedCode, uint32_t ModuleTableOffset) {
   LOGMAN_THROW_A_FMT(!HostBlocks.empty(), "Tried to validate without any host blocks");
   // Skip any cached data before the first host block
-  CachedCode = CachedCode.subspan(*HostBlocks.begin() - sizeof(CPU::CPUBackend::JITCodeHeader));
+  const size_t CachedCodeOffset = *HostBlocks.begin() - sizeof(CPU::CPUBackend::JITCodeHeader);
+  CachedCode = CachedCode.subspan(CachedCodeOffset);
 
   if (!ValidationCTX) {
     ValidationCTX.reset(static_cast<ContextImpl*>(FEXCore::Context::Context::CreateNewContext(CTX.HostFeatures).release()));
@@ -443,6 +760,15 @@ void CodeCache::Validate(const ExecutableFileSectionInfo& Section, fextl::set<ui
 
   // Patch FEX-internal function addresses with values from the main Context to ensure the code blocks are comparable
   auto NewRelocations = ValidationThread->CPUBackend->TakeRelocations(Section.FileStartVA);
+  if (ModuleTableOffset) {
+    // Apply the same transformation as SaveData, using the location of the reference code within the cache
+    fextl::vector<CPU::Relocation> PICRelocations;
+    std::ranges::copy_if(NewRelocations, std::back_inserter(PICRelocations), [&](const CPU::Relocation& Reloc) {
+      return IsPositionIndependentRelocation(Reloc) && Reloc.Header.Offset + 16 <= CodeBufferRangeRef.size_bytes() &&
+             CachedCodeOffset + Reloc.Header.Offset + 16 <= ModuleTableOffset;
+    });
+    MakePositionIndependent(CodeBufferRangeRef, PICRelocations, CachedCodeOffset, ModuleTableOffset);
+  }
   NewRelocations.erase(std::remove_if(NewRelocations.begin(), NewRelocations.end(), [](const CPU::Relocation& Reloc) {
     return Reloc.Header.Type != CPU::RelocationTypes::RELOC_NAMED_SYMBOL_LITERAL && Reloc.Header.Type != CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE;
   }));
@@ -471,18 +797,22 @@ void CodeCache::Validate(const ExecutableFileSectionInfo& Section, fextl::set<ui
         addr >>= 14;
         auto header = reinterpret_cast<CPU::CPUBackend::JITCodeHeader*>(&Buffer[*BlockIt - *HostBlocks.begin() + 4 + addr]);
         auto tail = reinterpret_cast<CPU::CPUBackend::JITCodeTail*>(reinterpret_cast<uintptr_t>(header) + header->OffsetToBlockTail);
-        (i == 0 ? GuestBlockAddr : GuestBlockAddrRef) = tail->RIP - Section.FileStartVA;
-        LogMan::Msg::EFmt("Recorded rip {}: {:#x} (offset {:#x})", i, tail->RIP, tail->RIP - Section.FileStartVA);
+        // Position-independent literals are decoded against the module table of the cached code for both buffers
+        const auto TailRIPLocation = reinterpret_cast<uintptr_t>(&tail->RIP) - reinterpret_cast<uintptr_t>(Buffer.data());
+        const uint64_t TailRIP =
+          CPU::DecodeGuestRIPLiteral(reinterpret_cast<uintptr_t>(CachedCode.data()) + TailRIPLocation, tail->RIP);
+        (i == 0 ? GuestBlockAddr : GuestBlockAddrRef) = TailRIP - Section.FileStartVA;
+        LogMan::Msg::EFmt("Recorded rip {}: {:#x} (offset {:#x})", i, TailRIP, TailRIP - Section.FileStartVA);
 
         if (i == 1) {
-          if (tail->RIP >= Section.BeginVA && tail->RIP < Section.EndVA) {
+          if (TailRIP >= Section.BeginVA && TailRIP < Section.EndVA) {
             auto [IRView, TotalInstructions, TotalInstructionsLength, StartAddr, Length, _] =
-              ValidationCTX->GenerateIR(ValidationThread.get(), tail->RIP, false, FEXCore::Config::Get_MAXINST());
+              ValidationCTX->GenerateIR(ValidationThread.get(), TailRIP, false, FEXCore::Config::Get_MAXINST());
             fextl::ostringstream ss;
             FEXCore::IR::Dump(&ss, &*IRView);
             LogMan::Msg::EFmt("IR:\n{}", ss.str());
           } else {
-            LogMan::Msg::EFmt("Can't dump IR for out-of-range RIP {:#x}", tail->RIP);
+            LogMan::Msg::EFmt("Can't dump IR for out-of-range RIP {:#x}", TailRIP);
           }
         }
       }
@@ -553,6 +883,42 @@ bool CodeCache::ApplyCodeRelocations(uint64_t GuestEntry, std::span<std::byte> C
   return true;
 }
 
+void CodeCache::MakePositionIndependent(std::span<std::byte> Code, std::span<const CPU::Relocation> Relocations, uint64_t CodeOffset,
+                                        uint64_t ModuleTableOffset) {
+  CPU::Arm64Emitter Emitter(&CTX, Code.data(), Code.size_bytes());
+  for (auto& Reloc : Relocations) {
+    LOGMAN_THROW_A_FMT(IsPositionIndependentRelocation(Reloc), "Relocation can't be made position-independent");
+    // Location of the relocated data within the cache code buffer
+    const uint64_t Location = CodeOffset + Reloc.Header.Offset;
+    LOGMAN_THROW_A_FMT(Location < ModuleTableOffset, "Module table must follow all code");
+    Emitter.SetCursorOffset(Reloc.Header.Offset);
+
+    switch (Reloc.Header.Type) {
+    case CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE: {
+      // Replaces the padded 4-instruction constant load:
+      //   adrp Reg, ModuleTable
+      //   ldr Reg, [Reg, :lo12:ModuleTable]
+      //   add Reg, Reg, #(RIP >> 12), lsl #12
+      //   add Reg, Reg, #(RIP & 0xfff)
+      const auto Reg = ARMEmitter::Register(Reloc.GuestRIP.RegisterIndex);
+      const auto PageDelta = static_cast<int64_t>(ModuleTableOffset >> 12) - static_cast<int64_t>(Location >> 12);
+      Emitter.adrp(Reg, static_cast<uint32_t>(PageDelta));
+      Emitter.ldr(Reg.X(), Reg, static_cast<uint32_t>(ModuleTableOffset & 0xfff));
+      Emitter.add(ARMEmitter::Size::i64Bit, Reg, Reg, (Reloc.GuestRIP.GuestRIP >> 12) & 0xfff, true);
+      Emitter.add(ARMEmitter::Size::i64Bit, Reg, Reg, Reloc.GuestRIP.GuestRIP & 0xfff);
+      break;
+    }
+    case CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL: {
+      LOGMAN_THROW_A_FMT((ModuleTableOffset - Location) % 8 == 0, "Misaligned guest RIP literal");
+      Emitter.dc64(CPU::PIC_GUEST_RIP_TAG | (((ModuleTableOffset - Location) / 8) << 32) | Reloc.GuestRIP.GuestRIP);
+      break;
+    }
+
+    default: ERROR_AND_DIE_FMT("Unknown relocation type {}", ToUnderlying(Reloc.Header.Type));
+    }
+  }
+}
+
 fextl::unique_ptr<MappedCodeCacheFile>
 CodeCache::LoadCache(std::span<std::byte> CacheFile, const ExecutableFileInfo& FileInfo, uint64_t FileStartVA) {
   if (!EnableCodeCaching) {
@@ -570,12 +936,22 @@ CodeCache::LoadCache(std::span<std::byte> CacheFile, const ExecutableFileInfo& F
     return nullptr;
   }
 
+  if (header.FormatVersion != CodeCacheHeader {}.FormatVersion) {
+    LogMan::Msg::IFmt("Cache uses unsupported format version {}; skipping", header.FormatVersion);
+    return nullptr;
+  }
+
   if (!std::ranges::equal(header.FEXVersion, GIT_HASH)) {
     LogMan::Msg::IFmt("Cache generated from old FEX version {:02x}, current is {:02x}; skipping", fmt::join(header.FEXVersion, ""),
                       fmt::join(GIT_HASH, ""));
     return nullptr;
   }
 
+  if (header.ConfigId != ConfigId) {
+    LogMan::Msg::IFmt("Cache generated for configuration {:016x}, current is {:016x}; skipping", header.ConfigId, ConfigId);
+    return nullptr;
+  }
+
   if (header.NumBlocks == 0) {
     // Valid caches are never empty
     LogMan::Msg::IFmt("Code cache empty, aborting");
@@ -588,6 +964,7 @@ CodeCache::LoadCache(std::span<std::byte> CacheFile, const ExecutableFileInfo& F
   auto* Cursor = BlockListStart;
   for (uint32_t i = 0; i < header.NumBlocks; ++i) {
     Cursor += sizeof(uint64_t); // guest address
+    Cursor += sizeof(uint64_t); // guest code hash
     Cursor += sizeof(uint64_t); // host code address
     uint64_t NumGuestCodePages;
     ::memcpy(&NumGuestCodePages, Cursor, sizeof(NumGuestCodePages));
@@ -597,6 +974,7 @@ CodeCache::LoadCache(std::span<std::byte> CacheFile, const ExecutableFileInfo& F
 
   auto Relocations = std::span {reinterpret_cast<const FEXCore::CPU::Relocation*>(Cursor), header.NumRelocations};
   Cursor += Relocations.size_bytes();
+  Cursor += header.NumPositionIndependentRelocations * sizeof(FEXCore::CPU::Relocation);
 
   // Pad to next page to get the code buffer data
   Cursor = reinterpret_cast<std::byte*>(AlignUp(reinterpret_cast<uintptr_t>(Cursor), Utils::FEX_PAGE_SIZE));
@@ -642,7 +1020,8 @@ CodeCache::LoadCache(std::span<std::byte> CacheFile, const ExecutableFileInfo& F
   auto Storage = FEXCore::Allocator::aligned_alloc(alignof(MappedCodeCacheFile), sizeof(MappedCodeCacheFile));
   return fextl::unique_ptr<MappedCodeCacheFile>(
     new (Storage) MappedCodeCacheFile {this, CacheFile, CodeDataInFile, CodeBuffer, BlockListStart, header.NumBlocks, header.NumCodePages,
-                                       std::move(PageRelocationRanges), fextl::vector<bool>(NumPages), FileStartVA});
+                                       std::move(PageRelocationRanges), fextl::vector<bool>(NumPages), FileStartVA,
+                                       header.ModuleTableOffset});
 }
 
 bool CodeCache::EnableLoadedSection(Core::InternalThreadState* Thread, MappedCodeCacheFile& Code, const ExecutableFileSectionInfo& BinarySection) {
@@ -663,6 +1042,7 @@ bool CodeCache::EnableLoadedSection(Core::InternalThreadState* Thread, MappedCod
     for (auto& BlockPtr : BlockList) {
       ::memcpy(&BlockPtr.first, Cursor, sizeof(BlockPtr.first));
       Cursor += sizeof(BlockPtr.first);
+      Cursor += sizeof(uint64_t); // guest code hash, only used for cache regeneration
       ::memcpy(&BlockPtr.second.HostCode, Cursor, sizeof(BlockPtr.second.HostCode));
       Cursor += sizeof(BlockPtr.second.HostCode);
       uint64_t NumGuestPages;
@@ -746,8 +1126,14 @@ bool CodeCache::EnableLoadedSection(Core::InternalThreadState* Thread, MappedCod
   // TODO: Implement lazy mapping on Windows
   if (true) {
 #endif
+    // NOTE: The range is empty if the code was mapped through MapSharedCodeBuffer or MapCodeBufferFromFile
     auto Range = SelectCodeRangeToFinalize(Code, 0, Code.CodeBuffer.size_bytes() / Utils::FEX_PAGE_SIZE);
-    FinalizeCodePages(Code, Range);
+    if (!Range.empty()) {
+      FinalizeCodePages(Code, Range);
+      if (Thread) {
+        FEXCORE_PROFILE_INSTANT_INCREMENT(Thread, AccumulatedCodeCachePrivateBytes, Range.size_bytes());
+      }
+    }
   }
 
   if (EnableCodeCacheValidation) {
@@ -757,7 +1143,7 @@ bool CodeCache::EnableLoadedSection(Core::InternalThreadState* Thread, MappedCod
       HostBlocks.insert(Host.HostCode);
     }
 
-    Validate(BinarySection, std::move(GuestBlocks), HostBlocks, Code.CodeBuffer);
+    Validate(BinarySection, std::move(GuestBlocks), HostBlocks, Code.CodeBuffer, Code.ModuleTableOffset);
   }
 
   return true;
@@ -767,6 +1153,74 @@ bool CodeCache::EnableLoadedSection(Core::InternalThreadState* Thread, MappedCod
 
 namespace FEXCore {
 
+bool AbstractCodeCache::IsCompatibleCacheFile(std::span<const std::byte> CacheFile, uint64_t ConfigId) {
+  Context::CodeCacheHeader header {};
+  if (CacheFile.size_bytes() < sizeof(header)) {
+    return false;
+  }
+  ::memcpy(&header, CacheFile.data(), sizeof(header));
+
+  return std::ranges::equal(header.Magic, header.ExpectedMagic) && header.FormatVersion == Context::CodeCacheHeader {}.FormatVersion &&
+         std::ranges::equal(header.FEXVersion, GIT_HASH) && header.ConfigId == ConfigId && header.NumBlocks != 0;
+}
+
+uint64_t AbstractCodeCache::ComputeConfigId(const HostFeatures& Features) {
+  uint64_t Hash = 0;
+  auto HashValue = [&Hash]<typename T>(const T& Value) {
+    if constexpr (std::is_same_v<T, fextl::string>) {
+      Hash = XXH3_64bits_withSeed(Value.data(), Value.size(), Hash);
+    } else {
+      static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+      Hash = XXH3_64bits_withSeed(&Value, sizeof(Value), Hash);
+    }
+  };
+
+#define OPT_CODEGEN(enum) HashValue(FEXCore::Config::Get_##enum()());
+#include <FEXCore/Config/ConfigValues.inl>
+
+  // NOTE: CPUMIDRs is only used for CPUID emulation, which is resolved at runtime
+  for (auto Value : {Features.DCacheLineSize, Features.ICacheLineSize}) {
+    HashValue(Value);
+  }
+  for (bool Value : {Features.SupportsCacheMaintenanceOps,
+                     Features.SupportsAES,
+                     Features.SupportsCRC,
+                     Features.SupportsCLZERO,
+                     Features.SupportsAtomics,
+                     Features.SupportsRCPC,
+                     Features.SupportsTSOImm9,
+                     Features.SupportsRAND,
+                     Features.SupportsAVX,
+                     Features.SupportsSVE128,
+                     Features.SupportsSVE256,
+                     Features.SupportsSHA,
+                     Features.SupportsPMULL_128Bit,
+                     Features.SupportsCSSC,
+                     Features.SupportsFCMA,
+                     Features.SupportsFlagM,
+                     Features.SupportsFlagM2,
+                     Features.SupportsRPRES,
+                     Features.SupportsPreserveAllABI,
+                     Features.SupportsAES256,
+                     Features.SupportsSVEBitPerm,
+                     Features.SupportsCPUIndexInTPIDRRO,
+                     Features.SupportsFRINTTS,
+                     Features.SupportsECV,
+                     Features.SupportsWFXT,
+                     Features.Supports3DNow,
+                     Features.SupportsSSE4a,
+                     Features.SupportsMOPS,
+                     Features.PreferZVAForVZero,
+                     Features.SupportsAFP,
+                     Features.SupportsFloatExceptions,
+                     Features.IsInstCountCI}) {
+    HashValue(Value);
+  }
+  HashValue(Features.HostType);
+
+  return Hash;
+}
+
 static std::span<CPU::Relocation> SpanPageRelocations(const MappedCodeCacheFile& Code, size_t PageIndex) {
   auto [Offset, Count] = Code.PageRelocationRanges.at(PageIndex);
   return std::span {reinterpret_cast<FEXCore::CPU::Relocation*>(Code.MappedFile.data() + Offset), Count};
@@ -830,6 +1284,31 @@ std::span<std::byte> AbstractCodeCache::SelectCodeRangeToFinalize(MappedCodeCach
 
   return Code.CodeBuffer.subspan(StartPage * Utils::FEX_PAGE_SIZE, (EndPage - StartPage) * Utils::FEX_PAGE_SIZE);
 }
+
+fextl::vector<uint32_t> AbstractCodeCache::GetEagerFinalizationOrder(const MappedCodeCacheFile& Code) {
+  fextl::vector<uint32_t> NumBlocksPerPage(Code.NumPages());
+  auto* Cursor = Code.BlockListInFile;
+  for (uint32_t i = 0; i < Code.NumBlocks; ++i) {
+    Cursor += sizeof(uint64_t); // guest address
+    Cursor += sizeof(uint64_t); // guest code hash
+    uint64_t HostCode;
+    ::memcpy(&HostCode, Cursor, sizeof(HostCode));
+    Cursor += sizeof(HostCode);
+    uint64_t NumGuestCodePages;
+    ::memcpy(&NumGuestCodePages, Cursor, sizeof(NumGuestCodePages));
+    Cursor += sizeof(NumGuestCodePages);
+    Cursor += NumGuestCodePages * sizeof(uint64_t);
+
+    if (HostCode < Code.CodeBuffer.size_bytes()) {
+      ++NumBlocksPerPage[HostCode / Utils::FEX_PAGE_SIZE];
+    }
+  }
+
+  fextl::vector<uint32_t> Order(Code.NumPages());
+  std::iota(Order.begin(), Order.end(), 0);
+  std::ranges::stable_sort(Order, std::greater {}, [&](uint32_t Page) { return NumBlocksPerPage[Page]; });
+  return Order;
+}
 } // namespace FEXCore
 
 namespace FEXCore::Context {
@@ -904,4 +1383,163 @@ void CodeCache::FinalizeCodePages(MappedCodeCacheFile& Code, std::span<std::byte
   ARMEmitter::Emitter::ClearICache(CodeRange.data(), Size);
 }
 
+// Relocations that refer to process-specific host addresses, as opposed to guest addresses
+static bool IsHostRelocation(const CPU::Relocation& Reloc) {
+  return Reloc.Header.Type == CPU::RelocationTypes::RELOC_NAMED_SYMBOL_LITERAL ||
+         Reloc.Header.Type == CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE;
+}
+
+int CodeCache::CreateSharedCodeBuffer(MappedCodeCacheFile& Code) {
+#ifndef _WIN32
+  FEXCORE_PROFILE_SCOPED("CreateSharedCodeBuffer");
+
+#ifndef MFD_EXEC
+#define MFD_EXEC 0x0010U
+#endif
+  // The buffer will be mapped executable, which must be requested explicitly if vm.memfd_noexec is set
+  int FD = ::memfd_create("FEXCodeCache", MFD_CLOEXEC | MFD_ALLOW_SEALING | MFD_EXEC);
+  if (FD == -1 && errno == EINVAL) {
+    // MFD_EXEC is unsupported on kernels older than 6.3
+    FD = ::memfd_create("FEXCodeCache", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  }
+  if (FD == -1) {
+    return -1;
+  }
+
+  const size_t Size = Code.CodeBuffer.size_bytes();
+  if (ftruncate(FD, Size) != 0) {
+    close(FD);
+    return -1;
+  }
+
+  auto* Staging = reinterpret_cast<std::byte*>(Allocator::mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0));
+  if (Staging == MAP_FAILED) {
+    close(FD);
+    return -1;
+  }
+
+  // Apply guest relocations only. Host addresses are zeroed and patched by each process in MapSharedCodeBuffer.
+  memcpy(Staging, Code.CodeBufferInFile.data(), Size);
+  auto StagingSpan = std::span {Staging, Size};
+  for (size_t i = 0; i < Code.NumPages(); ++i) {
+    (void)ApplyCodeRelocations(Code.GuestBase, StagingSpan, SpanPageRelocations(Code, i), 0, true);
+  }
+  Allocator::munmap(Staging, Size);
+
+  // Other processes will execute this data as-is, so make sure it can't change anymore
+  if (fcntl(FD, F_ADD_SEALS, F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE) != 0) {
+    close(FD);
+    return -1;
+  }
+
+  return FD;
+#else
+  return -1;
+#endif
+}
+
+std::optional<size_t> CodeCache::MapCodeBufferPrivately(MappedCodeCacheFile& Code, int FD, uint64_t FileOffset, bool OnlyHostRelocations) {
+#ifndef _WIN32
+  LOGMAN_THROW_A_FMT(std::ranges::find(Code.LoadedPages, true) == Code.LoadedPages.end(), "Code pages were already finalized");
+
+  // Map the buffer privately so that patching relocations only copies the affected pages.
+  // No code has been registered for this buffer yet, so it's safe to modify in place.
+  const size_t Size = Code.CodeBuffer.size_bytes();
+  void* Result = ::mmap(Code.CodeBuffer.data(), Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, FD, FileOffset);
+  if (Result == MAP_FAILED) {
+    ERROR_AND_DIE_FMT("{}: mmap failed: {}", __FUNCTION__, errno);
+  }
+
+  // Writable until relocations are applied, see below
+  if (::mprotect(Code.CodeBuffer.data(), Size, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+    // Executable file mappings may be rejected (e.g. for noexec mounts), so restore the reservation for lazy finalization
+    LogMan::Msg::DFmt("{}: mprotect failed: {}", __FUNCTION__, errno);
+    if (::mmap(Code.CodeBuffer.data(), Size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED) {
+      ERROR_AND_DIE_FMT("{}: mmap failed: {}", __FUNCTION__, errno);
+    }
+    return std::nullopt;
+  }
+
+  fextl::vector<bool> PrivatePages(Code.NumPages());
+  for (size_t i = 0; i < Code.NumPages(); ++i) {
+    for (auto& Reloc : SpanPageRelocations(Code, i)) {
+      if (OnlyHostRelocations && !IsHostRelocation(Reloc)) {
+        continue;
+      }
+
+      (void)ApplyCodeRelocations(Code.GuestBase, Code.CodeBuffer, std::span {&Reloc, 1}, 0, false);
+      PrivatePages[Reloc.Header.Offset / Utils::FEX_PAGE_SIZE] = true;
+      PrivatePages[std::min<size_t>((Reloc.Header.Offset + 16 /* Upper bound for relocation size */) / Utils::FEX_PAGE_SIZE,
+                                    Code.NumPages() - 1)] = true;
+    }
+  }
+
+  // Keep untouched pages read-only, so that later writes (e.g. from block linking) fault and can be accounted for.
+  // See HandleSharedCodePageWriteFault.
+  size_t NumPrivatePages = 0;
+  std::fill(Code.LoadedPages.begin(), Code.LoadedPages.end(), true);
+  Code.SharedPages.assign(Code.NumPages(), false);
+  for (size_t i = 0; i < Code.NumPages();) {
+    if (PrivatePages[i]) {
+      ARMEmitter::Emitter::ClearICache(Code.CodeBuffer.data() + i * Utils::FEX_PAGE_SIZE, Utils::FEX_PAGE_SIZE);
+      ++NumPrivatePages;
+      ++i;
+      continue;
+    }
+
+    size_t End = i + 1;
+    while (End < Code.NumPages() && !PrivatePages[End]) {
+      ++End;
+    }
+    if (::mprotect(Code.CodeBuffer.data() + i * Utils::FEX_PAGE_SIZE, (End - i) * Utils::FEX_PAGE_SIZE, PROT_READ | PROT_EXEC) == 0) {
+      std::fill(Code.SharedPages.begin() + i, Code.SharedPages.begin() + End, true);
+    }
+    i = End;
+  }
+
+  // The cache file data won't be used anymore
+  Allocator::VirtualDontNeed(Code.CodeBufferInFile.data(), Size);
+
+  return NumPrivatePages;
+#else
+  return std::nullopt;
+#endif
+}
+
+std::optional<size_t> CodeCache::MapSharedCodeBuffer(MappedCodeCacheFile& Code, int FD) {
+#ifndef _WIN32
+  FEXCORE_PROFILE_SCOPED("MapSharedCodeBuffer");
+
+  // The buffer may come from a different process, so only accept it if it's immutable and matches the cache layout
+  constexpr int RequiredSeals = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+  const int Seals = fcntl(FD, F_GET_SEALS);
+  struct stat Stat {};
+  if (Seals == -1 || (Seals & RequiredSeals) != RequiredSeals || fstat(FD, &Stat) != 0 ||
+      static_cast<size_t>(Stat.st_size) != Code.CodeBuffer.size_bytes()) {
+    LogMan::Msg::EFmt("Rejecting invalid shared code buffer");
+    return std::nullopt;
+  }
+
+  // Guest relocations were applied by CreateSharedCodeBuffer
+  return MapCodeBufferPrivately(Code, FD, 0, true);
+#else
+  return std::nullopt;
+#endif
+}
+
+std::optional<size_t> CodeCache::MapCodeBufferFromFile(MappedCodeCacheFile& Code, int FD) {
+#ifndef _WIN32
+  if (!Code.ModuleTableOffset) {
+    return std::nullopt;
+  }
+
+  FEXCORE_PROFILE_SCOPED("MapCodeBufferFromFile");
+
+  // The code buffer data is page-aligned within the cache file
+  return MapCodeBufferPrivately(Code, FD, Code.CodeBufferInFile.data() - Code.MappedFile.data(), false);
+#else
+  return std::nullopt;
+#endif
+}
+
 } // namespace FEXCore::Context
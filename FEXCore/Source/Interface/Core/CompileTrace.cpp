@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: backend|shared
+desc: Binary trace of block compilation events
+$end_info$
+*/
+
+#include "Interface/Core/CompileTrace.h"
+
+#include <FEXCore/Core/CodeCache.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/fextl/fmt.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace FEXCore::CPU {
+namespace {
+  constexpr size_t RING_SIZE = 1024 * 1024;
+
+  // Wake up the writer thread early once a quarter of the ring is in use
+  constexpr size_t DRAIN_THRESHOLD = RING_SIZE / 4;
+  constexpr auto DRAIN_INTERVAL = std::chrono::seconds(1);
+
+  uint32_t GetProcessID() {
+#ifndef _WIN32
+    return ::getpid();
+#else
+    return GetCurrentProcessId();
+#endif
+  }
+} // namespace
+
+CompileTraceWriter::CompileTraceWriter(fextl::string Folder, fextl::string ApplicationName)
+  : Folder {std::move(Folder)}
+  , ApplicationName {std::move(ApplicationName)}
+  , Ring(RING_SIZE) {
+  WriterThread = FEXCore::Threads::Thread::Create(ThreadEntry, this);
+}
+
+CompileTraceWriter::~CompileTraceWriter() {
+  {
+    std::scoped_lock lk {Mutex};
+    Stop = true;
+  }
+  CV.notify_one();
+
+  if (WriterThread && WriterThread->joinable()) {
+    WriterThread->join(nullptr);
+  }
+}
+
+void CompileTraceWriter::OpenFile() {
+  OpenedFile = true;
+
+  const auto Filename = fextl::fmt::format("{}/{}-{}.jittrace", Folder, ApplicationName, GetProcessID());
+  TraceFile.emplace(Filename.c_str(), FEXCore::File::FileModes::WRITE | FEXCore::File::FileModes::CREATE | FEXCore::File::FileModes::TRUNCATE);
+  if (!TraceFile->IsValid()) {
+    LogMan::Msg::EFmt("Failed to open compile trace {}", Filename);
+    TraceFile.reset();
+    return;
+  }
+
+  const CompileTrace::FileHeader Header {
+    .Magic = CompileTrace::MAGIC,
+    .Version = CompileTrace::VERSION,
+  };
+  TraceFile->Write(&Header, sizeof(Header));
+}
+
+bool CompileTraceWriter::Append(std::span<const std::byte> Data) {
+  if (WritePosition - ReadPosition + Data.size() > Ring.size()) {
+    ++DroppedRecords;
+    return false;
+  }
+
+  const auto Offset = WritePosition % Ring.size();
+  const auto FirstPart = std::min(Data.size(), Ring.size() - Offset);
+  memcpy(Ring.data() + Offset, Data.data(), FirstPart);
+  memcpy(Ring.data(), Data.data() + FirstPart, Data.size() - FirstPart);
+  WritePosition += Data.size();
+  return true;
+}
+
+void CompileTraceWriter::AppendClock() {
+  const auto Now = std::chrono::steady_clock::now().time_since_epoch();
+  const CompileTrace::ClockRecord Record {
+    .Header = {CompileTrace::RecordType::Clock, sizeof(CompileTrace::ClockRecord)},
+    .Cycles = SHMStats::GetCycleCounter(),
+    .MonotonicNS = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Now).count()),
+  };
+  Append(std::as_bytes(std::span {&Record, 1}));
+}
+
+void CompileTraceWriter::AddBlock(CompileTrace::BlockRecord& Record, const ExecutableFileSectionInfo* Section) {
+  Record.Header = {CompileTrace::RecordType::Block, sizeof(CompileTrace::BlockRecord)};
+  Record.ModuleID = CompileTrace::INVALID_MODULE_ID;
+
+  bool ShouldWake {};
+  {
+    std::scoped_lock lk {Mutex};
+
+    if (WritePosition == 0) {
+      // Gives readers a reference point for the first blocks
+      AppendClock();
+    }
+
+    if (Section) {
+      const auto& Filename = Section->FileInfo.Filename;
+      auto [It, Inserted] = ModuleIDs.try_emplace(Filename, ModuleIDs.size());
+      if (Inserted) {
+        // Module paths are capped so the record size fits in RecordHeader::Size
+        const uint32_t NameLength = std::min<size_t>(Filename.size(), 4096);
+        const CompileTrace::ModuleRecord ModuleRecord {
+          .Header = {CompileTrace::RecordType::Module,
+                     static_cast<uint16_t>(FEXCore::AlignUp(sizeof(CompileTrace::ModuleRecord) + NameLength, 8))},
+          .ModuleID = It->second,
+          .NameLength = NameLength,
+        };
+
+        std::array<std::byte, sizeof(ModuleRecord) + 4096 + 8> Buffer {};
+        memcpy(Buffer.data(), &ModuleRecord, sizeof(ModuleRecord));
+        memcpy(Buffer.data() + sizeof(ModuleRecord), Filename.data(), NameLength);
+        if (!Append(std::span {Buffer.data(), ModuleRecord.Header.Size})) {
+          // Retry the module record with the next block from it
+          ModuleIDs.erase(It);
+        }
+      }
+
+      if (auto It = ModuleIDs.find(Filename); It != ModuleIDs.end()) {
+        Record.ModuleID = It->second;
+        Record.ModuleOffset = Record.GuestRIP - Section->FileStartVA;
+      }
+    }
+
+    Append(std::as_bytes(std::span {&Record, 1}));
+    ShouldWake = WritePosition - ReadPosition >= DRAIN_THRESHOLD;
+  }
+
+  if (ShouldWake) {
+    CV.notify_one();
+  }
+}
+
+void CompileTraceWriter::Drain() {
+  uint64_t Begin, End;
+  uint32_t Dropped;
+  {
+    std::scoped_lock lk {Mutex};
+    if (ReadPosition == WritePosition && !DroppedRecords) {
+      return;
+    }
+    AppendClock();
+    Begin = ReadPosition;
+    End = WritePosition;
+    Dropped = std::exchange(DroppedRecords, 0);
+  }
+
+  // The file is only created once there is something to write, so that contexts which never compile
+  // a block (like the code cache validation context) don't clobber the trace
+  if (!OpenedFile) {
+    OpenFile();
+  }
+
+  if (TraceFile) {
+    // The range is owned by the reader until ReadPosition is advanced, so it's safe to write without holding Mutex
+    const auto Offset = Begin % Ring.size();
+    const auto Size = End - Begin;
+    const auto FirstPart = std::min<uint64_t>(Size, Ring.size() - Offset);
+    TraceFile->Write(Ring.data() + Offset, FirstPart);
+    TraceFile->Write(Ring.data(), Size - FirstPart);
+
+    if (Dropped) {
+      const CompileTrace::DroppedRecord Record {
+        .Header = {CompileTrace::RecordType::Dropped, sizeof(CompileTrace::DroppedRecord)},
+        .NumRecords = Dropped,
+      };
+      TraceFile->Write(&Record, sizeof(Record));
+    }
+  }
+
+  std::scoped_lock lk {Mutex};
+  ReadPosition = End;
+}
+
+void CompileTraceWriter::Flush() {
+  std::scoped_lock lk {FileMutex};
+  Drain();
+}
+
+void CompileTraceWriter::ThreadProc() {
+  while (true) {
+    {
+      std::unique_lock lk {Mutex};
+      CV.wait_for(lk, DRAIN_INTERVAL, [this] { return Stop || WritePosition - ReadPosition >= DRAIN_THRESHOLD; });
+      if (Stop) {
+        break;
+      }
+    }
+
+    Flush();
+  }
+
+  Flush();
+}
+
+void CompileTraceWriter::UnlockAfterFork(bool Child) {
+  if (!Child) {
+    Mutex.unlock();
+    FileMutex.unlock();
+    return;
+  }
+
+  // The writer thread doesn't exist in the child, so a new one is started for the child's own trace file
+  (void)WriterThread.release();
+  ReadPosition = WritePosition = 0;
+  DroppedRecords = 0;
+  ModuleIDs.clear();
+  Mutex.unlock();
+
+  TraceFile.reset();
+  OpenedFile = false;
+  FileMutex.unlock();
+
+  WriterThread = FEXCore::Threads::Thread::Create(ThreadEntry, this);
+}
+} // namespace FEXCore::CPU
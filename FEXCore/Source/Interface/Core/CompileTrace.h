@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: backend|shared
+desc: Binary trace of block compilation events
+$end_info$
+*/
+#pragma once
+
+#include <FEXCore/Utils/CompileTrace.h>
+#include <FEXCore/Utils/File.h>
+#include <FEXCore/Utils/SHMStats.h>
+#include <FEXCore/Utils/Threads.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+
+namespace FEXCore {
+struct ExecutableFileSectionInfo;
+}
+
+namespace FEXCore::CPU {
+
+/**
+ * Adds the cycles spent in its scope to one stage of a block record. Does nothing if the record is null.
+ */
+class CompileTraceStageTimer final {
+public:
+  CompileTraceStageTimer(CompileTrace::BlockRecord* Record, CompileTrace::Stage Stage)
+    : Record {Record}
+    , Stage {Stage}
+    , Begin {Record ? SHMStats::GetCycleCounter() : 0} {}
+
+  ~CompileTraceStageTimer() {
+    if (Record) {
+      Record->StageCycles[Stage] += SHMStats::GetCycleCounter() - Begin;
+    }
+  }
+
+private:
+  CompileTrace::BlockRecord* Record;
+  CompileTrace::Stage Stage;
+  uint64_t Begin;
+};
+
+/**
+ * Writes CompileTrace records to <Folder>/<Application>-<pid>.jittrace.
+ *
+ * Records are appended to a fixed size ring buffer that a background thread drains to the file,
+ * so compiling threads never block on file IO. Records that don't fit are counted and reported
+ * with a Dropped record instead.
+ */
+class CompileTraceWriter final {
+public:
+  CompileTraceWriter(fextl::string Folder, fextl::string ApplicationName);
+  ~CompileTraceWriter();
+
+  // Fills in the record's header and module information and queues it
+  void AddBlock(CompileTrace::BlockRecord& Record, const ExecutableFileSectionInfo* Section);
+
+  // Synchronously writes all queued records
+  void Flush();
+
+  void LockBeforeFork() {
+    FileMutex.lock();
+    Mutex.lock();
+  }
+  // The child drops records inherited from the parent and starts its own trace file
+  void UnlockAfterFork(bool Child);
+
+private:
+  static void* ThreadEntry(void* Self) {
+    static_cast<CompileTraceWriter*>(Self)->ThreadProc();
+    return nullptr;
+  }
+  void ThreadProc();
+
+  // Must be called with FileMutex held
+  void OpenFile();
+  // Must be called with Mutex held. Returns false if the record didn't fit.
+  bool Append(std::span<const std::byte> Data);
+  void AppendClock();
+  // Must be called with FileMutex held
+  void Drain();
+
+  const fextl::string Folder;
+  const fextl::string ApplicationName;
+
+  // Protects the file, only held while draining
+  std::mutex FileMutex;
+  std::optional<FEXCore::File::File> TraceFile;
+  bool OpenedFile {};
+
+  // Protects everything below
+  std::mutex Mutex;
+  std::condition_variable CV;
+  bool Stop {};
+
+  fextl::vector<std::byte> Ring;
+  // Monotonic byte positions, wrapped to the ring size when accessing it
+  uint64_t ReadPosition {};
+  uint64_t WritePosition {};
+  uint32_t DroppedRecords {};
+
+  fextl::unordered_map<fextl::string, uint32_t> ModuleIDs;
+
+  fextl::unique_ptr<FEXCore::Threads::Thread> WriterThread;
+};
+} // namespace FEXCore::CPU
@@ -64,6 +64,9 @@ $end_info$
 #include <condition_variable>
 #include <fcntl.h>
 #include <functional>
+#ifndef _WIN32
+#include <linux/futex.h>
+#endif
 #include <mutex>
 #include <queue>
 #include <shared_mutex>
@@ -71,6 +74,9 @@ $end_info$
 #include <stdio.h>
 #include <string_view>
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/syscall.h>
+#endif
 #include <type_traits>
 #include <unistd.h>
 #include <unordered_map>
@@ -92,6 +98,10 @@ ContextImpl::ContextImpl(const FEXCore::HostFeatures& Features)
     Symbols.InitFile();
   }
 
+  if (Config.PerfJitDump()) {
+    Symbols.InitJitDump();
+  }
+
   uint64_t FrequencyCounter = FEXCore::GetCycleCounterFrequency();
   if (FrequencyCounter && FrequencyCounter < FEXCore::Context::TSC_SCALE_MAXIMUM && Config.SmallTSCScale()) {
     // Scale TSC until it is at the minimum required.
@@ -125,7 +135,11 @@ static GetFrameBlockInfoResult GetFrameBlockInfo(FEXCore::Core::CpuStateFrame* F
 
 bool ContextImpl::IsAddressInCurrentBlock(FEXCore::Core::InternalThreadState* Thread, uint64_t Address, uint64_t Size) {
   auto [_, InlineTail] = GetFrameBlockInfo(Thread->CurrentFrame);
-  return InlineTail && (Address + Size > InlineTail->RIP && Address < InlineTail->RIP + InlineTail->GuestSize);
+  if (!InlineTail) {
+    return false;
+  }
+  const auto BlockRIP = InlineTail->GetRIP();
+  return Address + Size > BlockRIP && Address < BlockRIP + InlineTail->GuestSize;
 }
 
 bool ContextImpl::IsCurrentBlockSingleInst(FEXCore::Core::InternalThreadState* Thread) {
@@ -135,7 +149,7 @@ bool ContextImpl::IsCurrentBlockSingleInst(FEXCore::Core::InternalThreadState* T
 
 uint64_t ContextImpl::GetGuestBlockEntry(FEXCore::Core::InternalThreadState* Thread) {
   auto [_, InlineTail] = GetFrameBlockInfo(Thread->CurrentFrame);
-  return InlineTail ? InlineTail->RIP : 0;
+  return InlineTail ? InlineTail->GetRIP() : 0;
 }
 
 uint64_t ContextImpl::RestoreRIPFromHostPC(FEXCore::Core::InternalThreadState* Thread, uint64_t HostPC) {
@@ -154,7 +168,7 @@ uint64_t ContextImpl::RestoreRIPFromHostPC(FEXCore::Core::InternalThreadState* T
 
       // Reconstruct RIP from JIT entries for this block.
       uint64_t StartingHostPC = BlockBegin;
-      uint64_t StartingGuestRIP = InlineTail->RIP;
+      uint64_t StartingGuestRIP = InlineTail->GetRIP();
 
       for (uint32_t i = 0; i < InlineTail->NumberOfRIPEntries; ++i) {
         auto Offset = FEXCore::Utils::vl64pair::Decode(RIPEntry);
@@ -344,6 +358,8 @@ void ContextImpl::SetFlagsFromCompactedEFLAGS(FEXCore::Core::InternalThreadState
 }
 
 bool ContextImpl::InitCore() {
+  CodeCache.ConfigId = AbstractCodeCache::ComputeConfigId(HostFeatures);
+
   if (CodeCache.IsGeneratingCache || FEXCore::Config::Get_ENABLECODECACHINGWIP()) {
     // Start with a larger code buffer to avoid resizes that would discard code
     StartMaximalCodeBuffer();
@@ -355,6 +371,13 @@ bool ContextImpl::InitCore() {
   // Set up the SignalDelegator config since core is initialized.
   SignalDelegation->SetConfig(Dispatcher->MakeSignalDelegatorConfig());
 
+  if (!Config.CompileTrace().empty()) {
+    std::string_view ApplicationName = AppFilename();
+    ApplicationName = ApplicationName.substr(ApplicationName.find_last_of('/') + 1);
+    CompileTraceWriter =
+      fextl::make_unique<CPU::CompileTraceWriter>(Config.CompileTrace(), fextl::string {ApplicationName.empty() ? "FEX" : ApplicationName});
+  }
+
 #if defined(_WIN32) && !defined(ARCHITECTURE_arm64ec)
   // WOW64 always needs the interrupt fault check to be enabled.
   Config.NeedsPendingInterruptFaultCheck = true;
@@ -441,10 +464,16 @@ ContextImpl::CreateThread(uint64_t InitialRIP, uint64_t StackPointer, const FEXC
     Thread->SymbolBuffer = JITSymbols::AllocateBuffer();
   }
 
+  if (Config.PerfJitDump()) {
+    Thread->JitDumpBuffer = JITSymbols::AllocateBuffer();
+  }
+
   return Thread;
 }
 
 void ContextImpl::DestroyThread(FEXCore::Core::InternalThreadState* Thread) {
+  FlushJITSymbols(Thread);
+
   FEXCore::Allocator::VirtualProtect(&Thread->InterruptFaultPage, sizeof(Thread->InterruptFaultPage),
                                      Allocator::ProtectOptions::Read | Allocator::ProtectOptions::Write);
   delete Thread;
@@ -453,12 +482,22 @@ void ContextImpl::DestroyThread(FEXCore::Core::InternalThreadState* Thread) {
 #ifndef _WIN32
 void ContextImpl::UnlockAfterFork(FEXCore::Core::InternalThreadState* LiveThread, bool Child) {
   Allocator::UnlockAfterFork(LiveThread, Child);
+  CodeCache.UnlockAfterFork(Child);
 
   Profiler::PostForkAction(Child);
+  if (Config.BlockStats()) {
+    BlockStats.UnlockAfterFork(Child);
+  }
+  if (CompileTraceWriter) {
+    CompileTraceWriter->UnlockAfterFork(Child);
+  }
   if (Child) {
     if (CodeMapWriter) {
       CodeMapWriter->ResetAfterFork();
     }
+    if (Config.PerfJitDump()) {
+      Symbols.ResetJitDumpAfterFork(LiveThread->JitDumpBuffer.get());
+    }
 
     CodeInvalidationMutex.StealAndDropActiveLocks();
     if (Config.StrictInProcessSplitLocks) {
@@ -474,7 +513,14 @@ void ContextImpl::UnlockAfterFork(FEXCore::Core::InternalThreadState* LiveThread
 
 void ContextImpl::LockBeforeFork(FEXCore::Core::InternalThreadState* Thread) {
   CodeInvalidationMutex.lock();
+  if (Config.BlockStats()) {
+    BlockStats.LockBeforeFork();
+  }
+  if (CompileTraceWriter) {
+    CompileTraceWriter->LockBeforeFork();
+  }
   Allocator::LockBeforeFork(Thread);
+  CodeCache.LockBeforeFork();
   if (Config.StrictInProcessSplitLocks) {
     FEXCore::Utils::SpinWaitLock::lock(&StrictSplitLockMutex);
   }
@@ -486,12 +532,26 @@ void ContextImpl::OnCodeBufferAllocated(const fextl::shared_ptr<CPU::CodeBuffer>
     Symbols.RegisterJITSpace(Buffer->GetBufferBase(), Buffer->GetAllocatedSize());
   }
 
+  if (Config.BlockStats()) {
+    BlockStats.OnCodeBufferAllocated(Buffer);
+  }
+
   {
     std::scoped_lock lk {CodeBufferListLock};
     CodeBufferList.emplace_back(Buffer);
   }
 }
 
+void ContextImpl::FlushJITSymbols(FEXCore::Core::InternalThreadState* Thread) {
+  Symbols.Flush(Thread->SymbolBuffer.get(), Thread->JitDumpBuffer.get());
+}
+
+void ContextImpl::WriteBlockStats(FEXCore::Core::InternalThreadState* Thread) {
+  if (Config.BlockStats()) {
+    BlockStats.Dump(SyscallHandler, Thread, Config.BlockStats());
+  }
+}
+
 void ContextImpl::ClearCodeCache(FEXCore::Core::InternalThreadState* Thread, bool NewCodeBuffer) {
   FEXCORE_PROFILE_INSTANT("ClearCodeCache");
 
@@ -518,8 +578,8 @@ bool ContextImpl::CheckIfBlockIsCacheable(FEXCore::Core::InternalThreadState& Th
   return Thread.FrontendDecoder->CheckIfCacheable(Thread, reinterpret_cast<const uint8_t*>(GuestRIP), GuestRIP, MaxInst);
 }
 
-ContextImpl::GenerateIRResult
-ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint64_t MaxInst) {
+ContextImpl::GenerateIRResult ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, bool ExtendedDebugInfo,
+                                                      uint64_t MaxInst, CompileTrace::BlockRecord* Trace) {
   FEXCORE_PROFILE_SCOPED("GenerateIR");
 
   Thread->OpDispatcher->ResetWorkingList();
@@ -533,6 +593,7 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
     std::shared_lock lk(CustomIRMutex);
     auto Handler = CustomIRHandlers.find(GuestRIP);
     if (Handler != CustomIRHandlers.end()) {
+      CPU::CompileTraceStageTimer DispatchTimer {Trace, CompileTrace::STAGE_DISPATCH};
       TotalInstructions = 1;
       TotalInstructionsLength = 1;
       Handler->second.Handler(GuestRIP, Thread->OpDispatcher.get());
@@ -543,7 +604,12 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
   if (!HasCustomIR) {
     const auto* GuestCode = reinterpret_cast<const uint8_t*>(GuestRIP);
 
-    Thread->FrontendDecoder->DecodeInstructionsAtEntry(Thread, GuestCode, GuestRIP, MaxInst);
+    {
+      CPU::CompileTraceStageTimer DecodeTimer {Trace, CompileTrace::STAGE_DECODE};
+      Thread->FrontendDecoder->DecodeInstructionsAtEntry(Thread, GuestCode, GuestRIP, MaxInst);
+    }
+
+    CPU::CompileTraceStageTimer DispatchTimer {Trace, CompileTrace::STAGE_DISPATCH};
 
     const auto* BlockInfo = Thread->FrontendDecoder->GetDecodedBlockInfo();
     const auto& CodeBlocks = BlockInfo->Blocks;
@@ -591,6 +657,7 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
 
       // Reset any block-specific state
       Thread->OpDispatcher->StartNewBlock();
+      Thread->OpDispatcher->SetSpinWaitAccess(Block.SpinWait);
 
       const uint64_t InstsInBlock = Block.NumInstructions;
       if (InstsInBlock == 0) {
@@ -763,7 +830,7 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
   }
 
   // Run the passmanager over the IR from the dispatcher
-  Thread->PassManager->Run(IREmitter);
+  Thread->PassManager->Run(IREmitter, Trace);
 
   // Debug
   if (ShouldDump) {
@@ -780,9 +847,11 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
   };
 }
 
-ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, uint64_t MaxInst) {
+ContextImpl::CompileCodeResult
+ContextImpl::CompileCode(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, uint64_t MaxInst, CompileTrace::BlockRecord* Trace,
+                         const std::optional<ExecutableFileSectionInfo>* Section) {
   if (SourcecodeResolver && Config.GDBSymbols()) {
-    auto MappedSection = SyscallHandler->LookupExecutableFileSection(Thread, GuestRIP);
+    auto MappedSection = Section ? *Section : SyscallHandler->LookupExecutableFileSection(Thread, GuestRIP);
     if (MappedSection) {
       MappedSection->FileInfo.SourcecodeMap =
         SourcecodeResolver->GenerateMap(MappedSection->FileInfo.Filename, CodeMap::GetBaseFilename(MappedSection->FileInfo, false));
@@ -791,7 +860,7 @@ ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalT
 
   // Generate IR + Meta Info
   auto [IRView, TotalInstructions, TotalInstructionsLength, StartAddr, Length, NeedsAddGuestCodeRanges] =
-    GenerateIR(Thread, GuestRIP, Config.GDBSymbols(), MaxInst);
+    GenerateIR(Thread, GuestRIP, Config.GDBSymbols() || Config.PerfJitDump(), MaxInst, Trace);
   if (!IRView) {
     // OpDispatcher IR already released in this case.
     return {{}, nullptr, 0, 0, false};
@@ -806,6 +875,9 @@ ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalT
     if (auto Block = Thread->LookupCache->FindBlock(Thread, GuestRIP)) {
       // Raced to compile, release the OpDispatcher IR.
       Thread->OpDispatcher->DelayedDisownBuffer();
+      if (Trace) {
+        Trace->Flags |= CompileTrace::BLOCK_FLAG_RACED;
+      }
       return {.CompiledCode = {.BlockBegin = reinterpret_cast<uint8_t*>(Block), .EntryPoints = {{GuestRIP, reinterpret_cast<uint8_t*>(Block)}}},
               .DebugData = nullptr,
               .StartAddr = 0,
@@ -815,11 +887,22 @@ ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalT
   }
 
   auto DebugData = fextl::make_unique<FEXCore::Core::DebugData>();
+  DebugData->GuestInstructions = TotalInstructions;
 
   // If the trap flag is set we generate single instruction blocks that each check to generate a single step exception.
   bool TFSet = Thread->CurrentFrame->State.flags[X86State::RFLAG_TF_RAW_LOC];
 
-  auto CompiledCode = Thread->CPUBackend->CompileCode(GuestRIP, Length, TotalInstructions == 1, &*IRView, DebugData.get(), TFSet);
+  CPU::CPUBackend::CompiledCode CompiledCode;
+  {
+    CPU::CompileTraceStageTimer EmitTimer {Trace, CompileTrace::STAGE_EMIT};
+    CompiledCode = Thread->CPUBackend->CompileCode(GuestRIP, Length, TotalInstructions == 1, &*IRView, DebugData.get(), TFSet);
+  }
+
+  if (Trace) {
+    Trace->GuestInstructions = TotalInstructions;
+    Trace->IROps = IRView->GetSSACount();
+    Trace->HostBytes = CompiledCode.Size;
+  }
 
   // Release the IR
   Thread->OpDispatcher->DelayedDisownBuffer();
@@ -847,7 +930,23 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
 
   auto Thread = Frame->Thread;
   FEXCORE_PROFILE_SCOPED("CompileBlock");
-  FEXCORE_PROFILE_ACCUMULATION(Thread, AccumulatedJITTime);
+  FEXCORE_PROFILE_ACCUMULATION_HISTOGRAM(Thread, AccumulatedJITTime, JITTimeHistogram);
+
+  CompileTrace::BlockRecord TraceRecord {};
+  CompileTrace::BlockRecord* Trace {};
+  if (CompileTraceWriter) [[unlikely]] {
+    TraceRecord.GuestRIP = GuestRIP;
+    TraceRecord.MaxInst = MaxInst;
+    TraceRecord.TotalCycles = SHMStats::GetCycleCounter();
+    Trace = &TraceRecord;
+  }
+  const auto SubmitTrace = [&](CompileTrace::BlockSource Source, const std::optional<ExecutableFileSectionInfo>& Section) {
+    if (Trace) {
+      Trace->Source = Source;
+      Trace->TotalCycles = SHMStats::GetCycleCounter() - Trace->TotalCycles;
+      CompileTraceWriter->AddBlock(*Trace, Section ? &*Section : nullptr);
+    }
+  };
 
   static_cast<ContextImpl*>(Thread->CTX)->SyscallHandler->PreCompile();
 
@@ -857,10 +956,15 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
   // Is the code in the cache?
   // The backends only check L1 and L2, not L3
   if (auto HostCode = Thread->LookupCache->FindBlock(Thread, GuestRIP)) {
+    if (Trace) {
+      SubmitTrace(CompileTrace::BlockSource::LookupCache, SyscallHandler->LookupExecutableFileSection(Thread, GuestRIP));
+    }
     return HostCode;
   }
 
-  std::optional<ExecutableFileSectionInfo> Region = SyscallHandler->LookupExecutableFileSection(Thread, GuestRIP);
+  // Looked up once and shared by the disk cache, CompileCode and symbol registration below.
+  // Holding CodeInvalidationMutex keeps the section's file info alive until the block is done.
+  const std::optional<ExecutableFileSectionInfo> Region = SyscallHandler->LookupExecutableFileSection(Thread, GuestRIP);
   std::optional<DiskCache::CodeHitData> Hit;
   bool DiskCacheHitRelocationsApplied = false;
   bool LoadDiskCacheCode = true;
@@ -887,6 +991,11 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
             Thread->LookupCache->AddBlockMapping(Thread, GuestOffset + Region->FileStartVA, Hit->GuestPages, HostAddr);
           }
 
+          if (Trace) {
+            Trace->HostBytes = Hit->HostCode.size();
+            SubmitTrace(CompileTrace::BlockSource::DiskCache, Region);
+          }
+
           uint64_t ModuleOffset = GuestRIP - Region->FileStartVA;
           return reinterpret_cast<uintptr_t>(LoadedCode.EntryPoints[ModuleOffset]);
         }
@@ -897,12 +1006,13 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
   // Accumulate a JIT count now, as even if another thread raced us, it should count as a compile.
   FEXCORE_PROFILE_INSTANT_INCREMENT(Thread, AccumulatedJITCount, 1);
 
-  auto [CompiledCode, DebugData, StartAddr, Length, NeedsAddGuestCodeRanges] = CompileCode(Thread, GuestRIP, MaxInst);
+  auto [CompiledCode, DebugData, StartAddr, Length, NeedsAddGuestCodeRanges] = CompileCode(Thread, GuestRIP, MaxInst, Trace, &Region);
   auto CodePtr = CompiledCode.EntryPoints[GuestRIP];
   if (CodePtr == nullptr) {
     return 0;
   } else if (!DebugData) {
     // DebugData wasn't populated, indicating another thread raced us for compiling this block
+    SubmitTrace(CompileTrace::BlockSource::JIT, Region);
     return reinterpret_cast<uintptr_t>(CodePtr);
   }
 
@@ -913,37 +1023,50 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
   if (Config.BlockJITNaming()) {
     auto FragmentBasePtr = CompiledCode.BlockBegin;
 
-    auto GuestRIPLookup = SyscallHandler->LookupExecutableFileSection(Thread, GuestRIP);
-
     if (DebugData->Subblocks.size()) {
       for (auto& Subblock : DebugData->Subblocks) {
         auto BlockBasePtr = FragmentBasePtr + Subblock.HostCodeOffset;
-        if (GuestRIPLookup) {
-          Symbols.Register(Thread->SymbolBuffer.get(), BlockBasePtr, CompiledCode.Size, GuestRIPLookup->FileInfo.Filename,
-                           GuestRIP - GuestRIPLookup->FileStartVA);
+        if (Region) {
+          Symbols.Register(Thread->SymbolBuffer.get(), BlockBasePtr, CompiledCode.Size, Region->FileInfo.Filename,
+                           GuestRIP - Region->FileStartVA);
         } else {
           Symbols.Register(Thread->SymbolBuffer.get(), BlockBasePtr, GuestRIP, Subblock.HostCodeSize);
         }
       }
     } else {
-      if (GuestRIPLookup) {
-        Symbols.Register(Thread->SymbolBuffer.get(), FragmentBasePtr, CompiledCode.Size, GuestRIPLookup->FileInfo.Filename,
-                         GuestRIP - GuestRIPLookup->FileStartVA);
+      if (Region) {
+        Symbols.Register(Thread->SymbolBuffer.get(), FragmentBasePtr, CompiledCode.Size, Region->FileInfo.Filename,
+                         GuestRIP - Region->FileStartVA);
       } else {
         Symbols.Register(Thread->SymbolBuffer.get(), FragmentBasePtr, GuestRIP, CompiledCode.Size);
       }
     }
   }
 
+  if (Config.PerfJitDump()) {
+    auto FragmentBasePtr = CompiledCode.BlockBegin;
+    if (Region) {
+      auto Map = Region->FileInfo.SourcecodeMap.get();
+      auto FileOffset = GuestRIP - Region->FileStartVA;
+      auto Name = Map ? HLE::SourcecodeSymbolMapping::SymName(Map->FindSymbolMapping(FileOffset), Region->FileInfo.Filename,
+                                                               reinterpret_cast<uintptr_t>(FragmentBasePtr), FileOffset) :
+                        fextl::fmt::format("{}+0x{:x}", Region->FileInfo.Filename, FileOffset);
+      Symbols.RegisterJitDump(Thread->JitDumpBuffer.get(), FragmentBasePtr, CompiledCode.Size, GuestRIP, Name, *DebugData,
+                              Region->FileInfo.Filename, Region->FileStartVA, Map);
+    } else {
+      Symbols.RegisterJitDump(Thread->JitDumpBuffer.get(), FragmentBasePtr, CompiledCode.Size, GuestRIP,
+                              fextl::fmt::format("JIT_0x{:x}", GuestRIP), *DebugData, {}, 0, nullptr);
+    }
+  }
+
   if (Config.LibraryJITNaming() || Config.GDBSymbols()) {
-    auto MappedSection = SyscallHandler->LookupExecutableFileSection(Thread, GuestRIP);
-    if (MappedSection) {
+    if (Region) {
       if (Config.LibraryJITNaming()) {
-        Symbols.RegisterNamedRegion(Thread->SymbolBuffer.get(), CodePtr, DebugData->HostCodeSize, MappedSection->FileInfo.Filename);
+        Symbols.RegisterNamedRegion(Thread->SymbolBuffer.get(), CodePtr, DebugData->HostCodeSize, Region->FileInfo.Filename);
       }
 
       if (Config.GDBSymbols()) {
-        GDBJITRegister(MappedSection->FileInfo, MappedSection->FileStartVA, GuestRIP, (uintptr_t)CodePtr, *DebugData);
+        GDBJITRegister(Region->FileInfo, Region->FileStartVA, GuestRIP, (uintptr_t)CodePtr, *DebugData);
       }
     }
   }
@@ -978,6 +1101,10 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
     }
   }
 
+  if (Config.BlockStats()) {
+    BlockStats.AddBlock(GuestRIP, Length, CompiledCode.BlockBegin, *DebugData);
+  }
+
   // Insert to lookup cache
   for (auto [GuestAddr, HostAddr] : CompiledCode.EntryPoints) {
     Thread->LookupCache->AddBlockMapping(Thread, GuestAddr, CodePages, HostAddr);
@@ -988,6 +1115,8 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
     Thread->CPUBackend->ClearRelocations();
   }
 
+  SubmitTrace(CompileTrace::BlockSource::JIT, Region);
+
   return (uintptr_t)CodePtr;
 }
 
@@ -1153,6 +1282,56 @@ void ContextImpl::MonoBackpatcherWrite(FEXCore::Core::CpuStateFrame* Frame, uint
   CTX->SyscallHandler->InvalidateGuestCodeRange(Thread, Address, Size);
 }
 
+void ContextImpl::SpinWait(FEXCore::Core::CpuStateFrame* Frame, uint8_t Size, uint64_t Address, uint64_t Observed) {
+  // Backoff starts at a wait short enough not to delay lock handover, and tops out around the event stream period.
+  constexpr auto MIN_WAIT = std::chrono::microseconds(1);
+  constexpr uint32_t MAX_LEVEL = 8;
+  // A loop that took longer than this to come back around was doing something other than spinning
+  constexpr auto BACKOFF_RESET = std::chrono::microseconds(500);
+  constexpr auto FUTEX_WAIT_TIMEOUT = std::chrono::milliseconds(1);
+
+  auto Thread = Frame->Thread;
+  auto CTX = static_cast<ContextImpl*>(Thread->CTX);
+  auto& Backoff = Thread->SpinWait;
+  FEXCORE_PROFILE_ACCUMULATION(Thread, AccumulatedSpinWaitTime);
+
+  const auto Begin = std::chrono::steady_clock::now().time_since_epoch();
+  if (Backoff.Address != Address || Begin - std::chrono::nanoseconds(Backoff.LastWaitEnd) > BACKOFF_RESET) {
+    Backoff.Address = Address;
+    Backoff.Level = 0;
+  }
+
+  // Watch the naturally aligned word containing the polled location. Unaligned accesses crossing into the next
+  // word only have their first part watched, which can only make the wait return early.
+  auto Word = reinterpret_cast<uint64_t*>(Address & ~7ULL);
+  const uint64_t Shift = (Address & 7) * 8;
+  const uint64_t Mask = (Size == 8 ? ~0ULL : (1ULL << (Size * 8)) - 1) << Shift;
+  // Observed is what the loop compared, so a location that changed since then doesn't wait at all
+  const uint64_t Expected = (Observed << Shift) & Mask;
+
+  bool Changed = Utils::SpinWaitLock::WaitForChange(Word, Mask, Expected, MIN_WAIT * (1U << Backoff.Level), CTX->HostFeatures.SupportsWFXT);
+
+#ifndef _WIN32
+  if (!Changed && Backoff.Level == MAX_LEVEL && CTX->Config.SpinWaitFutex) {
+    // Guest stores releasing the lock don't wake the futex, so this is only ever a bounded sleep that gives the core up to
+    // other threads. The kernel rechecks the 32-bit futex word before sleeping.
+    auto FutexWord = reinterpret_cast<uint32_t*>(Address & ~3ULL);
+    const uint32_t FutexValue = std::atomic_ref<uint32_t>(*FutexWord).load();
+    if ((std::atomic_ref<uint64_t>(*Word).load() & Mask) == Expected) {
+      const struct timespec Timeout {
+        .tv_sec = 0,
+        .tv_nsec = std::chrono::nanoseconds(FUTEX_WAIT_TIMEOUT).count(),
+      };
+      ::syscall(SYS_futex, FutexWord, FUTEX_WAIT | FUTEX_PRIVATE_FLAG, FutexValue, &Timeout, nullptr, 0);
+    }
+    Changed = (std::atomic_ref<uint64_t>(*Word).load() & Mask) != Expected;
+  }
+#endif
+
+  Backoff.Level = Changed ? 0 : std::min(Backoff.Level + 1, MAX_LEVEL);
+  Backoff.LastWaitEnd = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void ContextImpl::ConfigureAOTGen(FEXCore::Core::InternalThreadState* Thread, fextl::set<uint64_t>* ExternalBranches, uint64_t SectionMaxAddress) {
   Thread->FrontendDecoder->SetExternalBranches(ExternalBranches);
 }
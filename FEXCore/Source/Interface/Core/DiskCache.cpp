@@ -3,10 +3,13 @@
 #include "FEXHeaderUtils/Filesystem.h"
 #include "FEXCore/Core/DiskCache.h"
 #include "FEXCore/Utils/LogManager.h"
+#include "FEXCore/Utils/SHMStats.h"
+#include "FEXCore/Debug/InternalThreadState.h"
 #include "Interface/Context/Context.h"
 #include "FEXCore/HLE/SyscallHandler.h"
 #include "FEXCore/Utils/File.h"
 #include "FEXCore/fextl/memory.h"
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 
@@ -104,46 +107,40 @@ namespace DiskCache {
     return true;
   }
 
-  bool FOZFile::WriteBlob(const MesaFOZ::foz_payload_key& Key, std::span<const std::span<const uint8_t>> BlobChunks, uint64_t& OutBlobOffset) {
+  bool FOZFile::WriteBlobs(std::span<const BlobWrite> Blobs, fextl::vector<uint64_t>& OutBlobOffsets) {
     ssize_t FileSize = FD->Size();
     if (FileSize < 0) {
       return false;
     }
     uint64_t WriteOffset = (uint64_t)FileSize;
-
-    if (FD->PWrite(Key.bytes, sizeof(Key.bytes), WriteOffset) != sizeof(Key.bytes)) {
-      return false;
-    }
-    WriteOffset += sizeof(Key.bytes);
-
-    uint64_t TotalBlobSize = 0;
-    for (const std::span<const uint8_t>& Chunk : BlobChunks) {
-      TotalBlobSize += Chunk.size();
-    }
-
-    MesaFOZ::foz_payload_header ScratchHeader {.payload_size = (uint32_t)TotalBlobSize,
-                                               .format = MesaFOZ::FOSSILIZE_COMPRESSION_NONE,
-                                               .crc = 0, // todo? maybe
-                                               .uncompressed_size = (uint32_t)TotalBlobSize};
-
-    if (FD->PWrite(&ScratchHeader, sizeof(ScratchHeader), WriteOffset) != sizeof(ScratchHeader)) {
-      return false;
-    }
-    WriteOffset += sizeof(ScratchHeader);
-
-    OutBlobOffset = WriteOffset;
-
-    for (const std::span<const uint8_t>& Chunk : BlobChunks) {
-      if (Chunk.size() == 0) {
-        continue;
+    const uint64_t StartOffset = WriteOffset;
+
+    // headers need stable storage until the write is done
+    fextl::vector<MesaFOZ::foz_payload_header> Headers;
+    Headers.reserve(Blobs.size());
+    fextl::vector<std::span<const uint8_t>> Chunks;
+    Chunks.reserve(Blobs.size() * 3);
+    OutBlobOffsets.clear();
+    OutBlobOffsets.reserve(Blobs.size());
+
+    for (const auto& Blob : Blobs) {
+      Headers.push_back({.payload_size = (uint32_t)Blob.Data.size(),
+                         .format = MesaFOZ::FOSSILIZE_COMPRESSION_NONE,
+                         .crc = 0, // todo? maybe
+                         .uncompressed_size = (uint32_t)Blob.Data.size()});
+
+      Chunks.push_back({Blob.Key->bytes, sizeof(Blob.Key->bytes)});
+      Chunks.push_back({reinterpret_cast<const uint8_t*>(&Headers.back()), sizeof(MesaFOZ::foz_payload_header)});
+      WriteOffset += sizeof(Blob.Key->bytes) + sizeof(MesaFOZ::foz_payload_header);
+
+      OutBlobOffsets.push_back(WriteOffset);
+      if (!Blob.Data.empty()) {
+        Chunks.push_back(Blob.Data);
+        WriteOffset += Blob.Data.size();
       }
-      if (FD->PWrite(Chunk.data(), Chunk.size(), WriteOffset) != (ssize_t)Chunk.size()) {
-        return false;
-      }
-      WriteOffset += Chunk.size();
     }
 
-    return true;
+    return FD->PWriteV(Chunks, StartOffset) == (ssize_t)(WriteOffset - StartOffset);
   }
 
   bool IndexedDB::Open(const fextl::string& CacheDBName, bool ReadOnly) {
@@ -201,43 +198,62 @@ namespace DiskCache {
     return CacheFOZ.ReadBlob(Offset, OutBlob);
   }
 
-  bool IndexedDB::StoreCacheBlob(const MesaFOZ::foz_payload_key& Key, std::span<const uint8_t> Blob, Index& Index, std::mutex& IndexMutex) {
+  bool IndexedDB::StoreCacheBlobs(std::span<const PendingStore> Stores, Index& Index, std::mutex& IndexMutex) {
     if (ReadOnly) {
       // shouldn't happen
       return false;
     }
-    uint64_t Hash = XXH3_64bits(Key.bytes, FOSSILIZE_BLOB_HASH_LENGTH);
+
+    fextl::vector<FOZFile::BlobWrite> CacheWrites;
+    fextl::vector<uint64_t> Hashes;
+    fextl::unordered_set<uint64_t> BatchHashes;
+    CacheWrites.reserve(Stores.size());
+    Hashes.reserve(Stores.size());
     {
       std::lock_guard Guard(IndexMutex);
-      if (Index.contains(Hash)) {
-        // shouldn't really happen.. assert or something?
-        return true;
+      for (const auto& Store : Stores) {
+        uint64_t Hash = XXH3_64bits(Store.Key.bytes, FOSSILIZE_BLOB_HASH_LENGTH);
+        if (Index.contains(Hash) || !BatchHashes.insert(Hash).second) {
+          // two threads compiled the same block, only keep the first
+          continue;
+        }
+        CacheWrites.push_back({&Store.Key, Store.Blob});
+        Hashes.push_back(Hash);
       }
     }
 
+    if (CacheWrites.empty()) {
+      return true;
+    }
+
     if (!CacheFOZ.Lock(STORE_LOCK_TIMEOUT_MS) || !IndexFOZ.Lock(STORE_LOCK_TIMEOUT_MS)) {
       CacheFOZ.Unlock();
       IndexFOZ.Unlock();
       return false;
     }
 
-    // write cache side first so we get offset for index
-    std::span<const uint8_t> BlobChunks[] = {Blob};
-    uint64_t BlobOffset = 0;
-    if (!CacheFOZ.WriteBlob(Key, BlobChunks, BlobOffset)) {
+    // write cache side first so we get offsets for index
+    fextl::vector<uint64_t> BlobOffsets;
+    if (!CacheFOZ.WriteBlobs(CacheWrites, BlobOffsets)) {
       CacheFOZ.Unlock();
       IndexFOZ.Unlock();
       return false;
     }
 
-    MesaFOZ::mesa_index_db_file_entry IndexEntry {.hash = Hash,
-                                                  .size = (uint32_t)Blob.size(),
-                                                  .last_access_time = 0, // todo..
-                                                  .cache_db_file_offset = BlobOffset};
+    fextl::vector<MesaFOZ::mesa_index_db_file_entry> IndexEntries;
+    fextl::vector<FOZFile::BlobWrite> IndexWrites;
+    IndexEntries.reserve(CacheWrites.size());
+    IndexWrites.reserve(CacheWrites.size());
+    for (size_t i = 0; i < CacheWrites.size(); ++i) {
+      IndexEntries.push_back({.hash = Hashes[i],
+                              .size = (uint32_t)CacheWrites[i].Data.size(),
+                              .last_access_time = 0, // todo..
+                              .cache_db_file_offset = BlobOffsets[i]});
+      IndexWrites.push_back({CacheWrites[i].Key, {reinterpret_cast<const uint8_t*>(&IndexEntries.back()), sizeof(MesaFOZ::mesa_index_db_file_entry)}});
+    }
 
-    std::span<const uint8_t> IndexBlobChunks[] = {{(const uint8_t*)&IndexEntry, sizeof(IndexEntry)}};
-    uint64_t UnusedIndexBlobOffset = 0;
-    if (!IndexFOZ.WriteBlob(Key, IndexBlobChunks, UnusedIndexBlobOffset)) {
+    fextl::vector<uint64_t> UnusedIndexBlobOffsets;
+    if (!IndexFOZ.WriteBlobs(IndexWrites, UnusedIndexBlobOffsets)) {
       CacheFOZ.Unlock();
       IndexFOZ.Unlock();
       return false;
@@ -247,7 +263,9 @@ namespace DiskCache {
     IndexFOZ.Unlock();
 
     std::lock_guard Guard(IndexMutex);
-    Index[Hash] = {this, BlobOffset, (uint32_t)Blob.size()};
+    for (size_t i = 0; i < CacheWrites.size(); ++i) {
+      Index[Hashes[i]] = {this, BlobOffsets[i], (uint32_t)CacheWrites[i].Data.size()};
+    }
     return true;
   }
 
@@ -432,21 +450,28 @@ namespace DiskCache {
     return Reloc.Header.Offset >= CompiledCode.HostCodeOffset && Reloc.Header.Offset < CompiledCode.HostCodeOffset + CompiledCode.Size;
   }
 
-  struct DiskCache::CacheStoreWorkItem final : WorkQueueThread::WorkItem {
+  struct DiskCache::CacheFlushWorkItem final : WorkQueueThread::WorkItem {
     DiskCache* Self;
-    IndexedDB* DB;
-    MesaFOZ::foz_payload_key Key;
-    fextl::vector<uint8_t> Blob;
-    CacheStoreWorkItem(DiskCache* Self, IndexedDB* DB, const MesaFOZ::foz_payload_key& Key, fextl::vector<uint8_t>&& Blob)
-      : Self(Self)
-      , DB(DB)
-      , Key(Key)
-      , Blob(std::move(Blob)) {}
+    CacheFlushWorkItem(DiskCache* Self)
+      : Self(Self) {}
     void Run() override {
-      DB->StoreCacheBlob(Key, Blob, Self->Index, Self->IndexLock);
+      Self->FlushPendingStores();
     }
   };
 
+  void DiskCache::FlushPendingStores() {
+    // take everything that piled up since the last flush and commit it as one group
+    fextl::vector<PendingStore> Batch;
+    {
+      std::lock_guard lk {PendingLock};
+      Batch.swap(PendingStores);
+      PendingBytes = 0;
+    }
+    PendingDrained.notify_all();
+
+    RWCacheDB->StoreCacheBlobs(Batch, Index, IndexLock);
+  }
+
   bool DiskCache::Store(Core::InternalThreadState* Thread, const ExecutableFileSectionInfo& Region, uint64_t GuestRIP,
                         std::span<const uint8_t> GuestCode, const CPU::CPUBackend::CompiledCode& CompiledCode,
                         std::span<const FEXCore::CPU::Relocation> Relocations, const Frontend::Decoder::DecodedBlockInformation* DecodedBlockInfo) {
@@ -598,7 +623,33 @@ namespace DiskCache {
     memcpy(BlobData + GuestCodeOffset, GuestCode.data(), GuestCode.size());
 
     // hand the rest off to the writer thread
-    Writer->QueueWork(fextl::make_unique<CacheStoreWorkItem>(this, RWCacheDB.get(), Key, std::move(Blob)));
+    const size_t BlobSize = Blob.size();
+    size_t QueueLength {};
+    bool NeedsFlush {};
+    {
+      std::unique_lock lk {PendingLock};
+      auto HasRoom = [this] {
+        return PendingBytes < MAX_PENDING_BYTES && PendingStores.size() < MAX_PENDING_STORES;
+      };
+      if (!HasRoom() && !PendingDrained.wait_for(lk, std::chrono::milliseconds(BACKPRESSURE_TIMEOUT_MS), HasRoom)) {
+        return false;
+      }
+
+      // only the first store of a batch needs to kick the writer, the rest ride along
+      NeedsFlush = PendingStores.empty();
+      PendingStores.push_back({Key, std::move(Blob)});
+      PendingBytes += BlobSize;
+      QueueLength = PendingStores.size();
+    }
+
+    if (NeedsFlush) {
+      Writer->QueueWork(fextl::make_unique<CacheFlushWorkItem>(this));
+    }
+
+    if (Thread->ThreadStats) {
+      Thread->ThreadStats->DiskCacheQueueLength = QueueLength;
+      Thread->ThreadStats->AccumulatedDiskCacheWriteBytes += BlobSize;
+    }
     return true;
   }
 
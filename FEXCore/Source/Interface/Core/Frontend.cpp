@@ -20,6 +20,7 @@ $end_info$
 #include <FEXCore/Utils/Allocator.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/SHMStats.h>
 #include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/Utils/TypeDefines.h>
 #include <FEXCore/Debug/InternalThreadState.h>
@@ -1301,6 +1302,270 @@ bool Decoder::InstCanContinue() const {
   return false;
 }
 
+namespace {
+// How an instruction takes part in a spin-wait loop, see Decoder::DetectSpinWaitLoops
+struct SpinLoopInst {
+  bool Allowed {};
+  bool IsJump {};
+  bool IsUnconditionalJump {};
+  bool IsPause {};
+  bool IsCmpXchg {};
+  // Sets the written GPR to a value that doesn't come from memory
+  bool IsConstantMove {};
+  uint32_t WrittenGPRs {};
+  // Only ever read, with the exception of LOCK CMPXCHG
+  const DecodedOperand* Memory {};
+};
+} // namespace
+
+static bool IsMemoryOperand(const DecodedOperand& Operand) {
+  return Operand.IsGPRDirect() || Operand.IsGPRIndirect() || Operand.IsRIPRelative() || Operand.IsSIB();
+}
+
+static SpinLoopInst ClassifySpinLoopInst(const DecodedInst& Inst) {
+  const auto Info = Inst.TableInfo;
+  const auto IsBaseOp = [Info](uint8_t First, uint8_t Last) {
+    return Info >= &BaseOps[First] && Info <= &BaseOps[Last];
+  };
+  const auto IsSecondOp = [Info](uint8_t First, uint8_t Last) {
+    return Info >= &SecondBaseOps[First] && Info <= &SecondBaseOps[Last];
+  };
+  const auto IsGroupOp = [Info](InstType Group, uint8_t Op, uint8_t FirstReg, uint8_t LastReg) {
+    const auto Base = ((Group - TYPE_GROUP_1) << 6) | (OpToIndex(Op) << 3);
+    return Info >= &PrimaryInstGroupOps[Base | FirstReg] && Info <= &PrimaryInstGroupOps[Base | LastReg];
+  };
+  const auto IsGPR = [](const DecodedOperand& Operand) {
+    return Operand.IsGPR() && Operand.Data.GPR.GPR <= FEXCore::X86State::REG_R15;
+  };
+
+  const DecodedOperand* Memory {};
+  for (const auto* Operand : {&Inst.Dest, &Inst.Src[0], &Inst.Src[1]}) {
+    if (IsMemoryOperand(*Operand)) {
+      Memory = Operand;
+    } else if (!Operand->IsNone() && !IsGPR(*Operand) && !Operand->IsLiteral()) {
+      // Relocated operands only show up when generating code caches
+      return {};
+    }
+  }
+
+  if (IsBaseOp(0x70, 0x7F) || IsSecondOp(0x80, 0x8F)) {
+    return {.Allowed = true, .IsJump = true};
+  }
+
+  if (IsBaseOp(0xE9, 0xE9) || IsBaseOp(0xEB, 0xEB)) {
+    return {.Allowed = true, .IsJump = true, .IsUnconditionalJump = true};
+  }
+
+  if (IsBaseOp(0x90, 0x90)) {
+    // Only NOP and PAUSE, XCHG with anything other than RAX writes registers
+    const bool IsNOP = IsGPR(Inst.Dest) && Inst.Dest.Data.GPR.GPR == FEXCore::X86State::REG_RAX && IsGPR(Inst.Src[0]) &&
+                       Inst.Src[0].Data.GPR.GPR == FEXCore::X86State::REG_RAX;
+    return {.Allowed = IsNOP, .IsPause = IsNOP && (Inst.Flags & DecodeFlags::FLAG_REP_PREFIX) != 0};
+  }
+
+  if (IsBaseOp(0x38, 0x3D) || IsBaseOp(0x84, 0x85) || IsBaseOp(0xA8, 0xA9) || IsGroupOp(TYPE_GROUP_1, 0x80, 7, 7) ||
+      IsGroupOp(TYPE_GROUP_1, 0x81, 7, 7) || IsGroupOp(TYPE_GROUP_1, 0x83, 7, 7) || IsGroupOp(TYPE_GROUP_3, 0xF6, 0, 1) ||
+      IsGroupOp(TYPE_GROUP_3, 0xF7, 0, 1)) {
+    // CMP and TEST
+    return {.Allowed = true, .Memory = Memory};
+  }
+
+  if (!IsGPR(Inst.Dest)) {
+    if (IsSecondOp(0xB0, 0xB1) && (Inst.Flags & DecodeFlags::FLAG_LOCK)) {
+      return {.Allowed = true, .IsCmpXchg = true, .WrittenGPRs = 1U << FEXCore::X86State::REG_RAX, .Memory = Memory};
+    }
+
+    // Everything else that writes memory is doing more than polling it
+    return {};
+  }
+
+  const uint32_t WrittenGPRs = 1U << Inst.Dest.Data.GPR.GPR;
+  if (IsBaseOp(0x88, 0x8B) || IsSecondOp(0xB6, 0xB7)) {
+    // MOV and MOVZX to a register
+    return {.Allowed = true, .WrittenGPRs = WrittenGPRs, .Memory = Memory};
+  }
+
+  if (IsBaseOp(0xB0, 0xBF)) {
+    // MOV immediate
+    return {.Allowed = true, .IsConstantMove = true, .WrittenGPRs = WrittenGPRs};
+  }
+
+  if ((IsBaseOp(0x31, 0x31) || IsBaseOp(0x33, 0x33)) && IsGPR(Inst.Src[0]) && Inst.Src[0].Data.GPR.GPR == Inst.Dest.Data.GPR.GPR) {
+    // Zeroing XOR
+    return {.Allowed = true, .IsConstantMove = true, .WrittenGPRs = WrittenGPRs};
+  }
+
+  return {};
+}
+
+static uint32_t GetAddressGPRs(const DecodedOperand& Operand) {
+  if (Operand.IsGPRDirect()) {
+    return 1U << Operand.Data.GPR.GPR;
+  } else if (Operand.IsGPRIndirect()) {
+    return 1U << Operand.Data.GPRIndirect.GPR;
+  } else if (Operand.IsSIB()) {
+    uint32_t GPRs {};
+    if (Operand.Data.SIB.Base != 0xFF) {
+      GPRs |= 1U << Operand.Data.SIB.Base;
+    }
+    if (Operand.Data.SIB.Index != 0xFF) {
+      GPRs |= 1U << Operand.Data.SIB.Index;
+    }
+    return GPRs;
+  }
+  return 0;
+}
+
+static bool IsSameAddress(const DecodedInst& LHSInst, const DecodedOperand& LHS, const DecodedInst& RHSInst, const DecodedOperand& RHS,
+                          bool Is64BitMode) {
+  constexpr uint32_t AddressFlags = DecodeFlags::FLAG_SEGMENTS | DecodeFlags::FLAG_ADDRESS_SIZE;
+  if (LHS.Type != RHS.Type || (LHSInst.Flags & AddressFlags) != (RHSInst.Flags & AddressFlags)) {
+    return false;
+  }
+
+  if (LHS.IsGPRDirect()) {
+    return LHS.Data.GPR.GPR == RHS.Data.GPR.GPR;
+  } else if (LHS.IsGPRIndirect()) {
+    return LHS.Data.GPRIndirect.GPR == RHS.Data.GPRIndirect.GPR && LHS.Data.GPRIndirect.Displacement == RHS.Data.GPRIndirect.Displacement;
+  } else if (LHS.IsSIB()) {
+    return LHS.Data.SIB.Offset == RHS.Data.SIB.Offset && LHS.Data.SIB.Scale == RHS.Data.SIB.Scale &&
+           LHS.Data.SIB.Index == RHS.Data.SIB.Index && LHS.Data.SIB.Base == RHS.Data.SIB.Base;
+  } else if (LHS.IsRIPRelative()) {
+    // 64-bit is RIP relative, while 32-bit is absolute.
+    const auto Address = [Is64BitMode](const DecodedInst& Inst, const DecodedOperand& Operand) {
+      return (Is64BitMode ? Inst.PC + Inst.InstSize : 0) + Operand.Data.RIPLiteral.Value;
+    };
+    return Address(LHSInst, LHS) == Address(RHSInst, RHS);
+  }
+  return false;
+}
+
+void Decoder::DetectSpinWaitLoops() {
+  // Anything longer does real work between polls
+  constexpr uint64_t MAX_SPIN_LOOP_INSTRUCTIONS = 8;
+
+  auto& Blocks = BlockInfo.Blocks;
+  for (auto BlockIt = Blocks.begin(); BlockIt != Blocks.end(); ++BlockIt) {
+    if (BlockIt->NumInstructions == 0 || BlockIt->BlockStatus != DecodedBlockStatus::SUCCESS) {
+      continue;
+    }
+
+    const auto& Branch = BlockIt->DecodedInstructions[BlockIt->NumInstructions - 1];
+    if (!ClassifySpinLoopInst(Branch).IsJump) {
+      continue;
+    }
+
+    uint64_t Target = Branch.PC + Branch.InstSize + Branch.Src[0].Literal();
+    if (GetGPROpSize() == IR::OpSize::i32Bit) {
+      Target &= 0xFFFFFFFFU;
+    }
+
+    if (Target > Branch.PC) {
+      continue;
+    }
+
+    // The loop must consist of the contiguous blocks from its entry up to the back-edge
+    auto LoopIt = std::lower_bound(Blocks.begin(), BlockIt, Target, [](const auto& a, uint64_t Address) { return a.Entry < Address; });
+    if (LoopIt->Entry != Target) {
+      continue;
+    }
+
+    uint64_t NumInstructions {};
+    uint64_t NextEntry = Target;
+    for (auto It = LoopIt; It <= BlockIt && NumInstructions <= MAX_SPIN_LOOP_INSTRUCTIONS; ++It) {
+      if (It->Entry != NextEntry || It->BlockStatus != DecodedBlockStatus::SUCCESS) {
+        NumInstructions = ~0ULL;
+        break;
+      }
+      NextEntry += It->Size;
+      NumInstructions += It->NumInstructions;
+    }
+
+    if (NumInstructions > MAX_SPIN_LOOP_INSTRUCTIONS) {
+      continue;
+    }
+
+    bool Valid = true;
+    bool Waits = false;
+    bool ConstantRAX = false;
+    uint32_t WrittenGPRs {};
+    const DecodedInst* MemoryInst {};
+    const DecodedOperand* Memory {};
+    bool MemoryInBackEdgeBlock = false;
+    uint8_t ValueGPR = FEXCore::X86State::REG_INVALID;
+    bool ValueHighBits = false;
+
+    for (auto It = LoopIt; It <= BlockIt && Valid; ++It) {
+      for (size_t i = 0; i < It->NumInstructions && Valid; ++i) {
+        const auto& Inst = It->DecodedInstructions[i];
+        const auto Info = ClassifySpinLoopInst(Inst);
+        const bool IsBackEdge = &Inst == &Branch;
+
+        // Conditional branches may leave the loop, but an unconditional one can only be the back-edge
+        Valid = Info.Allowed && (!Info.IsUnconditionalJump || IsBackEdge);
+        if (!Valid) {
+          break;
+        }
+
+        if (Info.IsCmpXchg) {
+          // CMPXCHG loops that retry with the value they just loaded are updating memory rather than waiting on a lock,
+          // and will succeed on their next attempt
+          Valid = ConstantRAX;
+          Waits = true;
+        }
+        Waits |= Info.IsPause;
+
+        if (Info.WrittenGPRs & (1U << FEXCore::X86State::REG_RAX)) {
+          ConstantRAX = Info.IsConstantMove;
+        }
+        WrittenGPRs |= Info.WrittenGPRs;
+
+        if (ValueGPR != FEXCore::X86State::REG_INVALID && (Info.WrittenGPRs & (1U << ValueGPR))) {
+          ValueGPR = FEXCore::X86State::REG_INVALID;
+        }
+
+        if (Info.Memory) {
+          // Polling more than one location
+          Valid = !Memory || IsSameAddress(*MemoryInst, *Memory, Inst, *Info.Memory, BlockInfo.Is64BitMode);
+
+          // The wait compares against the value of the last poll before the back-edge
+          MemoryInst = &Inst;
+          Memory = Info.Memory;
+          MemoryInBackEdgeBlock = It == BlockIt;
+          if (Info.IsCmpXchg) {
+            ValueGPR = FEXCore::X86State::REG_RAX;
+            ValueHighBits = false;
+          } else if (Info.WrittenGPRs) {
+            ValueGPR = Inst.Dest.Data.GPR.GPR;
+            ValueHighBits = Inst.Dest.Data.GPR.HighBits;
+          } else {
+            ValueGPR = FEXCore::X86State::REG_INVALID;
+          }
+        }
+      }
+    }
+
+    // The address must stay the same across iterations for the wait to watch the right memory
+    if (!Valid || !Waits || !Memory || (GetAddressGPRs(*Memory) & WrittenGPRs)) {
+      continue;
+    }
+
+    // Otherwise the compared value is only seen by the polling instruction, which needs to be in the same block as the back-edge
+    if (ValueGPR == FEXCore::X86State::REG_INVALID && !MemoryInBackEdgeBlock) {
+      continue;
+    }
+
+    BlockIt->SpinWait = {
+      .Inst = MemoryInst,
+      .Operand = Memory,
+      .LoopEntry = Target,
+      .ValueGPR = ValueGPR,
+      .ValueHighBits = ValueHighBits,
+    };
+    FEXCORE_PROFILE_INSTANT_INCREMENT(Thread, AccumulatedSpinLoopCount, 1);
+  }
+}
+
 void Decoder::AddBranchTarget(uint64_t Target) {
   if (VisitedBlocks.contains(Target)) {
     return;
@@ -1585,6 +1850,10 @@ void Decoder::DecodeInstructionsAtEntry(FEXCore::Core::InternalThreadState* Thre
   for (auto& Block : BlockInfo.Blocks) {
     Block.IsEntryPoint = BlockInfo.EntryPoints.contains(Block.Entry);
   }
+
+  if (CTX->Config.SpinWaitLoops) {
+    DetectSpinWaitLoops();
+  }
 }
 
 } // namespace FEXCore::Frontend
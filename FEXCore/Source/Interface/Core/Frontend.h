@@ -35,6 +35,18 @@ public:
     UNIMPLEMENTED_INST,
   };
 
+  // The memory operand a spin-wait loop polls, see DetectSpinWaitLoops
+  struct SpinWaitAccess final {
+    const FEXCore::X86Tables::DecodedInst* Inst {};
+    const FEXCore::X86Tables::DecodedOperand* Operand {};
+    // Entry of the loop that the branch ending this block jumps back to
+    uint64_t LoopEntry {};
+    // GPR still holding the value the loop last compared at the back-edge, like the destination of a MOV or RAX after
+    // a failed CMPXCHG. REG_INVALID when only the polling instruction sees the value, which is then in this block.
+    uint8_t ValueGPR {FEXCore::X86State::REG_INVALID};
+    bool ValueHighBits {};
+  };
+
   // New Frontend decoding
   struct DecodedBlocks final {
     uint64_t Entry {};
@@ -44,6 +56,7 @@ public:
     DecodedBlockStatus BlockStatus;
     bool IsEntryPoint {};
     bool ForceFullSMCDetection {};
+    SpinWaitAccess SpinWait {};
   };
 
   struct DecodedBlockInformation final {
@@ -99,6 +112,7 @@ private:
   void BranchTargetInMultiblockRange();
   bool IsBranchMonoTailcall(uint64_t NumInstructions) const;
   bool InstCanContinue() const;
+  void DetectSpinWaitLoops();
 
   void AddBranchTarget(uint64_t Target);
 
@@ -157,6 +157,9 @@ DEF_OP(ExitFunction) {
       //    10: HostCode                                           - MODIFIED 1st
       //    18: GuestRIP
       //    20: CallerOffset
+      //
+      // With CodeCachePositionIndependent, the shared exit linker is loaded from CpuStateFrame::Pointers instead of a literal,
+      // and GuestRIP may be encoded relative to the module table of a code cache (see DecodeGuestRIPLiteral).
 
       ARMEmitter::ForwardLabel l_BranchHost;
       ARMEmitter::ForwardLabel l_CallReturn;
@@ -278,6 +281,76 @@ DEF_OP(CondJump) {
 
 DEF_OP(Syscall) {
   auto Op = IROp->C<IR::IROp_Syscall>();
+
+  ARMEmitter::ForwardLabel SyscallHandlerPath;
+  ARMEmitter::ForwardLabel Done;
+
+#ifdef ARCHITECTURE_arm64
+  if (Op->HostSyscallNumber != -1) {
+    // The frontend can force every syscall through the handler, like while seccomp filters are installed.
+    ldr(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, ForceSyscallHandler));
+    cbnz_OrRestart(ARMEmitter::Size::i32Bit, TMP1, &SyscallHandlerPath);
+
+    // Passthrough syscall, do it inline.
+    // The argument setup below clobbers x0-x5 and x8, and the kernel discards SVE state on syscall,
+    // so dynamic registers are saved the same as the handler path, at full Z width on SVE256 hosts.
+    PushDynamicRegs(TMP1);
+
+    // Only the static registers overlapping with the syscall arguments and x8 need to be spilled.
+    // The upper halves of AVX registers need to be spilled as well.
+    const uint32_t GPRSpillMask = (1U << 9) - 1;
+    const bool SpillFPRs = CTX->HostFeatures.SupportsAVX && CTX->HostFeatures.SupportsSVE256;
+
+    // Ordering is important here, same as ProcessorID.
+    // Spill the overlapping registers first THEN claim we are in a syscall, so a signal can reconstruct the state.
+    // NZCV is preserved by the kernel.
+    SpillStaticRegs(TMP1, {
+                            .GPRSpillMask = GPRSpillMask,
+                            .FPRSpillMask = SpillFPRs ? ~0U : 0,
+                            .FPRs = SpillFPRs,
+                            .NZCV = false,
+                          });
+
+    LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, GPRSpillMask & 0xFFFF);
+    str(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, InSyscallInfo));
+
+    // Arguments can live in the registers they need to be moved to, bounce them through the stack.
+    const uint64_t SPOffset = AlignUp(6 * 8, 16);
+    sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, SPOffset);
+    for (uint32_t i = 0; i < 6; ++i) {
+      const auto& Arg = Op->Header.Args[i + 1];
+      str(Arg.IsInvalid() ? ARMEmitter::XReg::zr : GetReg(Arg).X(), ARMEmitter::Reg::rsp, i * 8);
+    }
+    ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x0, ARMEmitter::XReg::x1, ARMEmitter::Reg::rsp, 0);
+    ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x2, ARMEmitter::XReg::x3, ARMEmitter::Reg::rsp, 16);
+    ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x4, ARMEmitter::XReg::x5, ARMEmitter::Reg::rsp, 32);
+    add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, SPOffset);
+
+    LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r8, Op->HostSyscallNumber);
+    svc(0);
+    // On updated signal mask we can receive a signal RIGHT HERE
+
+    FillStaticRegs({
+      .OptionalReg = ARMEmitter::Reg::r1,
+      .OptionalReg2 = ARMEmitter::Reg::r2,
+      .GPRFillMask = GPRSpillMask,
+      .FPRFillMask = SpillFPRs ? ~0U : 0,
+      // Also restores the predicate registers the kernel zeroed
+      .FPRs = CTX->HostFeatures.SupportsSVE(),
+      .NZCV = false,
+    });
+
+    str(ARMEmitter::XReg::zr, STATE, offsetof(FEXCore::Core::CpuStateFrame, InSyscallInfo));
+
+    PopDynamicRegs();
+
+    mov(ARMEmitter::Size::i64Bit, GetReg(Node), ARMEmitter::Reg::r0);
+    b_OrRestart(&Done);
+  }
+#endif
+
+  BindOrRestart(&SyscallHandlerPath);
+
   // Arguments are passed as follows:
   // X0: SyscallHandler
   // X1: ThreadState
@@ -345,6 +418,8 @@ DEF_OP(Syscall) {
     // Only if `NORETURNEDRESULT` wasn't set, otherwise we might overwrite the CPUState refilled with `FillStaticRegs`
     mov(ARMEmitter::Size::i64Bit, GetReg(Node), ARMEmitter::Reg::r0);
   }
+
+  BindOrRestart(&Done);
 }
 
 DEF_OP(Thunk) {
@@ -28,6 +28,10 @@ struct DebugDataGuestOpcode {
  */
 struct DebugData : public FEXCore::Allocator::FEXAllocOperators {
   uint64_t HostCodeSize; ///< The size of the code generated in the host JIT
+  uint32_t HostInstructions {};       ///< Number of host instructions, excluding block header and tail data
+  uint32_t GuestInstructions {};      ///< Number of guest instructions in the block
+  uint32_t FallbackCalls {};          ///< Number of IR ops lowered to interpreter fallback calls
+  uint32_t ExecutionCounterOffset {}; ///< Offset of the BlockStats execution counter from the block start, 0 if not emitted
   fextl::vector<DebugDataSubblock> Subblocks;
   fextl::vector<DebugDataGuestOpcode> GuestOpcodes;
   fextl::vector<FEXCore::CPU::Relocation>* Relocations;
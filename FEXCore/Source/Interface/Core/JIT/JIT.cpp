@@ -86,6 +86,8 @@ void Arm64JITCore::Op_Unhandled(const IR::IROp_Header* IROp, IR::Ref Node) {
     LOGMAN_MSG_A_FMT("Unhandled IR Op: {}", FEXCore::IR::GetName(IROp->Op));
 #endif
   } else {
+    ++DebugData->FallbackCalls;
+
     auto FillF80x2Result = [&](auto DstLo, auto DstHi) {
       mov(DstLo.Q(), VTMP1.Q());
       mov(DstHi.Q(), VTMP2.Q());
@@ -532,7 +534,7 @@ uint64_t Arm64JITCore::ExitFunctionLink(FEXCore::Core::CpuStateFrame* Frame, FEX
   auto Thread = Frame->Thread;
   bool TFSet = Thread->CurrentFrame->State.flags[X86State::RFLAG_TF_RAW_LOC];
   uintptr_t HostCode {};
-  auto GuestRip = Record->GuestRIP;
+  auto GuestRip = DecodeGuestRIPLiteral(reinterpret_cast<uintptr_t>(&Record->GuestRIP), Record->GuestRIP);
 
   if (TFSet) {
     // If TF is set, the cache must be skipped as different code needs to be generated.
@@ -621,6 +623,7 @@ Arm64JITCore::Arm64JITCore(FEXCore::Context::ContextImpl* ctx, FEXCore::Core::In
   , HostSupportsAVX256 {ctx->HostFeatures.SupportsAVX && ctx->HostFeatures.SupportsSVE256}
   , HostSupportsRPRES {ctx->HostFeatures.SupportsRPRES}
   , HostSupportsAFP {ctx->HostFeatures.SupportsAFP}
+  , PositionIndependentCode {ctx->Config.CodeCachePositionIndependent}
   , CTX {ctx}
   , TempCodeBufferAllocator(ctx->CPUBackendAllocator, 0) {
 
@@ -644,6 +647,7 @@ Arm64JITCore::Arm64JITCore(FEXCore::Context::ContextImpl* ctx, FEXCore::Core::In
 
     Ptrs.ThreadRemoveCodeEntryFromJIT = reinterpret_cast<uintptr_t>(&Context::ContextImpl::ThreadRemoveCodeEntryFromJit);
     Ptrs.MonoBackpatcherWrite = reinterpret_cast<uint64_t>(&Context::ContextImpl::MonoBackpatcherWrite);
+    Ptrs.SpinWait = reinterpret_cast<uint64_t>(&Context::ContextImpl::SpinWait);
     Ptrs.CPUIDObj = reinterpret_cast<uint64_t>(&CTX->CPUID);
 
     {
@@ -789,12 +793,25 @@ void Arm64JITCore::EmitSuspendInterruptCheck() {
 #endif
 }
 
-void Arm64JITCore::EmitEntryPoint(ARMEmitter::BackwardLabel& HeaderLabel, bool CheckTF) {
+void Arm64JITCore::EmitEntryPoint(ARMEmitter::BackwardLabel& HeaderLabel, bool CheckTF, ARMEmitter::ForwardLabel* ExecutionCounter) {
   // Get the address of the JITCodeHeader and store in to the core state.
   // Two instruction cost, each 1 cycle.
   adr_OrRestart(TMP1, &HeaderLabel);
   str(TMP1, STATE, offsetof(FEXCore::Core::CPUState, InlineJITBlockHeader));
 
+  if (ExecutionCounter) {
+    // BlockStats counter. Without LSE, concurrent executions from multiple threads may lose increments.
+    adr_OrRestart(TMP2, ExecutionCounter);
+    if (CTX->HostFeatures.SupportsAtomics) {
+      LoadConstant(ARMEmitter::Size::i64Bit, TMP3, 1);
+      stadd(ARMEmitter::SubRegSize::i64Bit, TMP3, TMP2);
+    } else {
+      ldr(TMP3, TMP2, 0);
+      add(ARMEmitter::Size::i64Bit, TMP3, TMP3, 1);
+      str(TMP3, TMP2, 0);
+    }
+  }
+
   if (CheckTF) {
     EmitTFCheck();
   }
@@ -875,6 +892,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
   Relocations.resize(PrevNumAllocations, FEXCore::CPU::Relocation::Default()); // Discard any relocations generated from a previous attempt
 
   CodeData.EntryPoints.clear();
+  DebugData->FallbackCalls = 0;
 
   // Fairly excessive buffer range to make sure we don't overflow
   // One page baseline, plus SSANodeMultipler bytes, plus another page for guard page.
@@ -927,6 +945,9 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
   PendingTargetLabel = nullptr;
   PendingCallReturnTargetLabel = nullptr;
 
+  ARMEmitter::ForwardLabel ExecutionCounterLabel;
+  const bool EmitExecutionCounter = CTX->Config.BlockStats() != 0;
+
   for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
     auto BlockIROp = BlockHeader->CW<FEXCore::IR::IROp_CodeBlock>();
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
@@ -964,7 +985,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
         CodeData.EntryPoints.emplace(BlockStartRIP, GetCursorAddress<uint8_t*>());
         DebugData->GuestOpcodes.push_back({BlockIROp->GuestEntryOffset, GetCursorAddress<uint8_t*>() - CodeData.BlockBegin});
 
-        EmitEntryPoint(JITCodeHeaderLabel, CheckTF);
+        EmitEntryPoint(JITCodeHeaderLabel, CheckTF, EmitExecutionCounter ? &ExecutionCounterLabel : nullptr);
       }
 
       if (PendingCallReturnTargetLabel) {
@@ -1014,7 +1035,12 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
     b_OrRestart(&l_DoLink);
     br(TMP1);
     BindOrRestart(&l_DoLink);
-    ldr(TMP1, &l_ExitLink);
+    if (PositionIndependentCode) {
+      // Avoids a host address literal that would need relocation in code caches
+      ldr(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.ExitFunctionLinker));
+    } else {
+      ldr(TMP1, &l_ExitLink);
+    }
     blr(TMP1);
 
     // This is a ExitFunctionLinkData struct
@@ -1024,12 +1050,22 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
     dc64(PendingJumpThunk.CallerAddress - ThunkAddress);                       // CallerOffset
   }
 
-  BindOrRestart(&l_ExitLink);
-  PlaceNamedSymbolLiteral(InsertNamedSymbolLiteral(RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER));
+  if (!PositionIndependentCode) {
+    BindOrRestart(&l_ExitLink);
+    PlaceNamedSymbolLiteral(InsertNamedSymbolLiteral(RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER));
+  }
 
   // CodeSize not including the header or tail data.
   const uint64_t CodeOnlySize = GetCursorAddress<uint8_t*>() - CodeBegin;
 
+  if (EmitExecutionCounter) {
+    // Incremented by every entrypoint of this block, see EmitEntryPoint
+    Align(8);
+    DebugData->ExecutionCounterOffset = GetCursorOffset();
+    BindOrRestart(&ExecutionCounterLabel);
+    dc64(0);
+  }
+
   // Add the JitCodeTail (written later)
   Align(alignof(JITCodeTail));
   const auto JITBlockTailLocation = GetCursorAddress<uint8_t*>();
@@ -1158,6 +1194,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
 #endif
 
   DebugData->HostCodeSize = CodeData.Size;
+  DebugData->HostInstructions = CodeOnlySize >> 2;
   DebugData->Relocations = &Relocations;
 
   this->IR = nullptr;
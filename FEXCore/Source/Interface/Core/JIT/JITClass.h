@@ -69,6 +69,8 @@ private:
   const bool HostSupportsAVX256 {};
   const bool HostSupportsRPRES {};
   const bool HostSupportsAFP {};
+  // Avoid embedding host addresses in generated code, see CodeCachePositionIndependent
+  const bool PositionIndependentCode {};
 
   struct RestartOptions {
     enum class Control : uint64_t {
@@ -625,7 +627,7 @@ private:
 
   void EmitSuspendInterruptCheck();
 
-  void EmitEntryPoint(ARMEmitter::BackwardLabel& HeaderLabel, bool CheckTF);
+  void EmitEntryPoint(ARMEmitter::BackwardLabel& HeaderLabel, bool CheckTF, ARMEmitter::ForwardLabel* ExecutionCounter);
 
   [[nodiscard]] CodeBuffer::CodeBufferAllocation AllocateCodeBufferInSharedCache(size_t Size);
 
@@ -184,7 +184,8 @@ public:
     uintptr_t HostPtr {};
     {
       std::optional<FEXCore::SHMStats::AccumulationBlock<uint64_t>> LockTime(
-        Thread->ThreadStats ? &Thread->ThreadStats->AccumulatedCacheReadLockTime : nullptr);
+        std::in_place, Thread->ThreadStats ? &Thread->ThreadStats->AccumulatedCacheReadLockTime : nullptr,
+        Thread->ThreadStats ? &Thread->ThreadStats->CacheLockTimeHistogram : nullptr);
       auto lk = Shared->AcquireReadLock();
       LockTime.reset();
 
@@ -277,7 +278,8 @@ public:
   // Returns true if new pages are marked as containing code
   bool AddBlockExecutableRange(FEXCore::Core::InternalThreadState* Thread, const fextl::set<uint64_t>& Addresses, uint64_t Start, uint64_t Length) {
     std::optional<FEXCore::SHMStats::AccumulationBlock<uint64_t>> LockTime(
-      Thread->ThreadStats ? &Thread->ThreadStats->AccumulatedCacheWriteLockTime : nullptr);
+      std::in_place, Thread->ThreadStats ? &Thread->ThreadStats->AccumulatedCacheWriteLockTime : nullptr,
+      Thread->ThreadStats ? &Thread->ThreadStats->CacheLockTimeHistogram : nullptr);
     auto lk = Shared->AcquireWriteLock();
     LockTime.reset();
 
@@ -287,7 +289,8 @@ public:
   // Adds to Guest -> Host code mapping
   void AddBlockMapping(FEXCore::Core::InternalThreadState* Thread, uint64_t Address, const fextl::vector<uint64_t>& CodePages, void* HostCode) {
     std::optional<FEXCore::SHMStats::AccumulationBlock<uint64_t>> LockTime(
-      Thread->ThreadStats ? &Thread->ThreadStats->AccumulatedCacheWriteLockTime : nullptr);
+      std::in_place, Thread->ThreadStats ? &Thread->ThreadStats->AccumulatedCacheWriteLockTime : nullptr,
+      Thread->ThreadStats ? &Thread->ThreadStats->CacheLockTimeHistogram : nullptr);
     auto lk = Shared->AcquireWriteLock();
     LockTime.reset();
 
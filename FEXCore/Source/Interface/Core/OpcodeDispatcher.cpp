@@ -93,8 +93,15 @@ void OpDispatchBuilder::SyscallOp(OpcodeArgs, bool IsSyscallInst) {
     StoreGPRRegister(X86State::REG_RCX, RIPAfterInst, OpSize::i64Bit);
   }
 
+  // Syscalls with a known number that the frontend can pass straight through to the host may be done inline by the JIT.
+  int32_t HostSyscallNumber = -1;
+  if (OSABI != FEXCore::HLE::SyscallOSABI::OS_GENERIC && ConstantRAX.Block == GetCurrentBlock()) {
+    HostSyscallNumber = CTX->SyscallHandler->GetSyscallABI(ConstantRAX.Value).HostSyscallNumber;
+  }
+
   FlushRegisterCache();
-  auto SyscallOp = _Syscall(Arguments[0], Arguments[1], Arguments[2], Arguments[3], Arguments[4], Arguments[5], Arguments[6]);
+  auto SyscallOp =
+    _Syscall(Arguments[0], Arguments[1], Arguments[2], Arguments[3], Arguments[4], Arguments[5], Arguments[6], HostSyscallNumber);
 
   // Generic ABI doesn't store result in RAX.
   if (OSABI != FEXCore::HLE::SyscallOSABI::OS_GENERIC) {
@@ -716,7 +723,16 @@ void OpDispatchBuilder::CondJUMPOp(OpcodeArgs) {
     }
 
     // Taking branch block
-    if (TrueBlock != JumpTargets.end()) {
+    if (TrueBlock != JumpTargets.end() && IsSpinWaitBackEdge(Target)) {
+      // Wait on the way back to the top of the loop, the fall-through stays direct
+      auto WaitBlock = CreateNewCodeBlockAtEnd();
+      SetTrueJumpTarget(CondJump_, WaitBlock);
+      SetCurrentCodeBlock(WaitBlock);
+      StartNewBlock();
+
+      SpinWaitOnBackEdge(Op, TargetOffset);
+      Jump(TrueBlock->second.BlockEntry);
+    } else if (TrueBlock != JumpTargets.end()) {
       SetTrueJumpTarget(CondJump_, TrueBlock->second.BlockEntry);
     } else {
       // Make sure to start a new block after ending this one
@@ -725,6 +741,10 @@ void OpDispatchBuilder::CondJUMPOp(OpcodeArgs) {
       SetCurrentCodeBlock(JumpTarget);
       StartNewBlock();
 
+      if (IsSpinWaitBackEdge(Target)) {
+        SpinWaitOnBackEdge(Op, TargetOffset);
+      }
+
       // Store the new RIP
       ExitRelocatedPC(Op, TargetOffset);
     }
@@ -867,6 +887,30 @@ void OpDispatchBuilder::LoopOp(OpcodeArgs) {
   }
 }
 
+void OpDispatchBuilder::SpinWaitOnBackEdge(OpcodeArgs, int64_t TargetOffset) {
+  const auto Inst = SpinWait.Inst;
+  const auto& Operand = *SpinWait.Operand;
+  const auto Size = &Operand == &Inst->Dest ? OpSizeFromDst(Inst) : OpSizeFromSrc(Inst);
+
+  Ref Address = MakeSegmentAddress(Inst, Operand, Size);
+
+  // The wait compares against the value the loop last compared, so a change since then doesn't get waited on
+  Ref Observed {};
+  if (SpinWait.ValueGPR != X86State::REG_INVALID) {
+    Observed = LoadGPRRegister(SpinWait.ValueGPR, Size, SpinWait.ValueHighBits ? 8 : 0, true);
+  } else if (SpinWaitPolled && SpinWaitPolledBlock == GetCurrentBlock()) {
+    Observed = SpinWaitPolled;
+  } else {
+    // IR values are local to their block, so a wait in a block of its own (conditional back-edges) reloads the location.
+    // It was compared right before the branch, a change in between only delays the loop until the next wakeup of the wait.
+    Observed = _LoadMemAutoTSO(RegClass::GPR, Size, Address, Size);
+  }
+
+  // Signals delivered during the wait resume at the top of the loop
+  _StoreContextGPR(GetGPROpSize(), GetRelocatedPC(Op, TargetOffset), offsetof(FEXCore::Core::CPUState, rip));
+  _SpinWait(Size, Address, Observed);
+}
+
 void OpDispatchBuilder::JUMPOp(OpcodeArgs) {
   // Calculate flags early.
   CalculateDeferredFlags();
@@ -892,6 +936,11 @@ void OpDispatchBuilder::JUMPOp(OpcodeArgs) {
   }
 
   CalculateDeferredFlags();
+
+  if (IsSpinWaitBackEdge(TargetRIP)) {
+    SpinWaitOnBackEdge(Op, TargetOffset);
+  }
+
   // This is just an unconditional relative literal jump
   if (Multiblock) {
     auto JumpBlock = JumpTargets.find(TargetRIP);
@@ -4455,6 +4504,11 @@ Ref OpDispatchBuilder::LoadSource_WithOpSize(RegClass Class, const X86Tables::De
     } else {
       Result = _LoadMemAutoTSO(Class, OpSize, A, Align == OpSize::iInvalid ? OpSize : Align);
     }
+
+    if (&Operand == SpinWait.Operand) {
+      SpinWaitPolled = Result;
+      SpinWaitPolledBlock = GetCurrentBlock();
+    }
   } else {
     Result = LoadEffectiveAddress(this, A, GetGPROpSize(), false, AllowUpperGarbage);
   }
@@ -165,6 +165,8 @@ public:
 
     // Need to clear any named constants that were cached.
     ClearCachedNamedConstants();
+
+    ConstantRAX = {};
   }
 
   IRPair<IROp_Jump> Jump() {
@@ -386,6 +388,7 @@ public:
   void CALLOp(OpcodeArgs);
   void CALLAbsoluteOp(OpcodeArgs);
   void CondJUMPOp(OpcodeArgs);
+  void SpinWaitOnBackEdge(OpcodeArgs, int64_t TargetOffset);
   void CondJUMPRCXOp(OpcodeArgs);
   void LoopOp(OpcodeArgs);
   void JUMPOp(OpcodeArgs);
@@ -1126,6 +1129,13 @@ public:
     Multiblock = _Multiblock;
   }
 
+  // Set per decoded block, the back-edge of a detected spin-wait loop waits for the polled memory to change
+  void SetSpinWaitAccess(const FEXCore::Frontend::Decoder::SpinWaitAccess& Access) {
+    SpinWait = Access;
+    SpinWaitPolled = nullptr;
+    SpinWaitPolledBlock = nullptr;
+  }
+
   static inline constexpr unsigned IndexNZCV(unsigned BitOffset) {
     switch (BitOffset) {
     case FEXCore::X86State::RFLAG_OF_RAW_LOC: return 28;
@@ -1925,6 +1935,13 @@ private:
     Ref Value[64];
   } RegCache {};
 
+  // Last value stored to RAX if it was a constant, only valid within the code block it was stored in.
+  // Lets syscalls with a constant syscall number be resolved at compile time.
+  struct {
+    Ref Block;
+    uint64_t Value;
+  } ConstantRAX {};
+
   void InvalidateReg(uint8_t Index) {
     uint64_t Bit = (1ull << (uint64_t)Index);
     RegCache.Cached &= ~Bit;
@@ -2053,6 +2070,14 @@ private:
   }
 
   void StoreRegister(uint8_t Reg, bool FPR, Ref Value) {
+    if (!FPR && Reg == X86State::REG_RAX) {
+      uint64_t Constant;
+      ConstantRAX = {};
+      if (IsValueConstant(WrapNode(Value), &Constant)) {
+        ConstantRAX = {GetCurrentBlock(), Constant};
+      }
+    }
+
     StoreContext(Reg + (FPR ? FPR0Index : GPR0Index), Value);
   }
 
@@ -2419,6 +2444,16 @@ private:
   bool Is64BitMode {};
   uint64_t Entry {};
 
+  FEXCore::Frontend::Decoder::SpinWaitAccess SpinWait {};
+  // The value the polling instruction of the spin-wait loop loaded, and the IR block it is defined in
+  Ref SpinWaitPolled {};
+  Ref SpinWaitPolledBlock {};
+
+  [[nodiscard]]
+  bool IsSpinWaitBackEdge(uint64_t Target) const {
+    return SpinWait.Inst && SpinWait.LoopEntry == Target;
+  }
+
   // Set if mono hacks are enabled and the current block is the mono callsite backpatcher, in which case the
   // XCHG ops that would patch code are replaced with a hook that performs the write and manually invalidates
   // the target address.
@@ -8,6 +8,7 @@ $end_info$
 */
 
 #include "Interface/Context/Context.h"
+#include "Interface/Core/CompileTrace.h"
 #include "Interface/IR/PassManager.h"
 #include "Interface/IR/Passes.h"
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
@@ -103,10 +104,12 @@ void PassManager::InsertValidationPass(fextl::unique_ptr<Pass> Pass, const fextl
 }
 #endif
 
-void PassManager::Run(IREmitter* IREmit) {
+void PassManager::Run(IREmitter* IREmit, CompileTrace::BlockRecord* Trace) {
   FEXCORE_PROFILE_SCOPED("PassManager::Run");
 
+  const auto* RAPass = Trace ? GetPass("RA") : nullptr;
   for (const auto& Pass : Passes) {
+    CPU::CompileTraceStageTimer PassTimer {Trace, Pass.get() == RAPass ? CompileTrace::STAGE_RA : CompileTrace::STAGE_PASSES};
     Pass->Run(IREmit);
   }
 
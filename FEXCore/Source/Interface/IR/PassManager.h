@@ -20,6 +20,10 @@ namespace FEXCore::Context {
 class ContextImpl;
 }
 
+namespace FEXCore::CompileTrace {
+struct BlockRecord;
+}
+
 namespace FEXCore::IR {
 class PassManager;
 class IREmitter;
@@ -45,7 +49,8 @@ public:
 
   // Executes all of the passes added to the manager.
   // If assertions are enabled, this will also run all validation passes.
-  void Run(IREmitter* IREmit);
+  // If Trace is set, time spent in the passes is added to it.
+  void Run(IREmitter* IREmit, CompileTrace::BlockRecord* Trace = nullptr);
 
   // Inserts a new pass into the manager, optionally also assigning a name to it
   // for use in the lookup functions,
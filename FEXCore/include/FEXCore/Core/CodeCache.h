@@ -8,6 +8,7 @@
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
 #include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/Utils/SignalScopeGuards.h>
 #include <FEXCore/Utils/TypeDefines.h>
 
 #include <atomic>
@@ -19,6 +20,7 @@
 #include <unistd.h>
 
 namespace FEXCore {
+struct HostFeatures;
 
 namespace Core {
   struct InternalThreadState;
@@ -219,6 +221,13 @@ struct MappedCodeCacheFile {
   fextl::vector<bool> LoadedPages;
 
   uint64_t GuestBase {}; // Guest base address for relocation application
+  uint32_t ModuleTableOffset {}; // Offset of the module table in CodeBuffer for position-independent caches, 0 otherwise
+
+  uint32_t NumFinalizationFaults {}; // Number of page ranges finalized on first execution, synchronized by the frontend
+
+  // Pages mapped read-only from a buffer shared with other processes, see MapSharedCodeBuffer and MapCodeBufferFromFile.
+  // Empty if the code buffer isn't shared. Synchronized by AbstractCodeCache once registered.
+  fextl::vector<bool> SharedPages;
 
   // Helper member to prevent moving/copying without disallowing aggregate-construction
   std::atomic<int> disallow_copy_or_move;
@@ -231,6 +240,10 @@ struct MappedCodeCacheFile {
 class AbstractCodeCache {
   fextl::vector<std::span<std::byte>> MappedCodeBuffers;
 
+  // Registered buffers with shared pages, accessed from the SIGSEGV handler
+  fextl::vector<MappedCodeCacheFile*> SharedCodeBuffers;
+  ForkableUniqueMutex SharedCodeBuffersMutex;
+
 public:
   virtual ~AbstractCodeCache() = default;
 
@@ -244,9 +257,46 @@ public:
 
   /**
    * Bundles the current Core state (CodeBuffer, GuestToHostMapping, ...) to a code cache and writes it to the given file descriptor.
+   *
+   * CompileThreads must list every thread that compiled code for this cache, so that their relocations can be merged.
+   * Each block is stored with a hash of the guest code it was compiled from, see ImportBlocks.
    * Returns true on success.
    */
-  virtual bool SaveData(Core::InternalThreadState&, int TargetFD, const ExecutableFileSectionInfo&, uint64_t SerializedBaseAddress) = 0;
+  virtual bool SaveData(std::span<Core::InternalThreadState* const> CompileThreads, int TargetFD, const ExecutableFileSectionInfo&,
+                        uint64_t SerializedBaseAddress) = 0;
+
+  /**
+   * Imports blocks from a previously generated code cache into the current Core state.
+   *
+   * Only blocks listed in Blocks (as offsets from FileStartVA) whose guest code hash still matches are imported,
+   * and only if the cache was generated by the same FEX version with the same configuration id.
+   * Imported blocks are written back by the next call to SaveData.
+   *
+   * Returns the offsets of all imported blocks.
+   */
+  virtual fextl::set<uint64_t> ImportBlocks(Core::InternalThreadState*, std::span<const std::byte> PreviousCache, const ExecutableFileSectionInfo&,
+                                            const fextl::set<uint64_t>& Blocks) = 0;
+
+  /**
+   * Checks if the given cache file was generated by this FEX version using the given ConfigId.
+   *
+   * Only the file header is inspected, so this is cheap enough to decide whether a cache needs regeneration.
+   */
+  static bool IsCompatibleCacheFile(std::span<const std::byte> CacheFile, uint64_t ConfigId);
+
+  /**
+   * Computes an identifier for all configuration options and host features that affect code generation.
+   *
+   * Caches are only valid for the configuration id they were generated with. The id is included
+   * in cache filenames so that caches for different configurations (e.g. per-app profiles) can coexist.
+   * Requires the configuration of the target application to be loaded, including CONFIG_IS64BIT_MODE.
+   */
+  static uint64_t ComputeConfigId(const HostFeatures&);
+
+  /**
+   * Returns the configuration id of the running Context, see ComputeConfigId.
+   */
+  virtual uint64_t GetConfigId() const = 0;
 
   /**
    * Function to be called before compiling any code for caching purposes
@@ -280,14 +330,65 @@ public:
    */
   static std::span<std::byte> SelectCodeRangeToFinalize(MappedCodeCacheFile&, size_t StartPage, size_t EndPage);
 
+  /**
+   * Returns all code page indices in the order they should be finalized eagerly.
+   *
+   * Pages containing the most cached block entries come first, since they're likely to be executed early.
+   */
+  static fextl::vector<uint32_t> GetEagerFinalizationOrder(const MappedCodeCacheFile&);
+
   /**
    * Finalize code pages in the given range (see SelectCodePagesToFinalize) for execution.
    */
   virtual void FinalizeCodePages(MappedCodeCacheFile&, std::span<std::byte> CodeRange) = 0;
 
+  /**
+   * Creates a sealed memfd with the cached code of the given file and all guest relocations applied.
+   *
+   * Host addresses are left unrelocated, so the contents only depend on the cache file and GuestBase.
+   * This allows sharing the buffer with other processes, see MapSharedCodeBuffer.
+   *
+   * Returns the memfd, or -1 on failure.
+   */
+  virtual int CreateSharedCodeBuffer(MappedCodeCacheFile&) = 0;
+
+  /**
+   * Maps a buffer created by CreateSharedCodeBuffer (possibly in a different process) onto CodeBuffer and finalizes all pages.
+   *
+   * Pages containing host relocations are finalized into private copies, all other pages stay shared and read-only
+   * until written to, see HandleSharedCodePageWriteFault. Must be called before any pages are finalized.
+   *
+   * Returns the number of privately copied pages, or std::nullopt if the buffer can't be used.
+   */
+  virtual std::optional<size_t> MapSharedCodeBuffer(MappedCodeCacheFile&, int FD) = 0;
+
+  /**
+   * Maps CodeBuffer directly from the cache file for position-independent caches (see CodeCachePositionIndependent),
+   * and finalizes all pages.
+   *
+   * Only pages with remaining relocations (the module table, host addresses, and guest addresses that exceed the
+   * position-independent encodings) are copied privately. Must be called before any pages are finalized.
+   *
+   * Returns the number of privately copied pages, or std::nullopt if the cache can't be mapped this way.
+   */
+  virtual std::optional<size_t> MapCodeBufferFromFile(MappedCodeCacheFile&, int FD) = 0;
+
   void RegisterMappedCodeBuffer(MappedCodeCacheFile&);
   void UnregisterMappedCodeBuffer(MappedCodeCacheFile&);
   bool IsAddressInMappedCodeBuffer(uintptr_t Address) const;
+
+  /**
+   * Handles a write fault on a shared page of a registered code buffer, for example from block linking.
+   *
+   * The page is made writable, so the faulting write turns it into a private copy.
+   * Must be called from the SIGSEGV handler without holding VMATracking locks, since the writer may hold JIT locks.
+   *
+   * Returns false if the address isn't in a shared page.
+   */
+  bool HandleSharedCodePageWriteFault(Core::InternalThreadState*, uintptr_t Address);
+
+  void LockBeforeFork();
+  void UnlockAfterFork(bool Child);
 };
 
 } // namespace FEXCore
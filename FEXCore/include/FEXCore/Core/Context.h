@@ -142,6 +142,13 @@ public:
   virtual void SetCodeMapWriter(fextl::unique_ptr<CodeMapWriter>) = 0;
   virtual void FlushAndCloseCodeMap() = 0;
 
+  // Logs the hottest blocks if BlockStats is enabled
+  FEX_DEFAULT_VISIBILITY virtual void WriteBlockStats(FEXCore::Core::InternalThreadState* Thread) = 0;
+  // Writes out any queued records of the CompileTrace, if enabled.
+  FEX_DEFAULT_VISIBILITY virtual void FlushCompileTrace() = 0;
+  // Writes out the thread's buffered JIT symbols and jitdump records, if enabled.
+  FEX_DEFAULT_VISIBILITY virtual void FlushJITSymbols(FEXCore::Core::InternalThreadState* Thread) = 0;
+
   FEX_DEFAULT_VISIBILITY virtual void ClearCodeCache(FEXCore::Core::InternalThreadState* Thread, bool NewCodeBuffer = true) = 0;
   FEX_DEFAULT_VISIBILITY virtual void InvalidateCodeBuffersCodeRange(uint64_t Start, uint64_t Length) = 0;
   FEX_DEFAULT_VISIBILITY virtual void
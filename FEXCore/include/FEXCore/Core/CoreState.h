@@ -348,6 +348,7 @@ struct JITPointers {
   uint64_t SyscallHandlerFunc {};
   uint64_t ExitFunctionLink {};
   uint64_t MonoBackpatcherWrite {};
+  uint64_t SpinWait {};
   uint64_t LUDIV {};
   uint64_t LDIV {};
   uint64_t ThunkCallbackRet {};
@@ -416,6 +417,13 @@ struct CpuStateFrame {
 
   uint32_t SignalHandlerRefCounter {};
 
+  /**
+   * @brief Forces syscalls that the JIT would otherwise do inline through the SyscallHandler
+   *
+   * Set by the frontend while something needs to observe every syscall, like seccomp filters.
+   */
+  uint32_t ForceSyscallHandler {};
+
   struct alignas(8) SynchronousFaultDataStruct {
     bool FaultToTopAndGeneratedException {};
     uint8_t Signal;
@@ -14,6 +14,7 @@
 #include <FEXCore/fextl/robin_map.h>
 #include <FEXCore/fextl/vector.h>
 #include <stdint.h>
+#include <condition_variable>
 #include <mutex>
 #include <optional>
 #include <span>
@@ -127,7 +128,13 @@ namespace DiskCache {
     ssize_t Size();
     bool ReadAll(fextl::vector<uint8_t>& Out); // from first blob
     bool ReadBlob(uint64_t Offset, std::span<uint8_t> OutBlob);
-    bool WriteBlob(const MesaFOZ::foz_payload_key& Key, std::span<const std::span<const uint8_t>> BlobChunks, uint64_t& OutBlobOffset);
+
+    struct BlobWrite {
+      const MesaFOZ::foz_payload_key* Key;
+      std::span<const uint8_t> Data;
+    };
+    // Appends all blobs with a single vectored write. Caller must hold the lock.
+    bool WriteBlobs(std::span<const BlobWrite> Blobs, fextl::vector<uint64_t>& OutBlobOffsets);
 
   private:
     static constexpr uint32_t OPEN_LOCK_TIMEOUT_MS = 100;
@@ -137,12 +144,18 @@ namespace DiskCache {
     bool ReadOnly = false;
   };
 
+  struct PendingStore {
+    MesaFOZ::foz_payload_key Key;
+    fextl::vector<uint8_t> Blob;
+  };
+
   class IndexedDB {
   public:
     bool Open(const fextl::string& CacheDBName, bool ReadOnly);
     void PopulateIndex(Index& CacheIndex);
     bool ReadCacheBlob(uint64_t Offset, std::span<uint8_t> OutBlob);
-    bool StoreCacheBlob(const MesaFOZ::foz_payload_key& Key, std::span<const uint8_t> Blob, Index& CacheIndex, std::mutex& IndexMutex);
+    // Commits a whole batch under one lock acquisition
+    bool StoreCacheBlobs(std::span<const PendingStore> Stores, Index& CacheIndex, std::mutex& IndexMutex);
 
   private:
     // stores run on the Writer, so returning quick isn't as important
@@ -171,13 +184,25 @@ namespace DiskCache {
 
   private:
     bool OpenCacheDB(const fextl::string& CacheDBName, bool ReadOnly);
+    void FlushPendingStores();
+
+    // Stores are group committed, once this much is pending the JIT threads wait for the Writer to catch up
+    static constexpr size_t MAX_PENDING_BYTES = 32 * 1024 * 1024;
+    static constexpr size_t MAX_PENDING_STORES = 4096;
+    // If the Writer can't catch up in time the store is dropped instead of stalling the JIT further
+    static constexpr uint32_t BACKPRESSURE_TIMEOUT_MS = 50;
 
     FEXCore::Context::ContextImpl* CTX;
     fextl::vector<fextl::unique_ptr<IndexedDB>> ROCacheDBs;
     fextl::unique_ptr<IndexedDB> RWCacheDB;
     Index Index;
     std::mutex IndexLock;
-    struct CacheStoreWorkItem;
+
+    std::mutex PendingLock;
+    std::condition_variable PendingDrained;
+    fextl::vector<PendingStore> PendingStores;
+    size_t PendingBytes {};
+    struct CacheFlushWorkItem;
 
     // the Writer holds references to all this stuff above and needs to be last
     fextl::unique_ptr<WorkQueueThread> Writer;
@@ -11,6 +11,8 @@ namespace FEXCore {
  *
  * Specifically things that affect the IR->Codegen process
  * Not the x86->IR process
+ *
+ * NOTE: Update AbstractCodeCache::ComputeConfigId when adding members.
  */
 struct HostFeatures {
   // Whether or not the host supports any kind of SVE implementation.
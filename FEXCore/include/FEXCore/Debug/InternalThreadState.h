@@ -87,6 +87,14 @@ struct UnalignedExclusiveStore {
   uint8_t Size;
 };
 
+// Backoff of the guest spin-wait loop the thread is currently in, see ContextImpl::SpinWait
+struct SpinWaitBackoff {
+  uint64_t Address;
+  // Steady clock nanoseconds
+  uint64_t LastWaitEnd;
+  uint32_t Level;
+};
+
 struct alignas(FEXCore::Utils::FEX_PAGE_SIZE) InternalThreadState : public FEXCore::Allocator::FEXAllocOperators {
   FEXCore::Core::CpuStateFrame* const CurrentFrame = &BaseFrameState;
 
@@ -100,11 +108,13 @@ struct alignas(FEXCore::Utils::FEX_PAGE_SIZE) InternalThreadState : public FEXCo
   NonMovableUniquePtr<FEXCore::Frontend::Decoder> FrontendDecoder;
   NonMovableUniquePtr<FEXCore::IR::PassManager> PassManager;
   NonMovableUniquePtr<JITSymbolBuffer> SymbolBuffer;
+  NonMovableUniquePtr<JITSymbolBuffer> JitDumpBuffer;
 
   // This pointer is owned by the frontend.
   FEXCore::SHMStats::ThreadStats* ThreadStats {};
 
   UnalignedExclusiveStore ExclusiveStore;
+  SpinWaitBackoff SpinWait {};
 
   ///< Data pointer for exclusive use by the frontend
   void* FrontendPtr;
@@ -30,6 +30,7 @@ struct SyscallABI {
   // Linux = RAX
   bool HasReturn;
 
+  // Host syscall the guest syscall can be passed through to unmodified, or -1 if it needs to go through HandleSyscall
   int32_t HostSyscallNumber;
 };
 
@@ -58,6 +59,9 @@ public:
   SyscallOSABI GetOSABI() const {
     return OSABI;
   }
+  virtual SyscallABI GetSyscallABI(uint64_t Syscall) {
+    return {.NumArgs = 0, .HasReturn = true, .HostSyscallNumber = -1};
+  }
   virtual void MarkGuestExecutableRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Start, uint64_t Length) {}
   virtual void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Start, uint64_t Length) {}
   virtual void MarkOvercommitRange(uint64_t Start, uint64_t Length) {}
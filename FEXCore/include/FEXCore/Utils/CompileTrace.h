@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Binary format of the block-compile trace written when the CompileTrace option is set.
+ *
+ * The file starts with a FileHeader followed by a stream of records. Every record begins
+ * with a RecordHeader and is padded to a multiple of 8 bytes, so readers can skip record types
+ * they don't know about.
+ *
+ * Times are raw cycle counter values. Clock records pair the cycle counter with a monotonic
+ * nanosecond timestamp, which lets readers derive the counter frequency.
+ */
+namespace FEXCore::CompileTrace {
+constexpr uint32_t MAGIC = 0x4A584546; ///< 'FEXJ'
+constexpr uint32_t VERSION = 1;
+
+struct FileHeader {
+  uint32_t Magic;
+  uint32_t Version;
+};
+
+enum class RecordType : uint16_t {
+  Clock,
+  Module,
+  Block,
+  Dropped,
+};
+
+struct RecordHeader {
+  RecordType Type;
+  // Size of the full record including this header and padding
+  uint16_t Size;
+};
+
+struct ClockRecord {
+  RecordHeader Header;
+  uint32_t Pad;
+  uint64_t Cycles;
+  uint64_t MonotonicNS;
+};
+
+// Followed by NameLength bytes of the module's file path
+struct ModuleRecord {
+  RecordHeader Header;
+  uint32_t ModuleID;
+  uint32_t NameLength;
+  uint32_t Pad;
+};
+
+enum class BlockSource : uint8_t {
+  // Compiled by the JIT
+  JIT,
+  // Loaded from the disk cache
+  DiskCache,
+  // Already present in the lookup cache, including blocks mapped in from AOT code caches
+  LookupCache,
+};
+
+enum BlockFlags : uint8_t {
+  // Another thread compiled the same block first, the compile was thrown away
+  BLOCK_FLAG_RACED = (1U << 0),
+};
+
+enum Stage : uint8_t {
+  STAGE_DECODE,
+  STAGE_DISPATCH,
+  STAGE_PASSES,
+  STAGE_RA,
+  STAGE_EMIT,
+  NUM_STAGES,
+};
+
+constexpr uint32_t INVALID_MODULE_ID = ~0U;
+
+struct BlockRecord {
+  RecordHeader Header;
+  BlockSource Source;
+  uint8_t Flags;
+  uint16_t Pad;
+  uint32_t ModuleID;
+  uint32_t MaxInst;
+  uint64_t GuestRIP;
+  // Offset of GuestRIP from the start of its module, only valid with a ModuleID
+  uint64_t ModuleOffset;
+  uint32_t GuestInstructions;
+  uint32_t IROps;
+  uint32_t HostBytes;
+  uint32_t Pad2;
+  uint64_t StageCycles[NUM_STAGES];
+  // Time spent in CompileBlock, including lookups and bookkeeping not attributed to a stage
+  uint64_t TotalCycles;
+};
+
+// Records that couldn't be stored because the ring buffer was full
+struct DroppedRecord {
+  RecordHeader Header;
+  uint32_t NumRecords;
+};
+
+static_assert(sizeof(ClockRecord) % 8 == 0);
+static_assert(sizeof(ModuleRecord) % 8 == 0);
+static_assert(sizeof(BlockRecord) % 8 == 0);
+static_assert(sizeof(DroppedRecord) % 8 == 0);
+} // namespace FEXCore::CompileTrace
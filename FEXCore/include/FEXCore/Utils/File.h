@@ -5,7 +5,9 @@
 #include <FEXCore/Utils/EnumOperators.h>
 #include "FEXCore/Utils/LogManager.h"
 
+#include <algorithm>
 #include <chrono>
+#include <span>
 #include <thread>
 
 #ifndef _WIN32
@@ -13,6 +15,7 @@
 #include <unistd.h>
 #include <sys/file.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #else
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -167,6 +170,74 @@ public:
 #endif
   }
 
+  /**
+   * @brief Write all Chunks back to back starting at Offset.
+   *
+   * Uses pwritev where available so a batch of small chunks turns in to a handful of syscalls.
+   *
+   * @return The number of bytes actually written or -1 on error.
+   */
+  ssize_t PWriteV(std::span<const std::span<const uint8_t>> Chunks, uint64_t Offset) {
+    if (Seekable) {
+      LOGMAN_THROW_A_FMT(false, "Can't use positioned ops on a seekable file!");
+      return -1;
+    }
+    ssize_t TotalWritten = 0;
+#ifndef _WIN32
+    constexpr size_t MAX_IOVECS = 64;
+    struct iovec IOVecs[MAX_IOVECS];
+
+    while (!Chunks.empty()) {
+      const size_t Count = std::min(Chunks.size(), MAX_IOVECS);
+      size_t Expected = 0;
+      for (size_t i = 0; i < Count; ++i) {
+        IOVecs[i].iov_base = const_cast<uint8_t*>(Chunks[i].data());
+        IOVecs[i].iov_len = Chunks[i].size();
+        Expected += Chunks[i].size();
+      }
+
+      const ssize_t Written = pwritev(Handle, IOVecs, Count, Offset);
+      if (Written < 0) {
+        return -1;
+      }
+      if ((size_t)Written != Expected) {
+        // Short write, finish this group chunk by chunk.
+        size_t Skip = Written;
+        uint64_t CurrentOffset = Offset + Written;
+        for (size_t i = 0; i < Count; ++i) {
+          const auto& Chunk = Chunks[i];
+          if (Skip >= Chunk.size()) {
+            Skip -= Chunk.size();
+            continue;
+          }
+          const size_t Remaining = Chunk.size() - Skip;
+          if (PWrite(Chunk.data() + Skip, Remaining, CurrentOffset) != (ssize_t)Remaining) {
+            return -1;
+          }
+          CurrentOffset += Remaining;
+          Skip = 0;
+        }
+      }
+
+      Offset += Expected;
+      TotalWritten += Expected;
+      Chunks = Chunks.subspan(Count);
+    }
+#else
+    for (const auto& Chunk : Chunks) {
+      if (Chunk.empty()) {
+        continue;
+      }
+      if (PWrite(Chunk.data(), Chunk.size(), Offset) != (ssize_t)Chunk.size()) {
+        return -1;
+      }
+      Offset += Chunk.size();
+      TotalWritten += Chunk.size();
+    }
+#endif
+    return TotalWritten;
+  }
+
   bool Lock(uint32_t TimeoutMS) {
     for (uint32_t i = 0;; ++i) {
       if (TryLock()) {
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: MIT
 #pragma once
+#include <algorithm>
 #include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 
@@ -32,7 +34,7 @@ static inline uint64_t GetCycleCounter() {
 }
 #endif
 // FEXCore live-stats
-constexpr uint8_t STATS_VERSION = 2;
+constexpr uint8_t STATS_VERSION = 8;
 enum class AppType : uint8_t {
   LINUX_32,
   LINUX_64,
@@ -40,6 +42,60 @@ enum class AppType : uint8_t {
   WIN_WOW64,
 };
 
+// Log2 histogram of latencies (In unscaled CPU cycles!).
+// Bucket N counts samples in [2^N, 2^(N+1)), the last bucket also counts everything above.
+struct LatencyHistogram {
+  constexpr static size_t NUM_BUCKETS = 32;
+  uint64_t Buckets[NUM_BUCKETS];
+
+  static size_t BucketForCycles(uint64_t Cycles) {
+    return std::min<size_t>(std::bit_width(Cycles | 1) - 1, NUM_BUCKETS - 1);
+  }
+
+  // Exclusive upper bound of a bucket
+  static uint64_t BucketLimit(size_t Bucket) {
+    return 2ULL << Bucket;
+  }
+
+  // Only the owning thread records, but signal handlers may interrupt it
+  void Record(uint64_t Cycles) {
+    std::atomic_ref(Buckets[BucketForCycles(Cycles)]).fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Merge(const LatencyHistogram& Other) {
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+      Buckets[i] += std::atomic_ref(const_cast<uint64_t&>(Other.Buckets[i])).load(std::memory_order_relaxed);
+    }
+  }
+
+  uint64_t Count() const {
+    uint64_t Total = 0;
+    for (auto Bucket : Buckets) {
+      Total += Bucket;
+    }
+    return Total;
+  }
+
+  // Returns the upper bound of the bucket containing the given percentile in [0, 100], or 0 if empty
+  uint64_t Percentile(double Percent) const {
+    const uint64_t Total = Count();
+    if (!Total) {
+      return 0;
+    }
+
+    const auto Target = std::max<uint64_t>(1, static_cast<uint64_t>(Total * Percent / 100.0 + 0.5));
+    uint64_t Seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+      Seen += Buckets[i];
+      if (Seen >= Target) {
+        return BucketLimit(i);
+      }
+    }
+    return BucketLimit(NUM_BUCKETS - 1);
+  }
+};
+static_assert(sizeof(LatencyHistogram) % 16 == 0, "Needs to be 16-byte aligned!");
+
 // Only append new members to the end of {ThreadStatsHeader, ThreadStats} to allow old tools time to support new information.
 // FEX isn't guaranteeing /not/ breaking compatibility with versions, but trying to not cause too much churn.
 struct ThreadStatsHeader {
@@ -70,29 +126,99 @@ struct ThreadStats {
   uint64_t AccumulatedCacheWriteLockTime;
 
   uint64_t AccumulatedJITCount;
+
+  // DiskCache writer, bytes handed off by this thread and the pending store count it last saw
+  uint64_t AccumulatedDiskCacheWriteBytes;
+  uint64_t DiskCacheQueueLength;
+
+  // Code cache pages mapped from buffers shared with other processes, and pages that were copied privately.
+  // Shared bytes minus AccumulatedCodeCacheUnsharedBytes are resident only once across all processes
+  uint64_t AccumulatedCodeCacheSharedBytes;
+  uint64_t AccumulatedCodeCachePrivateBytes;
+
+  // Code cache pages finalized on first execution, and the time spent doing so (In unscaled CPU cycles!)
+  uint64_t AccumulatedCodeCacheFaultCount;
+  uint64_t AccumulatedCodeCacheFaultTime;
+
+  // Latency distributions, see LatencyHistogram
+  LatencyHistogram JITTimeHistogram;
+  LatencyHistogram SignalTimeHistogram;
+  LatencyHistogram SMCTimeHistogram;
+  // Time spent waiting on LookupCache read and write locks
+  LatencyHistogram CacheLockTimeHistogram;
+  LatencyHistogram SyscallTimeHistogram;
+
+  // Guest spin-wait loops lowered to host waits, and the time spent waiting in them (In unscaled CPU cycles!)
+  uint64_t AccumulatedSpinLoopCount;
+  uint64_t AccumulatedSpinWaitTime;
+
+  // Shared code cache pages that were copied privately when written to later, e.g. by block linking
+  uint64_t AccumulatedCodeCacheUnsharedBytes;
+  uint64_t Pad;
 };
 
 // Ensure 16-byte alignment to take advantage of ARM single-copy atomicity.
 static_assert(sizeof(ThreadStats) % 16 == 0, "Needs to be 16-byte aligned!");
 
+// Walks the live threads of a mapped stats region, calling Func for every one of them.
+// MappedSize bounds the walk since the region may have grown after it was mapped by the reader.
+template<typename Func>
+void ForEachThreadStats(const void* Base, size_t MappedSize, Func&& Callback) {
+  const auto Header = reinterpret_cast<const ThreadStatsHeader*>(Base);
+  const size_t Stride = Header->ThreadStatsSize;
+  if (MappedSize < sizeof(ThreadStatsHeader) || Stride == 0) {
+    return;
+  }
+
+  // Bounds the walk in case the list is modified while it is being read
+  size_t RemainingSlots = (MappedSize - sizeof(ThreadStatsHeader)) / Stride;
+  uint32_t Offset = Header->Head.load(std::memory_order_relaxed);
+  while (Offset != 0 && Offset + Stride <= MappedSize && RemainingSlots--) {
+    const auto Stats = reinterpret_cast<const ThreadStats*>(reinterpret_cast<const std::byte*>(Base) + Offset);
+    if (Stats->TID.load(std::memory_order_relaxed) != 0) {
+      Callback(*Stats);
+    }
+    Offset = Stats->Next.load(std::memory_order_relaxed);
+  }
+}
+
+// Merges one histogram across all live threads of a mapped stats region.
+// Returns false if the region was written by a FEX version with a different layout.
+inline bool MergeThreadHistograms(const void* Base, size_t MappedSize, LatencyHistogram ThreadStats::* Member, LatencyHistogram& Merged) {
+  // Any other version may place the member elsewhere, or not have it at all
+  if (reinterpret_cast<const ThreadStatsHeader*>(Base)->Version != STATS_VERSION) {
+    return false;
+  }
+
+  ForEachThreadStats(Base, MappedSize, [&](const ThreadStats& Stats) { Merged.Merge(Stats.*Member); });
+  return true;
+}
+
 template<typename T, size_t FlatOffset = 0>
 class AccumulationBlock final {
 public:
-  AccumulationBlock(T* Stat)
-    : Begin {Stat ? GetCycleCounter() : 0}
-    , Stat {Stat} {}
+  AccumulationBlock(T* Stat, LatencyHistogram* Histogram = nullptr)
+    : Begin {Stat || Histogram ? GetCycleCounter() : 0}
+    , Stat {Stat}
+    , Histogram {Histogram} {}
 
   ~AccumulationBlock() {
-    if (Stat) {
+    if (Stat || Histogram) {
       const auto Duration = GetCycleCounter() - Begin + FlatOffset;
-      auto ref = std::atomic_ref<T>(*Stat);
-      ref.fetch_add(Duration, std::memory_order_relaxed);
+      if (Stat) {
+        auto ref = std::atomic_ref<T>(*Stat);
+        ref.fetch_add(Duration, std::memory_order_relaxed);
+      }
+      if (Histogram) {
+        Histogram->Record(Duration);
+      }
     }
   }
 
 private:
   uint64_t Begin;
   T* Stat;
+  LatencyHistogram* Histogram;
 };
 #define UniqueScopeName2(name, line) name##line
 #define UniqueScopeName(name, line) UniqueScopeName2(name, line)
@@ -100,6 +226,14 @@ private:
 #define FEXCORE_PROFILE_ACCUMULATION(ThreadState, Stat)                                                                          \
   FEXCore::SHMStats::AccumulationBlock<decltype(ThreadState->ThreadStats->Stat)> UniqueScopeName(ScopedAccumulation_, __LINE__)( \
     ThreadState->ThreadStats ? &ThreadState->ThreadStats->Stat : nullptr);
+// Same as FEXCORE_PROFILE_ACCUMULATION, additionally recording the duration in a LatencyHistogram
+#define FEXCORE_PROFILE_ACCUMULATION_HISTOGRAM(ThreadState, Stat, Histogram)                                                      \
+  FEXCore::SHMStats::AccumulationBlock<decltype(ThreadState->ThreadStats->Stat)> UniqueScopeName(ScopedAccumulation_, __LINE__)( \
+    ThreadState->ThreadStats ? &ThreadState->ThreadStats->Stat : nullptr,                                                       \
+    ThreadState->ThreadStats ? &ThreadState->ThreadStats->Histogram : nullptr);
+#define FEXCORE_PROFILE_HISTOGRAM(ThreadState, Histogram)                                    \
+  FEXCore::SHMStats::AccumulationBlock<uint64_t> UniqueScopeName(ScopedHistogram_, __LINE__)( \
+    nullptr, ThreadState->ThreadStats ? &ThreadState->ThreadStats->Histogram : nullptr);
 #define FEXCORE_PROFILE_INSTANT_INCREMENT(ThreadState, Stat, value) \
   do {                                                              \
     if (ThreadState->ThreadStats) {                                 \
@@ -196,6 +196,48 @@ template bool Wait<uint16_t>(uint16_t*, uint16_t, const std::chrono::nanoseconds
 template bool Wait<uint32_t>(uint32_t*, uint32_t, const std::chrono::nanoseconds&);
 template bool Wait<uint64_t>(uint64_t*, uint64_t, const std::chrono::nanoseconds&);
 
+///< Waits with WFET until either the memory changes, a spurious wake-up, or the cycle counter reaches Deadline.
+static inline uint64_t WFETLoadAtomic(uint64_t* Futex, uint64_t Deadline) {
+  uint64_t Result {};
+  // WFET isn't known to all assemblers, so its register is fixed.
+  register uint64_t DeadlineReg asm("x0") = Deadline;
+  __asm volatile(".inst 0xd5031000; // wfet x0\n"
+                 "ldar %x[Result], [%[Futex]];\n"
+                 : [Result] "=r"(Result), [Futex] "+r"(Futex)
+                 : "r"(DeadlineReg)
+                 : "memory");
+
+  return Result;
+}
+
+///< Waits for `(*Futex & Mask) != ComparisonValue`. Returns false if the timeout passed first.
+/// Timeouts shorter than the event stream period are only honoured with WFET.
+static inline bool WaitForChange(uint64_t* Futex, uint64_t Mask, uint64_t ComparisonValue, const std::chrono::nanoseconds& Timeout,
+                                 bool UseWFET) {
+  auto AtomicFutex = std::atomic_ref<uint64_t>(*Futex);
+
+  // Early exit if possible.
+  if ((AtomicFutex.load() & Mask) != ComparisonValue) {
+    return true;
+  }
+
+  const auto Deadline = GetCycleCounter() + ConvertNanosecondsToCycles(Timeout);
+
+  do {
+    uint64_t Result = LoadExclusive(Futex);
+    if ((Result & Mask) != ComparisonValue) {
+      return true;
+    }
+
+    Result = UseWFET ? WFETLoadAtomic(Futex, Deadline) : WFELoadAtomic(Futex);
+    if ((Result & Mask) != ComparisonValue) {
+      return true;
+    }
+  } while (GetCycleCounter() < Deadline);
+
+  return false;
+}
+
 template<typename T>
 static inline T OneShotWFEBitComparison(T* Futex, T Mask, T Comp) {
   auto AtomicFutex = std::atomic_ref<T>(*Futex);
@@ -264,6 +306,20 @@ static inline bool Wait(T* Futex, TT ExpectedValue, const std::chrono::nanosecon
   // We got our result.
   return true;
 }
+
+static inline bool WaitForChange(uint64_t* Futex, uint64_t Mask, uint64_t ComparisonValue, const std::chrono::nanoseconds& Timeout,
+                                 bool UseWFET) {
+  auto AtomicFutex = std::atomic_ref<uint64_t>(*Futex);
+  const auto Begin = std::chrono::high_resolution_clock::now();
+
+  do {
+    if ((AtomicFutex.load() & Mask) != ComparisonValue) {
+      return true;
+    }
+  } while ((std::chrono::high_resolution_clock::now() - Begin) < Timeout);
+
+  return false;
+}
 #endif
 
 template<typename T, typename TT = T>
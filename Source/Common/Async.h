@@ -146,7 +146,7 @@ public:
               callbacks[ActiveFD.fd] = std::move(Callback);
             } else if (Ret == post_callback::drop) {
               // If no new callback was registered, drop the FD from the list and skip any remaining events
-              if (!callbacks.contains(ActiveFD.fd)) {
+              if (!callbacks[ActiveFD.fd]) {
                 QueuedEvents.push_back(Event {.FD = {.fd = ActiveFD.fd}, .Erase = true});
                 ActiveFD.revents = 0;
               }
@@ -50,7 +50,7 @@ int RequestPIDFDPacket(int ServerSocket, PacketType Type) {
 
   // Send request
   fasio::error ec;
-  write(Socket, fasio::mutable_buffer {std::as_writable_bytes(std::span {&Req, 1})}, ec);
+  write(Socket, fasio::mutable_buffer {std::as_writable_bytes(std::span {&Req.BasicRequest, 1})}, ec);
   if (ec != fasio::error::success) {
     return -1;
   }
@@ -415,19 +415,32 @@ fextl::string RequestRootFSPath(int ServerSocket) {
   return {};
 }
 
+int RequestRootFSIndexFD(int ServerSocket) {
+  int FD = RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_ROOTFS_INDEX_FD);
+  if (FD != -1) {
+    // FD flags aren't transferred with the FD
+    fcntl(FD, F_SETFD, FD_CLOEXEC);
+  }
+  return FD;
+}
+
 int RequestPIDFD(int ServerSocket) {
   return RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_PID_FD);
 }
 
-void PopulateCodeCache(int ServerSocket, int ProgramFD, bool HasMultiblock) {
+void PopulateCodeCache(int ServerSocket, int ProgramFD, bool HasMultiblock, uint64_t ConfigId) {
   fasio::error ec;
   fasio::tcp_socket Socket {ServerSocket};
 
   // Send request
   FEXServerRequestPacket Req {
-    .Header {.Type = HasMultiblock ? PacketType::TYPE_POPULATE_CODE_CACHE : PacketType::TYPE_POPULATE_CODE_CACHE_NO_MULTIBLOCK}};
+    .CodeCache {
+      .Header {.Type = HasMultiblock ? PacketType::TYPE_POPULATE_CODE_CACHE : PacketType::TYPE_POPULATE_CODE_CACHE_NO_MULTIBLOCK},
+      .ConfigId = ConfigId,
+    },
+  };
 
-  fasio::mutable_buffer WriteBuffer {std::as_writable_bytes(std::span {&Req, 1})};
+  fasio::mutable_buffer WriteBuffer {std::as_writable_bytes(std::span {&Req.CodeCache, 1})};
   WriteBuffer.FD = &ProgramFD;
   write(Socket, WriteBuffer, ec);
   if (ec != fasio::error::success) {
@@ -442,18 +455,21 @@ void PopulateCodeCache(int ServerSocket, int ProgramFD, bool HasMultiblock) {
   read(Socket, ResBuffer, ec);
 }
 
-int RequestCodeMapFD(int ServerSocket, int ProgramFD, bool HasMultiblock) {
+int RequestCodeMapFD(int ServerSocket, int ProgramFD, bool HasMultiblock, uint64_t ConfigId) {
   fasio::tcp_socket Socket {ServerSocket};
   FEXServerRequestPacket Req {
-    .Header {
-      .Type = HasMultiblock ? PacketType::TYPE_QUERY_CODE_MAP : PacketType::TYPE_QUERY_CODE_MAP_NO_MULTIBLOCK,
+    .CodeCache {
+      .Header {
+        .Type = HasMultiblock ? PacketType::TYPE_QUERY_CODE_MAP : PacketType::TYPE_QUERY_CODE_MAP_NO_MULTIBLOCK,
+      },
+      .ConfigId = ConfigId,
     },
   };
 
   // Send request
   fasio::error ec;
   {
-    fasio::mutable_buffer WriteBuffer {std::as_writable_bytes(std::span {&Req, 1})};
+    fasio::mutable_buffer WriteBuffer {std::as_writable_bytes(std::span {&Req.CodeCache, 1})};
     WriteBuffer.FD = &ProgramFD;
     write(Socket, WriteBuffer, ec);
     if (ec != fasio::error::success) {
@@ -474,6 +490,77 @@ int RequestCodeMapFD(int ServerSocket, int ProgramFD, bool HasMultiblock) {
   return NewFD;
 }
 
+int RequestCodeCacheUpdateFD(int ServerSocket) {
+  int FD = RequestPIDFDPacket(ServerSocket, PacketType::TYPE_SUBSCRIBE_CODE_CACHE_UPDATES);
+  if (FD != -1) {
+    // FD flags aren't transferred with the FD
+    fcntl(FD, F_SETFD, FD_CLOEXEC);
+  }
+  return FD;
+}
+
+int RequestSharedCodeCacheFD(int ServerSocket, const SharedCodeCacheKey& Key) {
+  fasio::tcp_socket Socket {ServerSocket};
+  FEXServerRequestPacket Req {
+    .SharedCodeCache {
+      .Header {
+        .Type = PacketType::TYPE_QUERY_SHARED_CODE_CACHE,
+      },
+      .Key = Key,
+    },
+  };
+
+  // Send request
+  fasio::error ec;
+  {
+    fasio::mutable_buffer WriteBuffer {std::as_writable_bytes(std::span {&Req.SharedCodeCache, 1})};
+    write(Socket, WriteBuffer, ec);
+    if (ec != fasio::error::success) {
+      return -1;
+    }
+  }
+
+  // Wait for success response and memfd
+  FEXServerResultPacket Res {};
+  fasio::mutable_buffer ResBuffer {std::as_writable_bytes(std::span {&Res, 1})};
+  int NewFD = -1;
+  ResBuffer.FD = &NewFD;
+  read(Socket, ResBuffer, ec);
+  if (ec != fasio::error::success || Res.Header.Type != PacketType::TYPE_SUCCESS) {
+    return -1;
+  }
+
+  // FD flags aren't transferred with the FD
+  fcntl(NewFD, F_SETFD, FD_CLOEXEC);
+  return NewFD;
+}
+
+void PublishSharedCodeCache(int ServerSocket, const SharedCodeCacheKey& Key, int CodeFD) {
+  fasio::tcp_socket Socket {ServerSocket};
+  FEXServerRequestPacket Req {
+    .SharedCodeCache {
+      .Header {
+        .Type = PacketType::TYPE_PUBLISH_SHARED_CODE_CACHE,
+      },
+      .Key = Key,
+    },
+  };
+
+  fasio::error ec;
+  fasio::mutable_buffer WriteBuffer {std::as_writable_bytes(std::span {&Req.SharedCodeCache, 1})};
+  WriteBuffer.FD = &CodeFD;
+  write(Socket, WriteBuffer, ec);
+  if (ec != fasio::error::success) {
+    return;
+  }
+
+  // Wait for the response so that it doesn't get mixed up with the next request.
+  // Sharing is best-effort, so the result itself doesn't matter.
+  FEXServerResultPacket Res {};
+  fasio::mutable_buffer ResBuffer {std::as_writable_bytes(std::span {&Res, 1})};
+  read(Socket, ResBuffer, ec);
+}
+
 /**  @} */
 
 /**
@@ -23,12 +23,32 @@ enum class PacketType {
   TYPE_POPULATE_CODE_CACHE_NO_MULTIBLOCK,
   TYPE_QUERY_CODE_MAP,
   TYPE_QUERY_CODE_MAP_NO_MULTIBLOCK,
+  TYPE_SUBSCRIBE_CODE_CACHE_UPDATES,
+  TYPE_QUERY_SHARED_CODE_CACHE,
+  TYPE_PUBLISH_SHARED_CODE_CACHE,
+  TYPE_GET_ROOTFS_INDEX_FD,
 
   // Result only
   TYPE_SUCCESS,
   TYPE_ERROR,
 };
 
+/**
+ * Identifies relocated code cache data that can be shared between processes.
+ *
+ * The cache file is identified by inode and modification time, so regenerated caches get a new key.
+ */
+struct SharedCodeCacheKey {
+  uint64_t CacheDev;
+  uint64_t CacheInode;
+  int64_t CacheMTimeNs;
+  uint64_t GuestBase;
+  // Size of the relocated code, which FEXServer checks published buffers against
+  uint64_t CodeSize;
+
+  auto operator<=>(const SharedCodeCacheKey&) const = default;
+};
+
 union FEXServerRequestPacket {
   struct Header {
     PacketType Type;
@@ -37,6 +57,18 @@ union FEXServerRequestPacket {
   struct {
     struct Header Header;
   } BasicRequest;
+
+  // Used by TYPE_POPULATE_CODE_CACHE* and TYPE_QUERY_CODE_MAP*
+  struct {
+    struct Header Header;
+    uint64_t ConfigId;
+  } CodeCache;
+
+  // Used by TYPE_QUERY_SHARED_CODE_CACHE and TYPE_PUBLISH_SHARED_CODE_CACHE
+  struct {
+    struct Header Header;
+    SharedCodeCacheKey Key;
+  } SharedCodeCache;
 };
 
 union FEXServerResultPacket {
@@ -58,6 +90,14 @@ union FEXServerResultPacket {
 
 constexpr size_t MAXIMUM_REQUEST_PACKET_SIZE = sizeof(FEXServerRequestPacket);
 
+/**
+ * Written by FEXServer to the FD returned by RequestCodeCacheUpdateFD
+ * whenever a background compile job produced a new code cache.
+ */
+struct CodeCacheUpdateNotification {
+  uint64_t FileId;
+};
+
 fextl::string GetServerLockFolder();
 fextl::string GetServerLockFile();
 fextl::string GetServerRootFSLockFile();
@@ -115,6 +155,15 @@ int RequestLogFD(int ServerSocket);
 
 fextl::string RequestRootFSPath(int ServerSocket);
 
+/**
+ * @brief Request the index of the RootFS image mounted by FEXServer
+ *
+ * @param ServerSocket - Socket to the server
+ *
+ * @return Sealed memfd with the FEX::RootFSIndex, or -1 if the RootFS isn't an image or it isn't indexed yet
+ */
+int RequestRootFSIndexFD(int ServerSocket);
+
 /**
  * @brief Request a FEXServer to give us a pidfd of the process
  *
@@ -131,18 +180,48 @@ int RequestPIDFD(int ServerSocket);
  * @param ServerSocket - Socket to the server
  * @param ProgramFD - FD for program binary
  * @param HasMultiblock - true if multiblock is enabled (used for selecting code maps)
+ * @param ConfigId - Code cache configuration id of the client
  */
-void PopulateCodeCache(int ServerSocket, int ProgramFD, bool HasMultiblock);
+void PopulateCodeCache(int ServerSocket, int ProgramFD, bool HasMultiblock, uint64_t ConfigId);
 
 /**
  * @brief Request FEXServer to create a new code map for disk cache population
  *
  * @param ServerSocket - Socket to the server
  * @param ProgramFD - FD for program binary
+ * @param ConfigId - Code cache configuration id of the client
  *
  * @return FD to write code map to
  */
-int RequestCodeMapFD(int ServerSocket, int ProgramFD, bool HasMultiblock);
+int RequestCodeMapFD(int ServerSocket, int ProgramFD, bool HasMultiblock, uint64_t ConfigId);
+
+/**
+ * @brief Request a FEXServer to notify us about code caches generated in the background
+ *
+ * @param ServerSocket - Socket to the server
+ *
+ * @return Non-blocking FD to read CodeCacheUpdateNotification from, or -1 if background compilation is disabled
+ */
+int RequestCodeCacheUpdateFD(int ServerSocket);
+
+/**
+ * @brief Request relocated code cache data previously shared by another process
+ *
+ * @param ServerSocket - Socket to the server
+ * @param Key - Cache file and guest base address of the code
+ *
+ * @return Sealed memfd with the relocated code, or -1 if the code wasn't shared yet
+ */
+int RequestSharedCodeCacheFD(int ServerSocket, const SharedCodeCacheKey& Key);
+
+/**
+ * @brief Share relocated code cache data with other processes
+ *
+ * @param ServerSocket - Socket to the server
+ * @param Key - Cache file and guest base address of the code
+ * @param CodeFD - Sealed memfd with the relocated code
+ */
+void PublishSharedCodeCache(int ServerSocket, const SharedCodeCacheKey& Key, int CodeFD);
 
 /**  @} */
 
@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: MIT
+#include "Common/RootFSIndex.h"
+
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <limits>
+#include <linux/limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace FEX::RootFSIndex {
+// Keeps a broken or hostile image from making FEXServer allocate unbounded memory
+constexpr size_t MAX_ENTRIES = 4 * 1024 * 1024;
+
+uint64_t HashPath(std::string_view Path) {
+  // FNV-1a
+  uint64_t Hash = 0xcbf29ce484222325ULL;
+  for (char c : Path) {
+    Hash = (Hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+  }
+  return Hash;
+}
+
+int Build(const fextl::string& MountFolder, const std::atomic<bool>& Cancel) {
+  fextl::vector<Entry> Entries;
+  fextl::string Strings;
+
+  const auto AddString = [&Strings](std::string_view Str) {
+    const auto Offset = Strings.size();
+    Strings += Str;
+    return static_cast<uint32_t>(Offset);
+  };
+
+  const uint32_t MountFolderOffset = AddString(MountFolder);
+
+  std::error_code ec;
+  std::filesystem::recursive_directory_iterator It(MountFolder, std::filesystem::directory_options::skip_permission_denied, ec);
+  for (; !ec && It != std::filesystem::recursive_directory_iterator(); It.increment(ec)) {
+    if (Cancel.load(std::memory_order_relaxed)) {
+      return -1;
+    }
+
+    if (Entries.size() == MAX_ENTRIES) {
+      LogMan::Msg::EFmt("[FEXServer] RootFS has too many files to index");
+      return -1;
+    }
+
+    const auto& Path = It->path().native();
+    const std::string_view RelativePath = std::string_view(Path).substr(MountFolder.size() + 1);
+
+    // Uses the type from the directory entry when available, so most entries don't need a stat
+    const auto Type = It->symlink_status(ec).type();
+    if (ec) {
+      break;
+    }
+
+    Entry NewEntry {
+      .PathHash = HashPath(RelativePath),
+      .PathOffset = AddString(RelativePath),
+      .PathLength = static_cast<uint32_t>(RelativePath.size()),
+      .Type = Type == std::filesystem::file_type::directory ? EntryType::Directory :
+              Type == std::filesystem::file_type::symlink   ? EntryType::Symlink :
+                                                              EntryType::Other,
+    };
+
+    if (NewEntry.Type == EntryType::Symlink) {
+      char Target[PATH_MAX];
+      const auto TargetLength = readlink(Path.c_str(), Target, sizeof(Target));
+      if (TargetLength < 0 || TargetLength == sizeof(Target)) {
+        // Dropping the entry would make clients report the symlink as missing, and a truncated target would resolve elsewhere
+        LogMan::Msg::EFmt("[FEXServer] Couldn't read RootFS symlink '{}'", RelativePath);
+        return -1;
+      }
+      NewEntry.TargetOffset = AddString({Target, static_cast<size_t>(TargetLength)});
+      NewEntry.TargetLength = TargetLength;
+    }
+
+    Entries.emplace_back(NewEntry);
+  }
+
+  if (ec) {
+    // A partial index would report files as missing that exist
+    LogMan::Msg::EFmt("[FEXServer] Couldn't index RootFS: {}", ec.message());
+    return -1;
+  }
+
+  if (Strings.size() > std::numeric_limits<uint32_t>::max()) {
+    LogMan::Msg::EFmt("[FEXServer] RootFS paths are too large to index");
+    return -1;
+  }
+
+  std::ranges::sort(Entries, [&Strings](const Entry& LHS, const Entry& RHS) {
+    if (LHS.PathHash != RHS.PathHash) {
+      return LHS.PathHash < RHS.PathHash;
+    }
+    return std::string_view(Strings).substr(LHS.PathOffset, LHS.PathLength) < std::string_view(Strings).substr(RHS.PathOffset, RHS.PathLength);
+  });
+
+  const Header IndexHeader {
+    .Magic = MAGIC,
+    .Version = VERSION,
+    .NumEntries = Entries.size(),
+    .StringsOffset = sizeof(Header) + Entries.size() * sizeof(Entry),
+    .StringsSize = Strings.size(),
+    .MountFolderOffset = MountFolderOffset,
+    .MountFolderLength = static_cast<uint32_t>(MountFolder.size()),
+  };
+  const size_t Size = IndexHeader.StringsOffset + IndexHeader.StringsSize;
+
+  int FD = memfd_create("FEXRootFSIndex", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (FD == -1) {
+    return -1;
+  }
+
+  void* Ptr = MAP_FAILED;
+  if (ftruncate(FD, Size) == 0) {
+    Ptr = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0);
+  }
+  if (Ptr == MAP_FAILED) {
+    close(FD);
+    return -1;
+  }
+
+  auto Data = static_cast<std::byte*>(Ptr);
+  memcpy(Data, &IndexHeader, sizeof(IndexHeader));
+  memcpy(Data + sizeof(IndexHeader), Entries.data(), Entries.size() * sizeof(Entry));
+  memcpy(Data + IndexHeader.StringsOffset, Strings.data(), Strings.size());
+  munmap(Ptr, Size);
+
+  // Clients can then trust the contents without validating every offset
+  if (fcntl(FD, F_ADD_SEALS, F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE) == -1) {
+    close(FD);
+    return -1;
+  }
+
+  LogMan::Msg::DFmt("[FEXServer] Indexed {} RootFS paths in {} bytes", Entries.size(), Size);
+  return FD;
+}
+
+Reader::~Reader() {
+  if (Mapping) {
+    munmap(Mapping, MappingSize);
+  }
+}
+
+bool Reader::Load(int FD, std::string_view MountFolder) {
+  struct stat Buffer {};
+  if (fstat(FD, &Buffer) != 0 || Buffer.st_size < sizeof(Header)) {
+    return false;
+  }
+
+  // The writer can't modify the index behind our back once it is sealed
+  const int Seals = fcntl(FD, F_GET_SEALS);
+  if (Seals == -1 || (Seals & (F_SEAL_SHRINK | F_SEAL_WRITE)) != (F_SEAL_SHRINK | F_SEAL_WRITE)) {
+    return false;
+  }
+
+  void* Ptr = mmap(nullptr, Buffer.st_size, PROT_READ, MAP_SHARED, FD, 0);
+  if (Ptr == MAP_FAILED) {
+    return false;
+  }
+
+  const auto IndexHeader = static_cast<const Header*>(Ptr);
+  const size_t Size = Buffer.st_size;
+  const bool Valid = IndexHeader->Magic == MAGIC && IndexHeader->Version == VERSION && IndexHeader->NumEntries <= MAX_ENTRIES &&
+                     IndexHeader->StringsOffset == sizeof(Header) + IndexHeader->NumEntries * sizeof(Entry) &&
+                     IndexHeader->StringsOffset + IndexHeader->StringsSize <= Size &&
+                     IndexHeader->MountFolderOffset + uint64_t {IndexHeader->MountFolderLength} <= IndexHeader->StringsSize;
+  if (!Valid) {
+    munmap(Ptr, Size);
+    return false;
+  }
+
+  const auto IndexStrings = static_cast<const char*>(Ptr) + IndexHeader->StringsOffset;
+  if (std::string_view(IndexStrings + IndexHeader->MountFolderOffset, IndexHeader->MountFolderLength) != MountFolder) {
+    // Built for a different RootFS
+    munmap(Ptr, Size);
+    return false;
+  }
+
+  Mapping = Ptr;
+  MappingSize = Size;
+  Entries = reinterpret_cast<const Entry*>(IndexHeader + 1);
+  NumEntries = IndexHeader->NumEntries;
+  Strings = IndexStrings;
+  return true;
+}
+
+const Entry* Reader::Find(std::string_view Path) const {
+  const uint64_t Hash = HashPath(Path);
+  const auto End = Entries + NumEntries;
+  for (auto It = std::lower_bound(Entries, End, Hash, [](const Entry& LHS, uint64_t Hash) { return LHS.PathHash < Hash; });
+       It != End && It->PathHash == Hash; ++It) {
+    if (GetString(It->PathOffset, It->PathLength) == Path) {
+      return It;
+    }
+  }
+  return nullptr;
+}
+
+std::optional<Reader::LookupResult> Reader::Lookup(std::string_view Path) const {
+  if (!Entries) {
+    return std::nullopt;
+  }
+
+  // Paths are stored without empty and "." components
+  char Normalized[PATH_MAX];
+  size_t Length {};
+  const Entry* Current {};
+
+  size_t Offset {};
+  while (Offset < Path.size()) {
+    auto End = Path.find('/', Offset);
+    if (End == Path.npos) {
+      End = Path.size();
+    }
+    const auto Name = Path.substr(Offset, End - Offset);
+    Offset = End + 1;
+
+    if (Name.empty() || Name == ".") {
+      continue;
+    }
+
+    if (Name == ".." || (Current && Current->Type != EntryType::Directory)) {
+      return std::nullopt;
+    }
+
+    if (Length + Name.size() + 1 >= sizeof(Normalized)) {
+      return std::nullopt;
+    }
+
+    if (Length) {
+      Normalized[Length++] = '/';
+    }
+    memcpy(&Normalized[Length], Name.data(), Name.size());
+    Length += Name.size();
+
+    Current = Find({Normalized, Length});
+    if (!Current) {
+      // Every parent was a real directory, so nothing can exist beneath it
+      return LookupResult {.Type = EntryType::Missing};
+    }
+  }
+
+  if (!Current) {
+    // The root itself
+    return LookupResult {.Type = EntryType::Directory};
+  }
+
+  if (Path.ends_with('/') && Current->Type != EntryType::Directory) {
+    // Trailing slashes follow symlinks and fail on files
+    return std::nullopt;
+  }
+
+  return LookupResult {
+    .Type = Current->Type,
+    .Target = Current->Type == EntryType::Symlink ? GetString(Current->TargetOffset, Current->TargetLength) : std::string_view {},
+  };
+}
+} // namespace FEX::RootFSIndex
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/fextl/string.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/**
+ * Index of every path in a read-only RootFS image.
+ *
+ * FEXServer builds it once the image is mounted and hands it to clients as a sealed memfd,
+ * so that they can resolve RootFS paths and symlinks from memory instead of walking the FUSE mount.
+ *
+ * Layout: Header, Entry array sorted by path hash, string table with the paths and symlink targets.
+ */
+namespace FEX::RootFSIndex {
+constexpr uint32_t MAGIC = 0x58444952; // 'RIDX'
+constexpr uint32_t VERSION = 1;
+
+enum class EntryType : uint32_t {
+  // Only returned by lookups, never stored
+  Missing,
+  Directory,
+  Symlink,
+  Other,
+};
+
+struct Header {
+  uint32_t Magic;
+  uint32_t Version;
+  uint64_t NumEntries;
+  uint64_t StringsOffset;
+  uint64_t StringsSize;
+  // Mount folder the index was built from, as an offset in to the string table
+  uint32_t MountFolderOffset;
+  uint32_t MountFolderLength;
+};
+
+struct Entry {
+  uint64_t PathHash;
+  // Path relative to the mount folder, without leading or duplicate slashes
+  uint32_t PathOffset;
+  uint32_t PathLength;
+  // Symlink target as returned by readlink, only valid for symlinks
+  uint32_t TargetOffset;
+  uint32_t TargetLength;
+  EntryType Type;
+  uint32_t Pad;
+};
+
+uint64_t HashPath(std::string_view Path);
+
+/**
+ * @brief Walks the mounted image and writes its index to a sealed memfd
+ *
+ * @param MountFolder - Where the image is mounted
+ * @param Cancel - Stops the walk early once set
+ *
+ * @return The memfd, or -1 on failure
+ */
+int Build(const fextl::string& MountFolder, const std::atomic<bool>& Cancel);
+
+class Reader final {
+public:
+  Reader() = default;
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+  ~Reader();
+
+  // Maps the index. Returns false if it is invalid or was built for a different mount folder.
+  bool Load(int FD, std::string_view MountFolder);
+
+  struct LookupResult {
+    EntryType Type;
+    std::string_view Target;
+  };
+
+  /**
+   * @brief Looks up a path relative to the RootFS without following the final component
+   *
+   * @return The result, or std::nullopt if resolving the path needs the kernel.
+   *         This is the case for paths with ".." or that walk through a symlink or file.
+   */
+  std::optional<LookupResult> Lookup(std::string_view Path) const;
+
+private:
+  const Entry* Find(std::string_view Path) const;
+  std::string_view GetString(uint32_t Offset, uint32_t Length) const {
+    return {Strings + Offset, Length};
+  }
+
+  void* Mapping {};
+  size_t MappingSize {};
+  const Entry* Entries {};
+  uint64_t NumEntries {};
+  const char* Strings {};
+};
+} // namespace FEX::RootFSIndex
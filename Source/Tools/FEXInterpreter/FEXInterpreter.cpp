@@ -604,7 +604,15 @@ int main(int argc, char** argv, char** const envp) {
 
   if (FEXCore::Config::Get_ENABLECODECACHINGWIP()) {
     // Request code cache generation
-    FEXServerClient::PopulateCodeCache(FEXServerClient::GetServerFD(), Loader.GetMainElfFD(), FEXCore::Config::Get_MULTIBLOCK());
+    FEXServerClient::PopulateCodeCache(FEXServerClient::GetServerFD(), Loader.GetMainElfFD(), FEXCore::Config::Get_MULTIBLOCK(),
+                                       CTX->GetCodeCache().GetConfigId());
+
+    // Pick up caches that FEXServer compiles in the background while we're running
+    int CodeCacheUpdateFD = FEXServerClient::RequestCodeCacheUpdateFD(FEXServerClient::GetServerFD());
+    if (CodeCacheUpdateFD != -1) {
+      SyscallHandler->FM.TrackFEXFD(CodeCacheUpdateFD);
+      SyscallHandler->SetCodeCacheUpdateFD(CodeCacheUpdateFD);
+    }
 
     if (VDSOMapping) {
       // Finalize code cache for libVDSO-guest.so. This needs to be done explicitly since VDSO doesn't use LoadLib.
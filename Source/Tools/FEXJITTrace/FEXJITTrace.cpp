@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: MIT
+#include "OptionParser.h"
+
+#include <FEXCore/Utils/CompileTrace.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Config {
+std::string TracePath;
+uint32_t TopCount {20};
+
+bool LoadOptions(int argc, char** argv) {
+  optparse::OptionParser Parser {};
+  Parser.usage("%prog [options] <trace.jittrace>");
+
+  Parser.add_option("-n", "--top").type("int").set_default(20).help("Number of modules and blocks to list");
+
+  optparse::Values Options = Parser.parse_args(argc, argv);
+  TopCount = std::max(0, static_cast<int>(Options.get("top")));
+
+  if (Parser.args().size() != 1) {
+    Parser.print_usage();
+    return false;
+  }
+
+  TracePath = Parser.args()[0];
+  return true;
+}
+} // namespace Config
+
+namespace {
+using namespace FEXCore::CompileTrace;
+
+constexpr std::array<const char*, NUM_STAGES> StageNames = {"Decode", "Dispatch", "Passes", "RA", "Emit"};
+
+struct BlockTotals {
+  uint64_t Compiles {};
+  uint64_t Cycles {};
+  uint64_t GuestInstructions {};
+  uint64_t IROps {};
+  uint64_t HostBytes {};
+};
+
+struct ModuleTotals {
+  uint64_t Compiles {};
+  uint64_t DiskCacheHits {};
+  uint64_t LookupCacheHits {};
+  uint64_t Cycles {};
+};
+
+struct TraceSummary {
+  std::vector<std::string> Modules;
+
+  uint64_t SourceCounts[3] {};
+  uint64_t SourceCycles[3] {};
+  uint64_t Raced {};
+  uint64_t Dropped {};
+
+  // Only JIT compiled blocks
+  uint64_t StageCycles[NUM_STAGES] {};
+  uint64_t JITCycles {};
+  uint64_t GuestInstructions {};
+  uint64_t IROps {};
+  uint64_t HostBytes {};
+
+  // Keyed by module ID and offset, or INVALID_MODULE_ID and RIP for anonymous code
+  std::map<std::pair<uint32_t, uint64_t>, BlockTotals> Blocks;
+  std::map<uint32_t, ModuleTotals> PerModule;
+
+  // First and last clock record, used to derive the cycle counter frequency
+  ClockRecord FirstClock {};
+  ClockRecord LastClock {};
+};
+
+bool Parse(const std::vector<char>& Data, TraceSummary& Out) {
+  FileHeader Header {};
+  if (Data.size() < sizeof(Header)) {
+    fmt::print(stderr, "Trace is truncated\n");
+    return false;
+  }
+  memcpy(&Header, Data.data(), sizeof(Header));
+  if (Header.Magic != MAGIC || Header.Version != VERSION) {
+    fmt::print(stderr, "Unsupported trace: magic {:#x} version {}, expected version {}\n", Header.Magic, Header.Version, VERSION);
+    return false;
+  }
+
+  size_t Offset = sizeof(Header);
+  while (Offset + sizeof(RecordHeader) <= Data.size()) {
+    RecordHeader Record {};
+    memcpy(&Record, Data.data() + Offset, sizeof(Record));
+    if (Record.Size < sizeof(RecordHeader) || Offset + Record.Size > Data.size()) {
+      // Most likely the process was killed while the trace was written
+      fmt::print(stderr, "Trace ends in a truncated record at offset {:#x}\n", Offset);
+      break;
+    }
+
+    const char* RecordData = Data.data() + Offset;
+    switch (Record.Type) {
+    case RecordType::Clock: {
+      if (Record.Size < sizeof(ClockRecord)) {
+        break;
+      }
+      ClockRecord Clock;
+      memcpy(&Clock, RecordData, sizeof(Clock));
+      if (!Out.FirstClock.Cycles) {
+        Out.FirstClock = Clock;
+      }
+      Out.LastClock = Clock;
+      break;
+    }
+    case RecordType::Module: {
+      if (Record.Size < sizeof(ModuleRecord)) {
+        break;
+      }
+      ModuleRecord Module;
+      memcpy(&Module, RecordData, sizeof(Module));
+      const auto NameLength = std::min<size_t>(Module.NameLength, Record.Size - sizeof(ModuleRecord));
+      if (Out.Modules.size() <= Module.ModuleID) {
+        Out.Modules.resize(Module.ModuleID + 1);
+      }
+      Out.Modules[Module.ModuleID].assign(RecordData + sizeof(ModuleRecord), NameLength);
+      break;
+    }
+    case RecordType::Block: {
+      if (Record.Size < sizeof(BlockRecord)) {
+        break;
+      }
+      BlockRecord Block;
+      memcpy(&Block, RecordData, sizeof(Block));
+      const auto Source = std::min<size_t>(static_cast<size_t>(Block.Source), std::size(Out.SourceCounts) - 1);
+      ++Out.SourceCounts[Source];
+      Out.SourceCycles[Source] += Block.TotalCycles;
+
+      auto& Module = Out.PerModule[Block.ModuleID];
+      Module.Cycles += Block.TotalCycles;
+      if (Block.Source == BlockSource::DiskCache) {
+        ++Module.DiskCacheHits;
+      } else if (Block.Source == BlockSource::LookupCache) {
+        ++Module.LookupCacheHits;
+      } else {
+        ++Module.Compiles;
+      }
+
+      if (Block.Source != BlockSource::JIT) {
+        break;
+      }
+
+      if (Block.Flags & BLOCK_FLAG_RACED) {
+        ++Out.Raced;
+      }
+
+      for (size_t i = 0; i < NUM_STAGES; ++i) {
+        Out.StageCycles[i] += Block.StageCycles[i];
+      }
+      Out.JITCycles += Block.TotalCycles;
+      Out.GuestInstructions += Block.GuestInstructions;
+      Out.IROps += Block.IROps;
+      Out.HostBytes += Block.HostBytes;
+
+      const auto Key = Block.ModuleID == INVALID_MODULE_ID ? std::pair {Block.ModuleID, Block.GuestRIP} : std::pair {Block.ModuleID, Block.ModuleOffset};
+      auto& Totals = Out.Blocks[Key];
+      ++Totals.Compiles;
+      Totals.Cycles += Block.TotalCycles;
+      Totals.GuestInstructions = Block.GuestInstructions;
+      Totals.IROps = Block.IROps;
+      Totals.HostBytes = Block.HostBytes;
+      break;
+    }
+    case RecordType::Dropped: {
+      if (Record.Size < sizeof(DroppedRecord)) {
+        break;
+      }
+      DroppedRecord Dropped;
+      memcpy(&Dropped, RecordData, sizeof(Dropped));
+      Out.Dropped += Dropped.NumRecords;
+      break;
+    }
+    default: break;
+    }
+
+    Offset += Record.Size;
+  }
+
+  return true;
+}
+
+std::string_view ModuleName(const TraceSummary& Trace, uint32_t ModuleID) {
+  if (ModuleID == INVALID_MODULE_ID || ModuleID >= Trace.Modules.size() || Trace.Modules[ModuleID].empty()) {
+    return "<anonymous>";
+  }
+  std::string_view Name = Trace.Modules[ModuleID];
+  return Name.substr(Name.find_last_of('/') + 1);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  if (!Config::LoadOptions(argc, argv)) {
+    return 1;
+  }
+
+  std::ifstream File(Config::TracePath, std::ios::binary);
+  if (!File) {
+    fmt::print(stderr, "Couldn't open {}\n", Config::TracePath);
+    return 1;
+  }
+  const std::vector<char> Data {std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()};
+
+  TraceSummary Trace;
+  if (!Parse(Data, Trace)) {
+    return 1;
+  }
+
+  // Times are reported in microseconds if the trace covers enough time to derive the counter frequency, raw cycles otherwise
+  const auto ElapsedNS = Trace.LastClock.MonotonicNS - Trace.FirstClock.MonotonicNS;
+  const double CyclesPerUS = ElapsedNS ? (Trace.LastClock.Cycles - Trace.FirstClock.Cycles) * 1000.0 / ElapsedNS : 0.0;
+  const char* Unit = CyclesPerUS ? "us" : "cycles";
+  const auto Time = [&](uint64_t Cycles) {
+    return CyclesPerUS ? Cycles / CyclesPerUS : static_cast<double>(Cycles);
+  };
+  const auto Percent = [](uint64_t Part, uint64_t Total) {
+    return Total ? 100.0 * Part / Total : 0.0;
+  };
+
+  const auto JITCount = Trace.SourceCounts[static_cast<size_t>(BlockSource::JIT)];
+  fmt::print("Blocks: {} compiled ({} raced), {} disk cache hits, {} lookup cache hits", JITCount, Trace.Raced,
+             Trace.SourceCounts[static_cast<size_t>(BlockSource::DiskCache)], Trace.SourceCounts[static_cast<size_t>(BlockSource::LookupCache)]);
+  if (Trace.Dropped) {
+    fmt::print(", {} records dropped", Trace.Dropped);
+  }
+  fmt::print("\n");
+
+  if (JITCount) {
+    fmt::print("Compile time: {:.0f} {} total, {:.1f} {} per block\n", Time(Trace.JITCycles), Unit, Time(Trace.JITCycles) / JITCount, Unit);
+    fmt::print("Expansion: {:.2f} IR ops and {:.2f} host bytes per guest instruction\n\n",
+               Trace.GuestInstructions ? double(Trace.IROps) / Trace.GuestInstructions : 0.0,
+               Trace.GuestInstructions ? double(Trace.HostBytes) / Trace.GuestInstructions : 0.0);
+
+    fmt::print("{:<10} {:>14} {:>7} {:>12}\n", "Stage", fmt::format("Total {}", Unit), "Share", fmt::format("{}/block", Unit));
+    uint64_t StageTotal = 0;
+    for (size_t i = 0; i < NUM_STAGES; ++i) {
+      StageTotal += Trace.StageCycles[i];
+      fmt::print("{:<10} {:>14.0f} {:>6.2f}% {:>12.2f}\n", StageNames[i], Time(Trace.StageCycles[i]),
+                 Percent(Trace.StageCycles[i], Trace.JITCycles), Time(Trace.StageCycles[i]) / JITCount);
+    }
+    const auto Other = Trace.JITCycles - std::min(StageTotal, Trace.JITCycles);
+    fmt::print("{:<10} {:>14.0f} {:>6.2f}% {:>12.2f}\n\n", "Other", Time(Other), Percent(Other, Trace.JITCycles), Time(Other) / JITCount);
+  }
+
+  std::vector<std::pair<uint32_t, ModuleTotals>> Modules(Trace.PerModule.begin(), Trace.PerModule.end());
+  std::ranges::sort(Modules, [](const auto& LHS, const auto& RHS) { return LHS.second.Cycles > RHS.second.Cycles; });
+  Modules.resize(std::min<size_t>(Modules.size(), Config::TopCount));
+
+  fmt::print("{:>14} {:>10} {:>10} {:>10}  {}\n", fmt::format("Total {}", Unit), "Compiles", "DiskCache", "Lookup", "Module");
+  for (const auto& [ModuleID, Totals] : Modules) {
+    fmt::print("{:>14.0f} {:>10} {:>10} {:>10}  {}\n", Time(Totals.Cycles), Totals.Compiles, Totals.DiskCacheHits, Totals.LookupCacheHits,
+               ModuleName(Trace, ModuleID));
+  }
+  fmt::print("\n");
+
+  std::vector<std::pair<std::pair<uint32_t, uint64_t>, BlockTotals>> Blocks(Trace.Blocks.begin(), Trace.Blocks.end());
+  std::ranges::sort(Blocks, [](const auto& LHS, const auto& RHS) { return LHS.second.Cycles > RHS.second.Cycles; });
+  Blocks.resize(std::min<size_t>(Blocks.size(), Config::TopCount));
+
+  fmt::print("{:>14} {:>9} {:>6} {:>6} {:>7}  {}\n", fmt::format("Total {}", Unit), "Compiles", "Guest", "IR", "Host", "Block");
+  for (const auto& [Key, Totals] : Blocks) {
+    const auto& [ModuleID, Offset] = Key;
+    const auto Name = ModuleID == INVALID_MODULE_ID ? fmt::format("{:#x}", Offset) : fmt::format("{}+{:#x}", ModuleName(Trace, ModuleID), Offset);
+    fmt::print("{:>14.0f} {:>9} {:>6} {:>6} {:>7}  {}\n", Time(Totals.Cycles), Totals.Compiles, Totals.GuestInstructions, Totals.IROps,
+               Totals.HostBytes, Name);
+  }
+
+  return 0;
+}
@@ -29,13 +29,21 @@
 #include <fmt/printf.h>
 #include <libgen.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <fcntl.h>
 #include <fstream>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <thread>
 
 #ifndef _WIN32
 #include <sys/mman.h>
+#include <sys/wait.h>
 #else
 #include <Common/CPUFeatures.h>
 #include <Common/Handle.h>
@@ -395,9 +403,85 @@ struct winsize {
 };
 #endif
 
+// Compiles the given blocks, sharding the list across NumThreads compile threads that share the Context's CodeBuffer.
+// Returns all threads that took part so their relocations can be merged when saving, see DestroyCompileThreads.
+static std::vector<FEXCore::Core::InternalThreadState*>
+CompileBlocks(FEXCore::Context::Context& CTX, AOTSyscallHandler& SyscallHandler, bool Is64Bit, const fextl::set<uintptr_t>& BlockList,
+              uint32_t NumThreads) {
+  FEX_CONFIG_OPT(MaxInst, MAXINST);
+
+  const std::vector<uintptr_t> Blocks(BlockList.begin(), BlockList.end());
+  std::atomic<size_t> NextBlock {0};
+  std::atomic<size_t> BlocksDone {0};
+  std::atomic<size_t> ReportedDecile {0};
+  const auto StartTime = std::chrono::steady_clock::now();
+
+  auto CompileLoop = [&](FEXCore::Core::InternalThreadState* CompileThread) {
+    for (size_t i = NextBlock.fetch_add(1); i < Blocks.size(); i = NextBlock.fetch_add(1)) {
+      auto Addr = Blocks[i] + SyscallHandler.VAFileStart;
+      if (CTX.CheckIfBlockIsCacheable(*CompileThread, Addr, MaxInst)) {
+        CTX.CompileRIP(CompileThread, Addr);
+      }
+
+      // Report progress in 10% steps
+      const auto Done = BlocksDone.fetch_add(1) + 1;
+      const auto Decile = Done * 10 / Blocks.size();
+      auto Reported = ReportedDecile.load(std::memory_order_relaxed);
+      if (Decile > Reported && ReportedDecile.compare_exchange_strong(Reported, Decile)) {
+        const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - StartTime;
+        fmt::print(stderr, "  {:3}% ({}/{} blocks, {:.0f} blocks/s)\n", Decile * 10, Done, Blocks.size(), Done / Elapsed.count());
+      }
+    }
+  };
+
+  std::vector<FEXCore::Core::InternalThreadState*> CompileThreads {Thread};
+  NumThreads = std::clamp<uint32_t>(NumThreads, 1, std::max<size_t>(Blocks.size(), 1));
+  for (uint32_t i = 1; i < NumThreads; ++i) {
+    CompileThreads.push_back(SetupCompileThread(CTX, Is64Bit));
+  }
+
+  std::vector<std::thread> Workers;
+  for (auto* CompileThread : CompileThreads | std::views::drop(1)) {
+    Workers.emplace_back(CompileLoop, CompileThread);
+  }
+  CompileLoop(Thread);
+  for (auto& Worker : Workers) {
+    Worker.join();
+  }
+
+  const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - StartTime;
+  fmt::print(stderr, "Compiled {} blocks in {:.2f}s on {} thread{} ({:.0f} blocks/s)\n", Blocks.size(), Elapsed.count(), NumThreads,
+             NumThreads == 1 ? "" : "s", Blocks.size() / std::max(Elapsed.count(), 1e-9));
+  return CompileThreads;
+}
+
+// Destroys the threads returned by CompileBlocks, including the main compile thread
+static void DestroyCompileThreads(FEXCore::Context::Context& CTX, std::span<FEXCore::Core::InternalThreadState* const> CompileThreads) {
+  for (auto* CompileThread : CompileThreads) {
+    CTX.DestroyThread(CompileThread);
+  }
+  Thread = nullptr;
+}
+
+#ifdef _WIN32
+static bool IsWine() {
+  const auto NtDll = GetModuleHandleW(L"ntdll.dll");
+  return !!GetProcAddress(NtDll, "wine_get_version");
+}
+#endif
+
+static FEXCore::HostFeatures FetchHostFeatures(bool Is64Bit) {
+#ifndef _WIN32
+  return FEX::FetchHostFeatures();
+#else
+  return FEX::Windows::CPUFeatures::FetchHostFeatures(
+    IsWine(), Is64Bit ? FEXCore::HostFeatures::HostTypeEnum::Arm64ec : FEXCore::HostFeatures::HostTypeEnum::Wow64);
+#endif
+}
+
 // Returns filename of generated cache on success
-static std::optional<std::string> GenerateSingleCache(FEXCore::ExecutableFileInfo& Binary, uint64_t CodeCacheConfigId,
-                                                      fextl::set<uintptr_t> BlockList, std::string_view OutDir) {
+static std::optional<std::string> GenerateSingleCache(FEXCore::ExecutableFileInfo& Binary, fextl::set<uintptr_t> BlockList,
+                                                      std::string_view OutDir, uint32_t NumThreads, bool ReuseExisting) {
 #ifndef _WIN32
   ELFCodeLoader Loader(Binary.Filename.c_str(), -1, "", fextl::vector<fextl::string> {Binary.Filename.c_str()},
                        fextl::vector<fextl::string> {}, nullptr, nullptr, true /* skip interpreter */);
@@ -411,21 +495,11 @@ static std::optional<std::string> GenerateSingleCache(FEXCore::ExecutableFileInf
 #endif
   FEXCore::Config::Set(FEXCore::Config::CONFIG_IS64BIT_MODE, Is64Bit ? "1" : "0");
 
-  // Load HostFeatures
-#ifndef _WIN32
-  auto HostFeatures = FEX::FetchHostFeatures();
-#else
-  const auto NtDll = GetModuleHandleW(L"ntdll.dll");
-  const bool IsWine = !!GetProcAddress(NtDll, "wine_get_version");
-  auto HostFeatures = FEX::Windows::CPUFeatures::FetchHostFeatures(
-    IsWine, Is64Bit ? FEXCore::HostFeatures::HostTypeEnum::Arm64ec : FEXCore::HostFeatures::HostTypeEnum::Wow64);
-#endif
-
-  auto CTX = FEXCore::Context::Context::CreateNewContext(HostFeatures);
+  auto CTX = FEXCore::Context::Context::CreateNewContext(FetchHostFeatures(Is64Bit));
   CTX->GetCodeCache().InitiateCacheGeneration();
 
 #ifdef _WIN32
-  OvercommitTracker = std::make_unique<FEX::Windows::OvercommitTracker>(IsWine);
+  OvercommitTracker = std::make_unique<FEX::Windows::OvercommitTracker>(IsWine());
 
   auto SyscallOSABI = FEXCore::HLE::SyscallOSABI::OS_GENERIC;
   auto SyscallHandler = std::make_unique<AOTSyscallHandler>(*CTX, SyscallOSABI);
@@ -476,6 +550,7 @@ static std::optional<std::string> GenerateSingleCache(FEXCore::ExecutableFileInf
   if (!CTX->InitCore()) {
     return std::nullopt;
   }
+  const auto CodeCacheConfigId = CTX->GetCodeCache().GetConfigId();
 
   Thread = SetupCompileThread(*CTX, Is64Bit);
 
@@ -518,29 +593,51 @@ static std::optional<std::string> GenerateSingleCache(FEXCore::ExecutableFileInf
                          *min_val, *max_val, Binary.Filename, Binary.FileId, SyscallHandler->VAFileStart);
     }
 
-    fmt::print(stderr, "Compiling code...\n");
-
-    FEX_CONFIG_OPT(MaxInst, MAXINST);
-    for (auto Addr : BlockList) {
-      if (!CTX->CheckIfBlockIsCacheable(*Thread, Addr + SyscallHandler->VAFileStart, MaxInst)) {
-        continue;
+    auto Filename = fmt::format("{}{}-{:016x}", OutDir, FEXCore::CodeMap::GetBaseFilename(Binary, false), CodeCacheConfigId);
+    auto Entry = SyscallHandler->LookupExecutableFileSection(Thread, SyscallHandler->VAFileStart).value();
+
+    // Carry over blocks from the existing cache if their guest code didn't change, so only new blocks need compiling
+    std::error_code ec;
+    const auto PreviousCacheSize = std::filesystem::file_size(Filename, ec);
+    if (ReuseExisting && !ec) {
+      std::vector<std::byte> PreviousCache(PreviousCacheSize);
+      std::ifstream PreviousCacheFile(Filename, std::ios_base::binary);
+      if (PreviousCacheFile.read(reinterpret_cast<char*>(PreviousCache.data()), PreviousCache.size())) {
+        const auto NumBlocks = BlockList.size();
+        auto ImportedBlocks = CTX->GetCodeCache().ImportBlocks(Thread, PreviousCache, Entry, BlockList);
+        for (auto Block : ImportedBlocks) {
+          BlockList.erase(Block);
+        }
+        fmt::print(stderr, "Reusing {} of {} blocks from previous cache\n", ImportedBlocks.size(), NumBlocks);
       }
-
-      CTX->CompileRIP(Thread, Addr + SyscallHandler->VAFileStart);
     }
 
-    auto Filename = fmt::format("{}{}-{:016x}", OutDir, FEXCore::CodeMap::GetBaseFilename(Binary, false), CodeCacheConfigId);
+    fmt::print(stderr, "Compiling code...\n");
+
+#ifndef _WIN32
+    auto CompileThreads = CompileBlocks(*CTX, *SyscallHandler, Is64Bit, BlockList, NumThreads);
+#else
+    // The JIT guard page handler only knows about the main compile thread, so don't shard on Windows
+    auto CompileThreads = CompileBlocks(*CTX, *SyscallHandler, Is64Bit, BlockList, 1);
+#endif
+
     auto FilenameNew = Filename + ".new";
-    int fd = open(FilenameNew.c_str(), O_CREAT | O_WRONLY | O_BINARY, 0644);
-    {
-      auto Entry = SyscallHandler->LookupExecutableFileSection(Thread, SyscallHandler->VAFileStart).value();
+    int fd = open(FilenameNew.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_BINARY, 0644);
 #ifndef _WIN32
-      CTX->GetCodeCache().SaveData(*Thread, fd, Entry, 0 /* TODO: Use static base address information if available */);
+    const bool Saved =
+      fd != -1 && CTX->GetCodeCache().SaveData(CompileThreads, fd, Entry, 0 /* TODO: Use static base address information if available */);
 #else
-      CTX->GetCodeCache().SaveData(*Thread, fd, Entry, SyscallHandler->VAFileStart);
+    const bool Saved = fd != -1 && CTX->GetCodeCache().SaveData(CompileThreads, fd, Entry, SyscallHandler->VAFileStart);
 #endif
+    DestroyCompileThreads(*CTX, CompileThreads);
+    if (fd != -1) {
+      close(fd);
+    }
+    if (!Saved) {
+      fmt::print(stderr, "Failed to write cache {}\n", FilenameNew);
+      std::filesystem::remove(FilenameNew.c_str(), ec);
+      return std::nullopt;
     }
-    close(fd);
     std::filesystem::rename(FilenameNew.c_str(), Filename.c_str());
     return Filename;
   }
@@ -552,6 +649,15 @@ static int GenerateCache(int argc, const char** argv) {
   optparse::OptionParser Parser {};
   Parser.add_option("--outdir").set_default(FEX::Config::GetCacheDirectory() + "cache").help("Output directory for generated cache files");
   Parser.add_option("--fileid").help("Select binary to generate cache for");
+  Parser.add_option("--app").set_default("").help("Application name to load per-app configuration for");
+  Parser.add_option("--threads")
+    .type("int")
+    .set_default(1)
+    .help("Number of threads to shard block compilation across. Block layout is only deterministic with 1");
+  Parser.add_option("--rebuild")
+    .action("store_true")
+    .set_default(false)
+    .help("Recompile all blocks instead of reusing unchanged blocks from an existing cache");
 
   optparse::Values Options = Parser.parse_args(argc, argv);
   if (Parser.args().size() != 1) {
@@ -614,10 +720,12 @@ static int GenerateCache(int argc, const char** argv) {
   const auto PortableInfo = FEX::ReadPortabilityInformation();
   char* envp[] = {nullptr};
   FEXCore::Config::Shutdown();
-  FEX::Config::LoadConfig("", envp, PortableInfo);
+  FEX::Config::LoadConfig((fextl::string)Options.get("app"), envp, PortableInfo);
 
   auto NumBlocks = Data.at(ProgramName).size();
-  auto GeneratedCache = GenerateSingleCache(ProgramName, 0 /* TODO: Config id */, Data.at(ProgramName), OutDir);
+  const int NumThreads = Options.get("threads");
+  const bool Rebuild = Options.get("rebuild");
+  auto GeneratedCache = GenerateSingleCache(ProgramName, Data.at(ProgramName), OutDir, std::max(NumThreads, 1), !Rebuild);
   if (GeneratedCache) {
     fmt::print("Successfully populated cache {} ({} blocks) via {}\n\n", GeneratedCache.value(), NumBlocks,
                std::filesystem::path {CodeMapPath}.filename().string());
@@ -757,7 +865,158 @@ static void AggregateCodeMaps(const std::string& NewCodeMapDirectory, const std:
   }
 }
 
-static int ProcessAll() {
+// Checks the header of an existing cache file for a matching FEX version and configuration
+static bool IsCompatibleCacheFile(const std::string& Filename, uint64_t CodeCacheConfigId) {
+  std::array<std::byte, 4096> Header {};
+  std::ifstream File(Filename, std::ios_base::binary);
+  File.read(reinterpret_cast<char*>(Header.data()), Header.size());
+  return FEXCore::AbstractCodeCache::IsCompatibleCacheFile(std::span {Header.data(), static_cast<size_t>(File.gcount())}, CodeCacheConfigId);
+}
+
+struct PendingCacheJob {
+  std::string BinaryName;
+  std::string AppName;
+  std::string FileIdArg;
+  std::string MergedCodeMapFilename;
+#ifdef _WIN32
+  std::string SelfPath;
+#endif
+};
+
+/**
+ * Runs the given cache generation jobs, up to MaxJobs at a time in separate processes.
+ *
+ * Returns the number of failed jobs.
+ */
+static size_t RunCacheJobs(const std::vector<PendingCacheJob>& Jobs, const fextl::string& OutDir, uint32_t MaxJobs, uint32_t NumThreads) {
+  const auto ThreadsArg = fmt::format("{}", NumThreads);
+  const auto StartTime = std::chrono::steady_clock::now();
+  size_t Finished = 0;
+  size_t Failed = 0;
+
+  auto ReportFinished = [&](const PendingCacheJob& Job, bool Success) {
+    ++Finished;
+    const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - StartTime;
+    if (Success) {
+      fmt::println("  [{}/{}] Finished cache: {} ({:.1f}s elapsed)", Finished, Jobs.size(), Job.BinaryName, Elapsed.count());
+    } else {
+      ++Failed;
+      fmt::println("ERROR: Cache generation failed for {}", Job.BinaryName);
+    }
+  };
+
+  auto GetGenerateArgs = [&](const PendingCacheJob& Job) {
+    return std::vector<const char*> {
+      "generate",  "--fileid", Job.FileIdArg.c_str(), "--app", Job.AppName.c_str(), "--outdir", OutDir.c_str(),
+      "--threads", ThreadsArg.c_str(), Job.MergedCodeMapFilename.c_str(),
+    };
+  };
+
+#ifndef _WIN32
+  if (MaxJobs <= 1) {
+    for (auto& Job : Jobs) {
+      auto GenerateArgs = GetGenerateArgs(Job);
+      ReportFinished(Job, GenerateCache(GenerateArgs.size(), GenerateArgs.data()) == 0);
+    }
+  } else {
+    // Each job runs in a forked child, which also keeps per-binary process state (config, allocator hooks) isolated
+    std::map<pid_t, const PendingCacheJob*> Running;
+    auto WaitForOne = [&]() {
+      int Status {};
+      pid_t pid = waitpid(-1, &Status, 0);
+      if (pid == -1) {
+        if (errno != EINTR) {
+          // Nothing left to wait on, treat anything still tracked as failed
+          for (auto& [_, Job] : Running) {
+            ReportFinished(*Job, false);
+          }
+          Running.clear();
+        }
+        return;
+      }
+      auto It = Running.find(pid);
+      if (It == Running.end()) {
+        return;
+      }
+      ReportFinished(*It->second, WIFEXITED(Status) && WEXITSTATUS(Status) == 0);
+      Running.erase(It);
+    };
+
+    for (auto& Job : Jobs) {
+      while (Running.size() >= MaxJobs) {
+        WaitForOne();
+      }
+
+      fflush(stdout);
+      fflush(stderr);
+      pid_t pid = fork();
+      if (pid == 0) {
+        auto GenerateArgs = GetGenerateArgs(Job);
+        int Result = GenerateCache(GenerateArgs.size(), GenerateArgs.data());
+        fflush(stdout);
+        fflush(stderr);
+        _exit(Result);
+      } else if (pid == -1) {
+        // Couldn't spawn a worker, fall back to running this job in-process
+        auto GenerateArgs = GetGenerateArgs(Job);
+        ReportFinished(Job, GenerateCache(GenerateArgs.size(), GenerateArgs.data()) == 0);
+      } else {
+        Running.emplace(pid, &Job);
+      }
+    }
+
+    while (!Running.empty()) {
+      WaitForOne();
+    }
+  }
+#else
+  // For WoA, spawn a subprocess for each cache generation run.
+  // This ensures robustness and allows for switching FEXOfflineCompiler between WoW64 and ARM64EC.
+  std::deque<std::pair<intptr_t, const PendingCacheJob*>> Running;
+  auto WaitForOldest = [&]() {
+    auto [Handle, Job] = Running.front();
+    Running.pop_front();
+    int Status {};
+    ReportFinished(*Job, _cwait(&Status, Handle, 0) != -1 && Status == 0);
+  };
+
+  for (auto& Job : Jobs) {
+    while (Running.size() >= std::max<uint32_t>(MaxJobs, 1)) {
+      WaitForOldest();
+    }
+
+    auto GenerateArgs = GetGenerateArgs(Job);
+    GenerateArgs.insert(GenerateArgs.begin(), Job.SelfPath.c_str());
+    GenerateArgs.push_back(nullptr);
+    auto Handle = _spawnv(_P_NOWAIT, Job.SelfPath.c_str(), GenerateArgs.data());
+    if (Handle == -1) {
+      ReportFinished(Job, false);
+      continue;
+    }
+    Running.emplace_back(Handle, &Job);
+  }
+
+  while (!Running.empty()) {
+    WaitForOldest();
+  }
+#endif
+
+  if (!Jobs.empty()) {
+    const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - StartTime;
+    fmt::println("\nGenerated {} of {} caches in {:.1f}s using {} job{}", Jobs.size() - Failed, Jobs.size(), Elapsed.count(), MaxJobs,
+                 MaxJobs == 1 ? "" : "s");
+  }
+  return Failed;
+}
+
+static int ProcessAll(int argc, const char** argv) {
+  optparse::OptionParser Parser {};
+  Parser.add_option("-j", "--jobs").type("int").set_default(1).help("Number of caches to generate in parallel worker processes");
+  Parser.add_option("--threads").type("int").set_default(1).help("Number of compile threads to use per cache");
+  optparse::Values Options = Parser.parse_args(argc, argv);
+  const int MaxJobs = Options.get("jobs");
+  const int NumThreads = Options.get("threads");
+
   const auto CacheDirectory = FEX::Config::GetCacheDirectory();
   const std::string NewCodeMapDirectory = fmt::format("{}codemap/new", CacheDirectory);
   const std::string ReadyCodeMapDirectory = fmt::format("{}codemap/ready", CacheDirectory);
@@ -770,6 +1029,10 @@ static int ProcessAll() {
   fextl::string OutDir = CacheDirectory + "cache/";
   std::filesystem::create_directories(OutDir);
 
+  std::vector<PendingCacheJob> Jobs;
+  std::set<std::pair<FEXCore::CodeMapFileId, uint64_t>> QueuedCaches;
+  const auto PortableInfo = FEX::ReadPortabilityInformation();
+
   // Iterate over all executables (.exe).
   // These determine the emulator configuration to use when compiling dependencies.
   for (auto& Entry : std::filesystem::directory_iterator(ReadyCodeMapDirectory)) {
@@ -782,8 +1045,6 @@ static int ProcessAll() {
     }
 
 #ifdef _WIN32
-    // For WoA, spawn a subprocess for each cache generation run.
-    // This ensures robustness and allows for switching FEXOfflineCompiler between WoW64 and ARM64EC.
     char SelfPathRaw[PATH_MAX];
     GetModuleFileNameA(nullptr, SelfPathRaw, sizeof(SelfPathRaw));
     std::string SelfPath = SelfPathRaw;
@@ -793,8 +1054,14 @@ static int ProcessAll() {
 
     fmt::println("\nChecking caches for executable {}", ExecutableIt->second.Filename);
 
-    // TODO: Compute the cache config id from the active FEX configuration
-    uint64_t CodeCacheConfigId = 0;
+    // Dependencies are compiled with the executable's per-app configuration, so compute the config id for that
+    const auto AppName = std::filesystem::path {ExecutableIt->second.Filename}.filename().string();
+    const bool Is64Bit = ExecutableIt->second.ExecutableBitness.value() == 64;
+    char* envp[] = {nullptr};
+    FEXCore::Config::Shutdown();
+    FEX::Config::LoadConfig(fextl::string {AppName}, envp, PortableInfo);
+    FEXCore::Config::Set(FEXCore::Config::CONFIG_IS64BIT_MODE, Is64Bit ? "1" : "0");
+    const uint64_t CodeCacheConfigId = FEXCore::AbstractCodeCache::ComputeConfigId(FetchHostFeatures(Is64Bit));
 
     auto GetCacheFilename = [&](const FEXCore::ExecutableFileInfo& File) {
       return fmt::format("{}{}-{:016x}", OutDir, FEXCore::CodeMap::GetBaseFilename(File, false), CodeCacheConfigId);
@@ -812,36 +1079,36 @@ static int ProcessAll() {
         continue;
       }
 
-      if (std::filesystem::last_write_time(GetCacheFilename(File), ec) > LastCodeMapUpdate && !ec) {
+      const auto CacheFilename = GetCacheFilename(File);
+      const auto LastCacheUpdate = std::filesystem::last_write_time(CacheFilename, ec);
+      const bool IsCompatible = !ec && IsCompatibleCacheFile(CacheFilename, CodeCacheConfigId);
+      if (IsCompatible && LastCacheUpdate > LastCodeMapUpdate) {
         fmt::println("  Cache up to date: {}", BinaryName);
         continue;
       }
 
-      // TODO: Also check for matching FEX version from cache header
+      if (!QueuedCaches.emplace(FileId, CodeCacheConfigId).second) {
+        // Shared dependency that another executable already queued; parallel jobs must not write the same cache file
+        continue;
+      }
 
-      fmt::println("  {} cache: {}", ec ? "Generating" : "Updating outdated", BinaryName);
+      fmt::println("  {} cache: {}", ec ? "Generating" : IsCompatible ? "Updating outdated" : "Regenerating incompatible", BinaryName);
 
       // Defer to GenerateCache
-      const auto FileIdArg = fmt::format("{:016x}", FileId);
-      std::vector<const char*> GenerateArgs {
-        "generate", "--fileid", FileIdArg.c_str(), "--outdir", OutDir.c_str(), MergedCodeMapFilename.c_str(),
-      };
-#ifndef _WIN32
-      if (GenerateCache(GenerateArgs.size(), GenerateArgs.data()) != 0) {
-        fmt::println("ERROR: Cache generation failed for {}", BinaryName);
-      }
-#else
-      GenerateArgs.insert(GenerateArgs.begin(), SelfPath.c_str());
-      GenerateArgs.push_back(nullptr);
-      auto Status = _spawnv(_P_WAIT, SelfPath.c_str(), GenerateArgs.data());
-      if (Status) {
-        fmt::println("ERROR: Cache generation failed for {}", BinaryName);
-      }
+      Jobs.push_back({
+        .BinaryName = std::string {BinaryName},
+        .AppName = AppName,
+        .FileIdArg = fmt::format("{:016x}", FileId),
+        .MergedCodeMapFilename = MergedCodeMapFilename,
+#ifdef _WIN32
+        .SelfPath = SelfPath,
 #endif
+      });
     }
   }
 
-  return 0;
+  const auto Failed = RunCacheJobs(Jobs, OutDir, std::max(MaxJobs, 1), std::max(NumThreads, 1));
+  return Failed ? 1 : 0;
 }
 
 int main(int argc, char** argv) {
@@ -861,12 +1128,12 @@ int main(int argc, char** argv) {
   if (argc >= 2 && argv[1] == std::string_view {"generate"}) {
     return GenerateCache(argc - 1, Args.data());
   } else if (argc >= 2 && argv[1] == std::string_view {"process-all"}) {
-    return ProcessAll();
+    return ProcessAll(argc - 1, Args.data());
   } else {
     fmt::print("Usage: {} <command>\n\n", basename(argv[0]));
     fmt::print("Commands:\n");
     fmt::print("  generate\tTrigger cache generation from combined code map\n");
-    fmt::print("  process-all\tProcess all new code maps and update all caches\n");
+    fmt::print("  process-all\tProcess all new code maps and update all caches (-j N to generate in parallel)\n");
     return EXIT_FAILURE;
   }
 }
@@ -9,24 +9,35 @@
 #include <Common/FDUtils.h>
 #include <Common/FEXServerClient.h>
 
+#include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/CodeCache.h>
 #include <FEXCore/HLE/SourcecodeResolver.h>
+#include <FEXHeaderUtils/Filesystem.h>
 
 #include <fmt/ranges.h>
 #include <inttypes.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <charconv>
+#include <deque>
 #include <fcntl.h>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <poll.h>
+#include <sched.h>
+#include <set>
 #include <string>
 #include <sys/file.h>
+#include <sys/inotify.h>
 #include <sys/resource.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <sys/wait.h>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <xxhash.h>
@@ -69,6 +80,38 @@ static std::string ReadyCodeMapDirectory;
 // Path to FEXOfflineCompiler executable (inferred from FEXServer install location)
 const std::string OfflineCompilerPath = (std::filesystem::read_symlink("/proc/self/exe").parent_path() / "FEXOfflineCompiler").string();
 
+// Background cache compilation state
+static bool BackgroundCompile {false};
+static uint32_t MaxBackgroundJobs {1};
+static int CodeMapWatchFD {-1};
+
+struct BackgroundCacheJob {
+  std::string CodeMap;
+  std::string AppName;
+  FEXCore::CodeMapFileId FileId;
+};
+static std::deque<BackgroundCacheJob> PendingBackgroundJobs;
+// Code maps of currently running jobs. Only one job may write a given cache at a time.
+static std::set<std::string> RunningBackgroundCodeMaps;
+
+// Write ends of pipes used to notify clients about caches compiled in the background
+static std::vector<int> CacheUpdateSubscribers;
+
+// Code cache configuration ids reported by clients, indexed by main executable
+static std::unordered_map<FEXCore::CodeMapFileId, uint64_t> ClientConfigIds;
+
+// Relocated code cache data published by clients for sharing with other processes.
+// Least recently used entries are dropped once the total size exceeds the limit.
+constexpr size_t MAX_SHARED_CODE_CACHE_BYTES = 512 * 1024 * 1024;
+struct SharedCodeCacheEntry {
+  int FD;
+  size_t Size;
+  uint64_t LastUse;
+};
+static std::map<FEXServerClient::SharedCodeCacheKey, SharedCodeCacheEntry> SharedCodeCaches;
+static size_t SharedCodeCacheBytes {};
+static uint64_t SharedCodeCacheUseCounter {};
+
 void SetWatchFD(int FD) {
   WatchFD = FD;
 }
@@ -306,13 +349,21 @@ static void SendFDSuccessPacket(fasio::tcp_socket& Socket, int FD) {
   write(Socket, Data, ec);
 }
 
+// Code maps that are ready for reading must be non-empty and flock(FLOCK_EX) must succeed:
+// - If empty, we tried generating the cache before the client could even lock it
+// - If exclusively lockable, we know the client either closed or crashed
+static bool IsCodeMapReady(int FD) {
+  struct stat FileStats;
+  if (fstat(FD, &FileStats) != 0 || FileStats.st_size == 0) {
+    return false;
+  }
+  return flock(FD, LOCK_EX | LOCK_NB) == 0;
+}
+
 // Discovers any pending code maps, parses their contents into a runtime data structure, and deletes them
 static std::map<FEXCore::ExecutableFileInfo, fextl::set<uintptr_t>>
 ImportPendingCodeMaps(const FEXCore::ExecutableFileInfo& MainFileId, bool HasMultiblock, std::optional<int>& ExecutableBitness) {
   // Detect code maps by checking file name suffixes by counting up an index.
-  // Code maps that are ready for reading must be non-empty and flock(FLOCK_EX) must succeed:
-  // - If empty, we tried generating the cache before the client could even lock it
-  // - If exclusively lockable, we know the client either closed or crashed
   std::vector<std::string> CodeMaps;
   for (int Index = 0; true; ++Index) {
     auto CodeMap = fmt::format("{}/{}.{}.bin", NewCodeMapDirectory, FEXCore::CodeMap::GetBaseFilename(MainFileId, !HasMultiblock), Index);
@@ -323,9 +374,7 @@ ImportPendingCodeMaps(const FEXCore::ExecutableFileInfo& MainFileId, bool HasMul
 
     // Acquire exclusive lock to ensure the client process is done writing data.
     // Also ensure the file is non-empty, otherwise we're racing the client in acquiring the initial lock.
-    struct stat FileStats;
-    fstat(FD, &FileStats);
-    if (FileStats.st_size == 0 || flock(FD, LOCK_EX | LOCK_NB) != 0) {
+    if (!IsCodeMapReady(FD)) {
       fmt::print("Code map {} is still in use, skipping\n", CodeMap);
       // Still being written to by a client process, so skip this file
       // TODO: Rename from X.n.bin to X.0.bin (once the latter has been removed!) to ensure we'll catch it on next run
@@ -487,11 +536,347 @@ static int32_t EmbedSubprocess(const char* path, char* const* args) {
 /**
  * Spawn a FEXOfflineCompiler instance to generate a code cache from the given code map
  */
-static int RunOfflineCompiler(const char* CodeMap) {
-  const char* ExecveArgs[] = {OfflineCompilerPath.c_str(), "generate", CodeMap, nullptr};
+static int RunOfflineCompiler(const char* CodeMap, const char* AppName) {
+  const char* ExecveArgs[] = {OfflineCompilerPath.c_str(), "generate", "--app", AppName, CodeMap, nullptr};
   return EmbedSubprocess(OfflineCompilerPath.c_str(), const_cast<char* const*>(&ExecveArgs[0]));
 };
 
+static std::string GetCacheFilename(const FEXCore::ExecutableFileInfo& FileId, uint64_t ConfigId) {
+  return fmt::format("{}cache/{}-{:016x}", FEX::Config::GetCacheDirectory(), FEXCore::CodeMap::GetBaseFilename(FileId, false), ConfigId);
+}
+
+/**
+ * Flags any binaries for cache refresh whose code map changed after the cache was generated.
+ *
+ * If the client configuration is unknown, only binaries with new code map data are flagged.
+ */
+static void FindOutdatedCaches(std::map<FEXCore::ExecutableFileInfo, NeedsCacheRefresh>& Binaries, bool HasMultiblock,
+                               std::optional<uint64_t> ConfigId) {
+  if (!ConfigId) {
+    return;
+  }
+
+  for (auto& [FileInfo, NeedsRefresh] : Binaries) {
+    if (NeedsRefresh == NeedsCacheRefresh::Yes) {
+      // Already queued for cache generation, no need for further checks
+      continue;
+    }
+
+    // Trigger cache generation for this file if no cache exists or if the cache is older than the most recent update to its code map
+    std::error_code ec;
+    const auto BinaryName = FEXCore::CodeMap::GetBaseFilename(FileInfo, !HasMultiblock);
+    const auto MergedCodeMapFilename = fmt::format("{}/{}", ReadyCodeMapDirectory, BinaryName);
+    const auto LastCodeMapUpdate = std::filesystem::last_write_time(MergedCodeMapFilename, ec);
+    if (std::filesystem::last_write_time(GetCacheFilename(FileInfo, *ConfigId), ec) < LastCodeMapUpdate || ec) {
+      fmt::println("  Scheduling update for {} cache for {}", ec ? "missing" : "outdated", BinaryName);
+      NeedsRefresh = NeedsCacheRefresh::Yes;
+    }
+  }
+}
+
+static void NotifyCacheUpdate(FEXCore::CodeMapFileId FileId) {
+  const FEXServerClient::CodeCacheUpdateNotification Notification {.FileId = FileId};
+  for (int FD : CacheUpdateSubscribers) {
+    // Pipes are non-blocking. If a client doesn't drain its notifications, it just misses this update.
+    write(FD, &Notification, sizeof(Notification));
+  }
+}
+
+static void OnBackgroundJobFinished(const BackgroundCacheJob& Job, int Status) {
+  RunningBackgroundCodeMaps.erase(Job.CodeMap);
+  if (WIFEXITED(Status) && WEXITSTATUS(Status) == 0) {
+    fmt::println("Finished background cache generation for {}", Job.CodeMap);
+    NotifyCacheUpdate(Job.FileId);
+  } else {
+    fmt::println("ERROR: Background cache generation for {} failed with status {}", Job.CodeMap, Status);
+  }
+}
+
+static void ScheduleBackgroundJobs();
+
+static void SpawnBackgroundJob(BackgroundCacheJob Job) {
+  const char* ExecveArgs[] = {OfflineCompilerPath.c_str(), "generate", "--app", Job.AppName.c_str(), Job.CodeMap.c_str(), nullptr};
+
+  // Only used if pidfd is unavailable, but created up front so a failure doesn't leave an unwatched child behind
+  int StatusPipe[2];
+  if (pipe2(StatusPipe, O_CLOEXEC) == -1) {
+    fmt::println("ERROR: Failed to spawn background cache generation for {}", Job.CodeMap);
+    return;
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    // Only use CPU time that is otherwise idle so running applications aren't slowed down
+    sched_param Param {};
+    sched_setscheduler(0, SCHED_IDLE, &Param);
+    setpriority(PRIO_PROCESS, 0, 19);
+    execvp(ExecveArgs[0], const_cast<char* const*>(&ExecveArgs[0]));
+    _exit(-1);
+  } else if (pid == -1) {
+    close(StatusPipe[0]);
+    close(StatusPipe[1]);
+    fmt::println("ERROR: Failed to spawn background cache generation for {}", Job.CodeMap);
+    return;
+  }
+
+  fmt::println("Generating cache for {} in the background", Job.CodeMap);
+  RunningBackgroundCodeMaps.insert(Job.CodeMap);
+
+  int PidFD = FHU::Syscalls::pidfd_open(pid, 0);
+  if (PidFD == -1) {
+    // Kernel is too old for pidfd. Reap the child on a helper thread instead of blocking the reactor,
+    // and forward its exit status through the pipe so the job is still completed on the reactor thread.
+    std::thread([pid, WriteFD = StatusPipe[1]]() {
+      int32_t Status {};
+      while (waitpid(pid, &Status, 0) == -1 && errno == EINTR)
+        ;
+      write(WriteFD, &Status, sizeof(Status));
+      close(WriteFD);
+    }).detach();
+
+    Reactor.bind_handler(
+      pollfd {
+        .fd = StatusPipe[0],
+        .events = POLLIN,
+        .revents = 0,
+      },
+      [Job = std::move(Job), ReadFD = StatusPipe[0]](fasio::error) {
+        // A short read leaves an invalid status, which is reported as a failure
+        int32_t Status {-1};
+        read(ReadFD, &Status, sizeof(Status));
+        close(ReadFD);
+        OnBackgroundJobFinished(Job, Status);
+        ScheduleBackgroundJobs();
+        return fasio::post_callback::drop;
+      });
+    return;
+  }
+  close(StatusPipe[0]);
+  close(StatusPipe[1]);
+
+  Reactor.bind_handler(
+    pollfd {
+      .fd = PidFD,
+      .events = POLLIN,
+      .revents = 0,
+    },
+    [Job = std::move(Job), pid, PidFD](fasio::error) {
+      int32_t Status {};
+      while (waitpid(pid, &Status, 0) == -1 && errno == EINTR)
+        ;
+      close(PidFD);
+      OnBackgroundJobFinished(Job, Status);
+      ScheduleBackgroundJobs();
+      return fasio::post_callback::drop;
+    });
+}
+
+/**
+ * Starts pending background jobs until the CPU budget is exhausted
+ */
+static void ScheduleBackgroundJobs() {
+  for (auto It = PendingBackgroundJobs.begin(); It != PendingBackgroundJobs.end() && RunningBackgroundCodeMaps.size() < MaxBackgroundJobs;) {
+    if (RunningBackgroundCodeMaps.contains(It->CodeMap)) {
+      // Wait for the running job to finish; the next one will pick up any new blocks
+      ++It;
+      continue;
+    }
+
+    auto Job = std::move(*It);
+    It = PendingBackgroundJobs.erase(It);
+    SpawnBackgroundJob(std::move(Job));
+  }
+}
+
+static void QueueBackgroundJob(std::string CodeMap, std::string AppName, FEXCore::CodeMapFileId FileId) {
+  if (std::ranges::any_of(PendingBackgroundJobs, [&](const BackgroundCacheJob& Job) { return Job.CodeMap == CodeMap; })) {
+    return;
+  }
+  PendingBackgroundJobs.push_back({std::move(CodeMap), std::move(AppName), FileId});
+}
+
+/**
+ * Aggregates new code maps for the given application and generates all caches that became outdated.
+ *
+ * With background compilation, caches are queued for generation and this function returns immediately.
+ */
+static void UpdateCaches(const FEXCore::ExecutableFileInfo& MainFileId, bool HasMultiblock, std::optional<uint64_t> ConfigId) {
+  // Update code maps; any update necessitates an update of the corresponding cache
+  auto Binaries = AggregateCodeMaps(MainFileId, HasMultiblock);
+
+  // Check for other conditions that require a cache refresh even when the code map didn't change
+  FindOutdatedCaches(Binaries, HasMultiblock, ConfigId);
+
+  // Dependencies are compiled using the per-app configuration of the main executable
+  const auto AppName = std::string {FHU::Filesystem::GetFilename(std::string_view {MainFileId.Filename})};
+
+  // Trigger offline-compile for each binary that needs it
+  for (const auto& [File, NeedsRefresh] : Binaries) {
+    if (NeedsRefresh != NeedsCacheRefresh::Yes) {
+      continue;
+    }
+
+    const auto BinaryName = (std::string)FEXCore::CodeMap::GetBaseFilename(File, !HasMultiblock);
+    auto CodeMap = fmt::format("{}/{}", ReadyCodeMapDirectory, BinaryName);
+    if (BackgroundCompile) {
+      QueueBackgroundJob(std::move(CodeMap), AppName, File.FileId);
+      continue;
+    }
+
+    fmt::println("Generating cache for {}", BinaryName);
+    int Status = RunOfflineCompiler(CodeMap.c_str(), AppName.c_str());
+    if (Status != 0) {
+      fmt::println("ERROR: Cache generation failed with status {}", Status);
+    }
+  }
+
+  if (BackgroundCompile) {
+    ScheduleBackgroundJobs();
+  }
+}
+
+// Parses "<Name>-<FileId>[-nomb].<Index>.bin", as created for TYPE_QUERY_CODE_MAP
+static std::optional<std::pair<FEXCore::ExecutableFileInfo, bool>> ParseNewCodeMapFilename(std::string_view Name) {
+  if (!Name.ends_with(".bin")) {
+    return std::nullopt;
+  }
+  Name.remove_suffix(std::string_view {".bin"}.size());
+  auto IndexSeparator = Name.rfind('.');
+  if (IndexSeparator == Name.npos) {
+    return std::nullopt;
+  }
+  Name = Name.substr(0, IndexSeparator);
+
+  const bool HasMultiblock = !Name.ends_with("-nomb");
+  if (!HasMultiblock) {
+    Name.remove_suffix(std::string_view {"-nomb"}.size());
+  }
+
+  auto IdSeparator = Name.rfind('-');
+  if (IdSeparator == Name.npos || Name.size() - IdSeparator - 1 != 16) {
+    return std::nullopt;
+  }
+  FEXCore::CodeMapFileId FileId {};
+  auto [Ptr, ec] = std::from_chars(Name.data() + IdSeparator + 1, Name.data() + Name.size(), FileId, 16);
+  if (ec != std::errc {} || Ptr != Name.data() + Name.size()) {
+    return std::nullopt;
+  }
+
+  return std::pair {FEXCore::ExecutableFileInfo {nullptr, FileId, fextl::string {Name.substr(0, IdSeparator)}}, HasMultiblock};
+}
+
+static void HandleCodeMapWatchEvents() {
+  std::set<std::string> ClosedCodeMaps;
+  alignas(inotify_event) char Buffer[4096];
+  ssize_t Length;
+  while ((Length = read(CodeMapWatchFD, Buffer, sizeof(Buffer))) > 0) {
+    for (char* Ptr = Buffer; Ptr < Buffer + Length;) {
+      auto Event = reinterpret_cast<const inotify_event*>(Ptr);
+      if (Event->len) {
+        ClosedCodeMaps.emplace(Event->name);
+      }
+      Ptr += sizeof(inotify_event) + Event->len;
+    }
+  }
+
+  // Code maps are closed once by FEXServer right after creating them and once more when the client exits.
+  // Only the latter makes the code map ready for import.
+  std::map<std::pair<FEXCore::CodeMapFileId, bool>, FEXCore::ExecutableFileInfo> Applications;
+  for (auto& Name : ClosedCodeMaps) {
+    auto Parsed = ParseNewCodeMapFilename(Name);
+    if (!Parsed) {
+      continue;
+    }
+
+    int FD = open(fmt::format("{}/{}", NewCodeMapDirectory, Name).c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD == -1) {
+      // Already imported by an earlier request
+      continue;
+    }
+    const bool Ready = IsCodeMapReady(FD);
+    close(FD);
+
+    if (Ready) {
+      auto& [MainFileId, HasMultiblock] = *Parsed;
+      Applications.emplace(std::pair {MainFileId.FileId, HasMultiblock}, std::move(MainFileId));
+    }
+  }
+
+  for (auto& [Key, MainFileId] : Applications) {
+    auto ConfigId = ClientConfigIds.find(MainFileId.FileId);
+    UpdateCaches(MainFileId, Key.second, ConfigId != ClientConfigIds.end() ? std::optional {ConfigId->second} : std::nullopt);
+  }
+}
+
+static void WatchCodeMaps() {
+  std::error_code ec;
+  std::filesystem::create_directories(NewCodeMapDirectory, ec);
+
+  CodeMapWatchFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (CodeMapWatchFD == -1 || inotify_add_watch(CodeMapWatchFD, NewCodeMapDirectory.c_str(), IN_CLOSE_WRITE) == -1) {
+    LogMan::Msg::EFmt("Failed to watch {} for new code maps: {} {}", NewCodeMapDirectory, errno, strerror(errno));
+    if (CodeMapWatchFD != -1) {
+      close(CodeMapWatchFD);
+      CodeMapWatchFD = -1;
+    }
+    return;
+  }
+
+  fmt::println("Compiling code caches in the background using up to {} jobs", MaxBackgroundJobs);
+  Reactor.bind_handler(
+    pollfd {
+      .fd = CodeMapWatchFD,
+      .events = POLLIN,
+      .revents = 0,
+    },
+    [](fasio::error ec) {
+      if (ec != fasio::error::success) {
+        return fasio::post_callback::drop;
+      }
+      HandleCodeMapWatchEvents();
+      return fasio::post_callback::repeat;
+    });
+}
+
+static void PublishSharedCodeCache(const FEXServerClient::SharedCodeCacheKey& Key, int FD) {
+  if (SharedCodeCaches.contains(Key)) {
+    // Another client was faster
+    close(FD);
+    return;
+  }
+
+  // Clients execute this data directly, so only accept immutable memfds created by CreateSharedCodeBuffer that match the key
+  constexpr int RequiredSeals = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+  const int Seals = fcntl(FD, F_GET_SEALS);
+  struct stat FileStats;
+  char Target[64] {};
+  const auto TargetLength = readlink(fmt::format("/proc/self/fd/{}", FD).c_str(), Target, sizeof(Target) - 1);
+  const bool IsCodeCacheMemfd =
+    TargetLength > 0 && std::string_view {Target, static_cast<size_t>(TargetLength)}.starts_with("/memfd:FEXCodeCache");
+  if (!IsCodeCacheMemfd || Seals == -1 || (Seals & RequiredSeals) != RequiredSeals || fstat(FD, &FileStats) != 0 ||
+      !S_ISREG(FileStats.st_mode) || Key.CodeSize == 0 || static_cast<uint64_t>(FileStats.st_size) != Key.CodeSize ||
+      Key.CodeSize > MAX_SHARED_CODE_CACHE_BYTES) {
+    LogMan::Msg::EFmt("Rejecting invalid shared code cache");
+    close(FD);
+    return;
+  }
+
+  const size_t Size = FileStats.st_size;
+  while (SharedCodeCacheBytes + Size > MAX_SHARED_CODE_CACHE_BYTES) {
+    auto Oldest = std::ranges::min_element(SharedCodeCaches, {}, [](auto& Entry) { return Entry.second.LastUse; });
+    SharedCodeCacheBytes -= Oldest->second.Size;
+    close(Oldest->second.FD);
+    SharedCodeCaches.erase(Oldest);
+  }
+
+  SharedCodeCaches[Key] = {FD, Size, ++SharedCodeCacheUseCounter};
+  SharedCodeCacheBytes += Size;
+
+  // Check if we need to increase the FD limit.
+  ++NumFilesOpened;
+  CheckRaiseFDLimit();
+}
+
 static void HandleSocketData(fasio::tcp_socket& Socket) {
   std::vector<uint8_t> Data(1500);
 
@@ -506,7 +891,7 @@ static void HandleSocketData(fasio::tcp_socket& Socket) {
 
     auto Read = Socket.read_some(buffer, ec);
     if (ec == fasio::error::success) {
-      assert(Read >= sizeof(FEXServerClient::FEXServerRequestPacket));
+      assert(Read >= sizeof(FEXServerClient::FEXServerRequestPacket::Header));
       buffer = {buffer.Data.subspan(0, Read)};
     } else if (ec == fasio::error::eof) {
       return;
@@ -572,6 +957,18 @@ static void HandleSocketData(fasio::tcp_socket& Socket) {
       buffer += sizeof(FEXServerClient::FEXServerRequestPacket::BasicRequest);
       break;
     }
+    case FEXServerClient::PacketType::TYPE_GET_ROOTFS_INDEX_FD: {
+      const int FD = SquashFS::GetRootFSIndexFD();
+      if (FD != -1) {
+        SendFDSuccessPacket(Socket, FD);
+      } else {
+        // Not an image, or still being indexed
+        SendEmptyErrorPacket(Socket);
+      }
+
+      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+      break;
+    }
     case FEXServerClient::PacketType::TYPE_GET_PID_FD: {
       int FD = FHU::Syscalls::pidfd_open(::getpid(), 0);
 
@@ -615,45 +1012,9 @@ static void HandleSocketData(fasio::tcp_socket& Socket) {
       FEXCore::ExecutableFileInfo MainFileId = {nullptr, filename_hash, fextl::string(Tmp, TmpLen)};
       fmt::print("Requested {}cache generation for {}\n", HasMultiblock ? "" : "nomb-", MainFileId.Filename);
 
-      auto GetCacheFilename = [](const FEXCore::ExecutableFileInfo& FileId) {
-        return fmt::format("{}cache/{}-{:016x}", FEX::Config::GetCacheDirectory(), FEXCore::CodeMap::GetBaseFilename(FileId, false),
-                           0 /* TODO: Use unique cache id */);
-      };
-
-      // Update code maps; any update necessitates an update of the corresponding cache
-      auto Binaries = AggregateCodeMaps(MainFileId, HasMultiblock);
-
-      // Check for other conditions that require a cache refresh even when the code map didn't change
-      for (auto& [FileInfo, NeedsRefresh] : Binaries) {
-        if (NeedsRefresh == NeedsCacheRefresh::Yes) {
-          // Already queued for cache generation, no need for further checks
-          continue;
-        }
-
-        // Trigger cache generation for this file if no cache exists or if the cache is older than the most recent update to its code map
-        std::error_code ec;
-        const auto BinaryName = FEXCore::CodeMap::GetBaseFilename(FileInfo, !HasMultiblock);
-        const auto MergedCodeMapFilename = fmt::format("{}/{}", ReadyCodeMapDirectory, BinaryName);
-        const auto LastCodeMapUpdate = std::filesystem::last_write_time(MergedCodeMapFilename, ec);
-        if (std::filesystem::last_write_time(GetCacheFilename(FileInfo), ec) < LastCodeMapUpdate || ec) {
-          fmt::println("  Scheduling update for {} cache for {}", ec ? "missing" : "outdated", BinaryName);
-          NeedsRefresh = NeedsCacheRefresh::Yes;
-        }
-      }
-
-      // Trigger offline-compile for each binary that needs it
-      for (const auto& [File, NeedsRefresh] : Binaries) {
-        if (NeedsRefresh != NeedsCacheRefresh::Yes) {
-          continue;
-        }
-
-        const auto BinaryName = (std::string)FEXCore::CodeMap::GetBaseFilename(File, !HasMultiblock);
-        fmt::println("Generating cache for {}", BinaryName);
-        int Status = RunOfflineCompiler(fmt::format("{}/{}", ReadyCodeMapDirectory, BinaryName).c_str());
-        if (Status != 0) {
-          fmt::println("ERROR: Cache generation failed with status {}", Status);
-        }
-      }
+      const uint64_t ConfigId = Req->CodeCache.ConfigId;
+      ClientConfigIds[MainFileId.FileId] = ConfigId;
+      UpdateCaches(MainFileId, HasMultiblock, ConfigId);
 
       FEXServerClient::FEXServerResultPacket Res {
         .Header {
@@ -664,7 +1025,7 @@ static void HandleSocketData(fasio::tcp_socket& Socket) {
       fasio::mutable_buffer Data = {.Data = std::as_writable_bytes(std::span(&Res, 1))};
       fasio::error ec;
       write(Socket, Data, ec);
-      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::CodeCache);
       close(inFD);
       inFD = -1;
       break;
@@ -680,6 +1041,9 @@ static void HandleSocketData(fasio::tcp_socket& Socket) {
       const auto filename_hash = XXH3_64bits(Tmp, TmpLen);
       const bool HasMultiblock = (Req->Header.Type == FEXServerClient::PacketType::TYPE_QUERY_CODE_MAP);
 
+      // Remember the client configuration so that background compilation can check for outdated caches
+      ClientConfigIds[filename_hash] = Req->CodeCache.ConfigId;
+
       FEXServerClient::FEXServerResultPacket Res {
         .Header {
           .Type = FEXServerClient::PacketType::TYPE_SUCCESS,
@@ -704,13 +1068,83 @@ static void HandleSocketData(fasio::tcp_socket& Socket) {
                                     .FD = (CodeMapFD != -1 ? std::optional {&CodeMapFD} : std::nullopt)};
       fasio::error ec;
       write(Socket, Data, ec);
-      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::CodeCache);
       close(inFD);
       inFD = -1;
       close(CodeMapFD);
       break;
     }
 
+    case FEXServerClient::PacketType::TYPE_SUBSCRIBE_CODE_CACHE_UPDATES: {
+      if (BackgroundCompile) {
+        int fds[2] {};
+        pipe2(fds, O_CLOEXEC | O_NONBLOCK);
+        // 0 = Read
+        // 1 = Write
+        SendFDSuccessPacket(Socket, fds[0]);
+
+        // Close the read side now, doesn't matter to us
+        close(fds[0]);
+
+        // Stop notifying once all clients closed the read side
+        CacheUpdateSubscribers.push_back(fds[1]);
+        Reactor.bind_handler(
+          pollfd {
+            .fd = fds[1],
+            .events = 0,
+            .revents = 0,
+          },
+          [FD = fds[1]](fasio::error) {
+            std::erase(CacheUpdateSubscribers, FD);
+            close(FD);
+            return fasio::post_callback::drop;
+          });
+
+        // Check if we need to increase the FD limit.
+        ++NumFilesOpened;
+        CheckRaiseFDLimit();
+      } else {
+        // Caches are only generated on request, so there won't be any updates
+        SendEmptyErrorPacket(Socket);
+      }
+
+      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+      break;
+    }
+
+    case FEXServerClient::PacketType::TYPE_QUERY_SHARED_CODE_CACHE: {
+      auto Entry = SharedCodeCaches.find(Req->SharedCodeCache.Key);
+      if (Entry != SharedCodeCaches.end()) {
+        Entry->second.LastUse = ++SharedCodeCacheUseCounter;
+        SendFDSuccessPacket(Socket, Entry->second.FD);
+      } else {
+        // Not shared yet, the client will publish it
+        SendEmptyErrorPacket(Socket);
+      }
+
+      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::SharedCodeCache);
+      break;
+    }
+
+    case FEXServerClient::PacketType::TYPE_PUBLISH_SHARED_CODE_CACHE: {
+      if (inFD != -1) {
+        PublishSharedCodeCache(Req->SharedCodeCache.Key, inFD);
+        inFD = -1;
+      }
+
+      FEXServerClient::FEXServerResultPacket Res {
+        .Header {
+          .Type = FEXServerClient::PacketType::TYPE_SUCCESS,
+        },
+      };
+
+      fasio::mutable_buffer Data = {.Data = std::as_writable_bytes(std::span(&Res, 1))};
+      fasio::error ec;
+      write(Socket, Data, ec);
+      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::SharedCodeCache);
+      break;
+    }
+
     // Invalid
     case FEXServerClient::PacketType::TYPE_ERROR:
     default:
@@ -758,11 +1192,16 @@ void WaitForRequests() {
       });
   }
 
+  if (BackgroundCompile) {
+    WatchCodeMaps();
+  }
+
   Reactor.enable_async_stop();
 
   while (true) {
     std::optional Timeout = std::chrono::seconds {RequestTimeout};
-    if (Foreground || NumClients > 0) {
+    if (Foreground || NumClients > 0 || !RunningBackgroundCodeMaps.empty()) {
+      // Also stay alive until background jobs are done, since clients may still pick up their results
       Timeout.reset();
     }
     auto Result = Reactor.run_one(Timeout);
@@ -783,6 +1222,13 @@ void SetConfiguration(bool Foreground, uint32_t PersistentTimeout) {
 
   NewCodeMapDirectory = FEX::Config::GetCacheDirectory() + "codemap/new";
   ReadyCodeMapDirectory = FEX::Config::GetCacheDirectory() + "codemap/ready";
+
+  BackgroundCompile = FEXCore::Config::Get_CODECACHEBACKGROUNDCOMPILE()();
+  if (BackgroundCompile) {
+    // Limit concurrent jobs to the configured share of CPU cores
+    const uint32_t Budget = std::clamp<uint32_t>(FEXCore::Config::Get_CODECACHEBACKGROUNDCPUBUDGET()(), 1, 100);
+    MaxBackgroundJobs = std::max<uint32_t>(1, std::thread::hardware_concurrency() * Budget / 100);
+  }
 }
 
 void Shutdown() {
@@ -3,12 +3,14 @@
 
 #include "Common/FEXServerClient.h"
 #include "Common/FileFormatCheck.h"
+#include "Common/RootFSIndex.h"
 
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
+#include <atomic>
 #include <fcntl.h>
 #include <filesystem>
 #include <poll.h>
@@ -23,6 +25,11 @@ static int ServerRootFSLockFD {-1};
 static int FuseMountPID {};
 static fextl::string MountFolder {};
 
+// The image is indexed in the background so that the first client doesn't wait on it
+static std::thread IndexThread;
+static std::atomic<int> IndexFD {-1};
+static std::atomic<bool> CancelIndex {};
+
 static void ShutdownImagePID() {
   if (FuseMountPID) {
     FHU::Syscalls::tgkill(FuseMountPID, FuseMountPID, SIGINT);
@@ -196,6 +203,11 @@ void UnmountRootFS() {
     return;
   }
 
+  CancelIndex = true;
+  if (IndexThread.joinable()) {
+    IndexThread.join();
+  }
+
   SquashFS::ShutdownImagePID();
 
   // Handle final mount removal
@@ -270,10 +282,16 @@ bool InitializeSquashFS() {
     return false;
   }
 
+  IndexThread = std::thread([] { IndexFD = FEX::RootFSIndex::Build(MountFolder, CancelIndex); });
+
   return true;
 }
 
 const fextl::string& GetMountFolder() {
   return MountFolder;
 }
+
+int GetRootFSIndexFD() {
+  return IndexFD;
+}
 } // namespace SquashFS
@@ -6,4 +6,6 @@ namespace SquashFS {
 bool InitializeSquashFS();
 void UnmountRootFS();
 const fextl::string& GetMountFolder();
+// Sealed memfd with the RootFS index, or -1 if it isn't available (yet)
+int GetRootFSIndexFD();
 } // namespace SquashFS
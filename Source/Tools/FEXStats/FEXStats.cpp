@@ -0,0 +1,330 @@
+// SPDX-License-Identifier: MIT
+#include "OptionParser.h"
+
+#include <FEXCore/Utils/SHMStats.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <map>
+#include <signal.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace Config {
+int64_t PID {};
+uint32_t IntervalMS {1000};
+uint32_t Iterations {};
+bool JSON {};
+
+bool LoadOptions(int argc, char** argv) {
+  optparse::OptionParser Parser {};
+  Parser.usage("%prog [options] PID");
+
+  Parser.add_option("-i", "--interval").type("int").set_default(1000).help("Sampling interval in milliseconds");
+  Parser.add_option("-n", "--iterations").type("int").set_default(0).help("Exit after this many samples. 0 runs until the process exits");
+  Parser.add_option("-j", "--json").action("store_true").set_default(false).help("Emit one JSON object per sample instead of a table");
+
+  optparse::Values Options = Parser.parse_args(argc, argv);
+  IntervalMS = std::max(1, static_cast<int>(Options.get("interval")));
+  Iterations = std::max(0, static_cast<int>(Options.get("iterations")));
+  JSON = Options.get("json");
+
+  if (Parser.args().size() != 1) {
+    Parser.print_usage();
+    return false;
+  }
+
+  PID = std::strtoll(Parser.args()[0].c_str(), nullptr, 10);
+  return PID > 0;
+}
+} // namespace Config
+
+// Stats are reported in unscaled cycles of the counter read by FEXCore::SHMStats::GetCycleCounter
+static uint64_t GetCycleCounterFrequency() {
+#ifdef ARCHITECTURE_arm64
+  uint64_t Result {};
+  __asm("mrs %[Res], CNTFRQ_EL0" : [Res] "=r"(Result));
+  return Result;
+#else
+  // The TSC frequency isn't exposed directly, measure it against the monotonic clock
+  const auto Begin = std::chrono::steady_clock::now();
+  const auto BeginCycles = FEXCore::SHMStats::GetCycleCounter();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const auto Cycles = FEXCore::SHMStats::GetCycleCounter() - BeginCycles;
+  const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Begin;
+  return Cycles / Elapsed.count();
+#endif
+}
+
+// Maps the stats region read-only, following it as FEX grows it
+class StatsRegion final {
+public:
+  ~StatsRegion() {
+    if (Base) {
+      munmap(Base, MappedSize);
+    }
+    if (FD != -1) {
+      close(FD);
+    }
+  }
+
+  bool Open(int64_t PID) {
+    FD = shm_open(fmt::format("fex-{}-stats", PID).c_str(), O_RDONLY, 0);
+    if (FD == -1) {
+      fmt::print(stderr, "Couldn't open stats region of PID {}: {}. Is it running with ProfileStats enabled?\n", PID, strerror(errno));
+      return false;
+    }
+    return Remap();
+  }
+
+  // Picks up slots allocated since the last call. The size is taken from the file since the header
+  // is updated after the region has grown, and mapping beyond the end of the file would raise SIGBUS.
+  bool Remap() {
+    struct stat Stat {};
+    if (fstat(FD, &Stat) == -1 || static_cast<size_t>(Stat.st_size) < sizeof(FEXCore::SHMStats::ThreadStatsHeader)) {
+      return false;
+    }
+
+    const size_t Size = Stat.st_size;
+    if (Size == MappedSize) {
+      return true;
+    }
+
+    void* NewBase = mmap(nullptr, Size, PROT_READ, MAP_SHARED, FD, 0);
+    if (NewBase == MAP_FAILED) {
+      return false;
+    }
+    if (Base) {
+      munmap(Base, MappedSize);
+    }
+    Base = NewBase;
+    MappedSize = Size;
+    return true;
+  }
+
+  const FEXCore::SHMStats::ThreadStatsHeader* Header() const {
+    return reinterpret_cast<const FEXCore::SHMStats::ThreadStatsHeader*>(Base);
+  }
+
+  void* Base {};
+  size_t MappedSize {};
+
+private:
+  int FD {-1};
+};
+
+struct ThreadSample {
+  uint64_t JITCount;
+  uint64_t JITTime;
+  uint64_t SignalTime;
+  uint64_t SMCCount;
+  uint64_t SIGBUSCount;
+  uint64_t CacheMissCount;
+  uint64_t CacheLockTime;
+  uint64_t SpinWaitTime;
+  uint64_t DiskCacheWriteBytes;
+};
+
+static ThreadSample Sample(const FEXCore::SHMStats::ThreadStats& Stats) {
+  const auto Load = [](const uint64_t& Value) {
+    return std::atomic_ref(const_cast<uint64_t&>(Value)).load(std::memory_order_relaxed);
+  };
+
+  return {
+    .JITCount = Load(Stats.AccumulatedJITCount),
+    .JITTime = Load(Stats.AccumulatedJITTime),
+    .SignalTime = Load(Stats.AccumulatedSignalTime),
+    .SMCCount = Load(Stats.AccumulatedSMCCount),
+    .SIGBUSCount = Load(Stats.AccumulatedSIGBUSCount),
+    .CacheMissCount = Load(Stats.AccumulatedCacheMissCount),
+    .CacheLockTime = Load(Stats.AccumulatedCacheReadLockTime) + Load(Stats.AccumulatedCacheWriteLockTime),
+    .SpinWaitTime = Load(Stats.AccumulatedSpinWaitTime),
+    .DiskCacheWriteBytes = Load(Stats.AccumulatedDiskCacheWriteBytes),
+  };
+}
+
+struct ThreadRates {
+  uint32_t TID;
+  double JITPerSecond;
+  double SMCPerSecond;
+  double SIGBUSPerSecond;
+  double CacheMissesPerSecond;
+  double DiskCacheWriteKiBPerSecond;
+  // Percentages of the interval
+  double JITTime;
+  double SignalTime;
+  double LockWait;
+  // Guest spin-wait loops waiting in the host instead of spinning
+  double SpinWait;
+};
+
+static ThreadRates ComputeRates(uint32_t TID, const ThreadSample& Previous, const ThreadSample& Current, double Seconds, double CycleFrequency) {
+  const auto Rate = [&](uint64_t ThreadSample::* Member) {
+    return (Current.*Member - Previous.*Member) / Seconds;
+  };
+  const auto Percent = [&](uint64_t ThreadSample::* Member) {
+    return 100.0 * (Current.*Member - Previous.*Member) / (Seconds * CycleFrequency);
+  };
+
+  return {
+    .TID = TID,
+    .JITPerSecond = Rate(&ThreadSample::JITCount),
+    .SMCPerSecond = Rate(&ThreadSample::SMCCount),
+    .SIGBUSPerSecond = Rate(&ThreadSample::SIGBUSCount),
+    .CacheMissesPerSecond = Rate(&ThreadSample::CacheMissCount),
+    .DiskCacheWriteKiBPerSecond = Rate(&ThreadSample::DiskCacheWriteBytes) / 1024.0,
+    .JITTime = Percent(&ThreadSample::JITTime),
+    .SignalTime = Percent(&ThreadSample::SignalTime),
+    .LockWait = Percent(&ThreadSample::CacheLockTime),
+    .SpinWait = Percent(&ThreadSample::SpinWaitTime),
+  };
+}
+
+static const char* AppTypeName(FEXCore::SHMStats::AppType Type) {
+  switch (Type) {
+  case FEXCore::SHMStats::AppType::LINUX_32: return "Linux 32-bit";
+  case FEXCore::SHMStats::AppType::LINUX_64: return "Linux 64-bit";
+  case FEXCore::SHMStats::AppType::WIN_ARM64EC: return "ARM64EC";
+  case FEXCore::SHMStats::AppType::WIN_WOW64: return "WOW64";
+  default: return "Unknown";
+  }
+}
+
+int main(int argc, char** argv) {
+  if (!Config::LoadOptions(argc, argv)) {
+    return 1;
+  }
+
+  StatsRegion Region;
+  if (!Region.Open(Config::PID)) {
+    return 1;
+  }
+
+  const auto Header = Region.Header();
+  if (Header->Version != FEXCore::SHMStats::STATS_VERSION) {
+    fmt::print(stderr, "Unsupported stats version {}, expected {}\n", Header->Version, FEXCore::SHMStats::STATS_VERSION);
+    return 1;
+  }
+
+  const std::string FEXVersion(Header->fex_version, strnlen(Header->fex_version, sizeof(Header->fex_version)));
+  const auto AppType = Header->app_type;
+  const double CycleFrequency = GetCycleCounterFrequency();
+
+  // Keyed by slot offset. Slots are reused after a thread exits, so the TID is checked as well.
+  struct TrackedThread {
+    uint32_t TID;
+    ThreadSample Previous;
+  };
+  std::map<uintptr_t, TrackedThread> Threads;
+
+  auto LastSample = std::chrono::steady_clock::now();
+  const auto CollectSamples = [&](auto&& Callback) {
+    std::map<uintptr_t, TrackedThread> LiveThreads;
+    FEXCore::SHMStats::ForEachThreadStats(Region.Base, Region.MappedSize, [&](const FEXCore::SHMStats::ThreadStats& Stats) {
+      const auto Key = reinterpret_cast<uintptr_t>(&Stats) - reinterpret_cast<uintptr_t>(Region.Base);
+      const uint32_t TID = Stats.TID.load(std::memory_order_relaxed);
+      const auto Current = Sample(Stats);
+
+      auto It = Threads.find(Key);
+      // A reused TID also reuses the slot, in which case the counters restart from zero
+      if (It != Threads.end() && It->second.TID == TID && Current.JITCount >= It->second.Previous.JITCount) {
+        Callback(TID, It->second.Previous, Current);
+      }
+      // Threads that weren't seen in the previous sample only report rates from the next one on
+      LiveThreads.emplace(Key, TrackedThread {TID, Current});
+    });
+    // Exited threads are dropped here
+    Threads = std::move(LiveThreads);
+  };
+
+  // Establish the baseline
+  CollectSamples([](uint32_t, const ThreadSample&, const ThreadSample&) {});
+
+  for (uint32_t Iteration = 0; Config::Iterations == 0 || Iteration < Config::Iterations; ++Iteration) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(Config::IntervalMS));
+
+    if (kill(Config::PID, 0) == -1 && errno == ESRCH) {
+      break;
+    }
+
+    Region.Remap();
+
+    const auto Now = std::chrono::steady_clock::now();
+    const double Seconds = std::chrono::duration<double>(Now - LastSample).count();
+    LastSample = Now;
+
+    std::vector<ThreadRates> Rates;
+    CollectSamples([&](uint32_t TID, const ThreadSample& Previous, const ThreadSample& Current) {
+      Rates.emplace_back(ComputeRates(TID, Previous, Current, Seconds, CycleFrequency));
+    });
+    std::ranges::sort(Rates, [](const auto& LHS, const auto& RHS) { return LHS.JITTime + LHS.LockWait > RHS.JITTime + RHS.LockWait; });
+
+    ThreadRates Total {};
+    for (const auto& Thread : Rates) {
+      Total.JITPerSecond += Thread.JITPerSecond;
+      Total.SMCPerSecond += Thread.SMCPerSecond;
+      Total.SIGBUSPerSecond += Thread.SIGBUSPerSecond;
+      Total.CacheMissesPerSecond += Thread.CacheMissesPerSecond;
+      Total.DiskCacheWriteKiBPerSecond += Thread.DiskCacheWriteKiBPerSecond;
+      Total.JITTime += Thread.JITTime;
+      Total.SignalTime += Thread.SignalTime;
+      Total.LockWait += Thread.LockWait;
+      Total.SpinWait += Thread.SpinWait;
+    }
+
+    // Compile latency percentiles over the lifetime of the live threads
+    FEXCore::SHMStats::LatencyHistogram JITLatency {};
+    FEXCore::SHMStats::MergeThreadHistograms(Region.Base, Region.MappedSize, &FEXCore::SHMStats::ThreadStats::JITTimeHistogram, JITLatency);
+    const auto ToMicroseconds = [&](uint64_t Cycles) {
+      return Cycles * 1'000'000.0 / CycleFrequency;
+    };
+    const double JITp50 = ToMicroseconds(JITLatency.Percentile(50));
+    const double JITp99 = ToMicroseconds(JITLatency.Percentile(99));
+
+    if (Config::JSON) {
+      const auto FormatRates = [](const ThreadRates& Rates) {
+        return fmt::format(R"("jit_per_s":{:.1f},"smc_per_s":{:.1f},"sigbus_per_s":{:.1f},"cache_miss_per_s":{:.1f},)"
+                           R"("disk_cache_write_kib_per_s":{:.1f},"jit_time_pct":{:.2f},"signal_time_pct":{:.2f},"lock_wait_pct":{:.2f},)"
+                           R"("spin_wait_pct":{:.2f})",
+                           Rates.JITPerSecond, Rates.SMCPerSecond, Rates.SIGBUSPerSecond, Rates.CacheMissesPerSecond,
+                           Rates.DiskCacheWriteKiBPerSecond, Rates.JITTime, Rates.SignalTime, Rates.LockWait, Rates.SpinWait);
+      };
+
+      std::string Line = fmt::format(R"({{"pid":{},"interval_s":{:.3f},"jit_p50_us":{:.1f},"jit_p99_us":{:.1f},"total":{{{}}},"threads":[)",
+                                     Config::PID, Seconds, JITp50, JITp99, FormatRates(Total));
+      for (size_t i = 0; i < Rates.size(); ++i) {
+        Line += fmt::format(R"({}{{"tid":{},{}}})", i ? "," : "", Rates[i].TID, FormatRates(Rates[i]));
+      }
+      Line += "]}";
+      fmt::print("{}\n", Line);
+    } else {
+      // Clear the screen and move the cursor to the top left
+      fmt::print("\033[H\033[2J");
+      fmt::print("PID {} ({}, FEX {}) - {} threads - JIT p50 {:.0f}us p99 {:.0f}us\n\n", Config::PID, AppTypeName(AppType), FEXVersion,
+                 Rates.size(), JITp50, JITp99);
+      fmt::print("{:>8} {:>9} {:>9} {:>9} {:>11} {:>11} {:>7} {:>7} {:>7} {:>7}\n", "TID", "JIT/s", "SMC/s", "SIGBUS/s", "CacheMiss/s",
+                 "DiskKiB/s", "JIT%", "Signal%", "Lock%", "Spin%");
+
+      const auto PrintRow = [](std::string_view Name, const ThreadRates& Rates) {
+        fmt::print("{:>8} {:>9.1f} {:>9.1f} {:>9.1f} {:>11.1f} {:>11.1f} {:>6.2f}% {:>6.2f}% {:>6.2f}% {:>6.2f}%\n", Name,
+                   Rates.JITPerSecond, Rates.SMCPerSecond, Rates.SIGBUSPerSecond, Rates.CacheMissesPerSecond,
+                   Rates.DiskCacheWriteKiBPerSecond, Rates.JITTime, Rates.SignalTime, Rates.LockWait, Rates.SpinWait);
+      };
+      PrintRow("Total", Total);
+      for (const auto& Thread : Rates) {
+        PrintRow(std::to_string(Thread.TID), Thread);
+      }
+    }
+    fflush(stdout);
+  }
+
+  return 0;
+}
@@ -29,6 +29,7 @@ $end_info$
 #include <filesystem>
 #include <ostream>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <system_error>
 #include <unistd.h>
 #include <utility>
@@ -514,7 +515,7 @@ static fextl::string GenerateCPUInfo(FEXCore::Context::Context* ctx, uint32_t CP
 EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context* ctx)
   : CTX {ctx}
   , ThreadsConfig {FEX::CPUInfo::CalculateNumberOfCPUs()} {
-  FDReadCreators["/proc/cpuinfo"] = [&](FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode) -> int32_t {
+  FDReadCreators["/proc/cpuinfo"].Func = [&](FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode) -> int32_t {
     // Only allow a single thread to initialize the cpu_info.
     // Jit in-case multiple threads try to initialize at once.
     // Check if deferred cpuinfo initialization has occured.
@@ -527,7 +528,7 @@ EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context* ctx)
     return FD;
   };
 
-  FDReadCreators["/proc/sys/kernel/osrelease"] = [&](FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags,
+  FDReadCreators["/proc/sys/kernel/osrelease"].Func = [&](FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags,
                                                      mode_t mode) -> int32_t {
     int FD = GenTmpFD(pathname, flags);
     uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
@@ -541,7 +542,7 @@ EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context* ctx)
     return FD;
   };
 
-  FDReadCreators["/proc/version"] = [&](FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode) -> int32_t {
+  FDReadCreators["/proc/version"].Func = [&](FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode) -> int32_t {
     int FD = GenTmpFD(pathname, flags);
     // UTS version NEEDS to be in a format that can pass to `date -d`
     // Format of this is Linux version <Release> (<Compile By>@<Compile Host>) (<Linux Compiler>) #<version> {SMP, PREEMPT, PREEMPT_RT} <UTS version>\n"
@@ -559,7 +560,7 @@ EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context* ctx)
 
   // Wine reads this to ensure TSC is trusted by the kernel. Otherwise it falls back to maximum clock speed of the CPU cores.
   // Without this, games like Horizon Zero Dawn would run their physics in slow-motion.
-  FDReadCreators["/sys/devices/system/clocksource/clocksource0/current_clocksource"] =
+  FDReadCreators["/sys/devices/system/clocksource/clocksource0/current_clocksource"].Func =
     [&](FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode) -> int32_t {
     int FD = GenTmpFD(pathname, flags);
     const char source[] = "tsc\n";
@@ -578,13 +579,13 @@ EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context* ctx)
     return FD;
   };
 
-  FDReadCreators["/sys/devices/system/cpu/online"] = NumCPUCores;
-  FDReadCreators["/sys/devices/system/cpu/present"] = NumCPUCores;
+  FDReadCreators["/sys/devices/system/cpu/online"].Func = NumCPUCores;
+  FDReadCreators["/sys/devices/system/cpu/present"].Func = NumCPUCores;
 
   fextl::string procAuxv = fextl::fmt::format("/proc/{}/auxv", getpid());
 
-  FDReadCreators[procAuxv] = &EmulatedFDManager::ProcAuxv;
-  FDReadCreators["/proc/self/auxv"] = &EmulatedFDManager::ProcAuxv;
+  FDReadCreators[procAuxv].Func = &EmulatedFDManager::ProcAuxv;
+  FDReadCreators["/proc/self/auxv"].Func = &EmulatedFDManager::ProcAuxv;
 
   if (ThreadsConfig > 1) {
     cpus_online = fextl::fmt::format("0-{}", ThreadsConfig - 1);
@@ -595,6 +596,65 @@ EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context* ctx)
 
 EmulatedFDManager::~EmulatedFDManager() {}
 
+int32_t EmulatedFDManager::ReopenCachedFD(FDReadCreator& Creator, int flags) {
+  int32_t CachedFD = Creator.CachedFD.load(std::memory_order_acquire);
+  if (CachedFD < 0) {
+    return -1;
+  }
+  const uint64_t Dev = Creator.CachedDev.load(std::memory_order_relaxed);
+  const uint64_t Inode = Creator.CachedInode.load(std::memory_order_relaxed);
+  const auto IsCachedFile = [Dev, Inode](int32_t FD) {
+    struct stat Buffer {};
+    return fstat(FD, &Buffer) == 0 && Buffer.st_dev == Dev && Buffer.st_ino == Inode;
+  };
+
+  // Opening whatever the guest replaced the FD with could block or have side effects, like with a FIFO
+  if (!IsCachedFile(CachedFD)) {
+    // The guest closed or replaced the FD, so the number isn't FEX's to close anymore
+    Creator.CachedFD.compare_exchange_strong(CachedFD, -1, std::memory_order_relaxed);
+    return -1;
+  }
+
+  // The file already exists, so the flags that create or truncate it don't apply.
+  // O_NOFOLLOW is about the guest's path, it would fail on the magic link.
+  const auto Path = fextl::fmt::format("/proc/self/fd/{}", CachedFD);
+  int32_t FD = open(Path.c_str(), flags & ~(O_CREAT | O_TRUNC | O_EXCL | O_NOFOLLOW));
+  if (FD == -1) {
+    return -1;
+  }
+
+  // The guest can still replace the FD between the check and the open
+  if (!IsCachedFile(FD)) {
+    close(FD);
+    return -1;
+  }
+  return FD;
+}
+
+void EmulatedFDManager::CacheFD(FDReadCreator& Creator, int32_t FD) {
+  // Claims the slot first, so the identity always matches the published FD
+  int32_t Expected = -1;
+  if (!Creator.CachedFD.compare_exchange_strong(Expected, -2, std::memory_order_relaxed)) {
+    return;
+  }
+
+  // Shares the guest FD's file description, which doesn't matter as it is only ever reopened.
+  // Kept out of the low numbers that the guest expects its own opens to get.
+  const int32_t CachedFD = fcntl(FD, F_DUPFD_CLOEXEC, CACHED_FD_MINIMUM);
+  struct stat Buffer {};
+  if (CachedFD == -1 || fstat(CachedFD, &Buffer) != 0) {
+    if (CachedFD != -1) {
+      close(CachedFD);
+    }
+    Creator.CachedFD.store(-1, std::memory_order_relaxed);
+    return;
+  }
+
+  Creator.CachedDev.store(Buffer.st_dev, std::memory_order_relaxed);
+  Creator.CachedInode.store(Buffer.st_ino, std::memory_order_relaxed);
+  Creator.CachedFD.store(CachedFD, std::memory_order_release);
+}
+
 int32_t EmulatedFDManager::Open(const char* pathname, int flags, uint32_t mode) {
   auto Creator = FDReadCreators.end();
   if (pathname) {
@@ -605,7 +665,15 @@ int32_t EmulatedFDManager::Open(const char* pathname, int flags, uint32_t mode)
     return -1;
   }
 
-  return Creator->second(CTX, AT_FDCWD, pathname, flags, mode);
+  if (int32_t FD = ReopenCachedFD(Creator->second, flags); FD != -1) {
+    return FD;
+  }
+
+  int32_t FD = Creator->second.Func(CTX, AT_FDCWD, pathname, flags, mode);
+  if (FD != -1) {
+    CacheFD(Creator->second, FD);
+  }
+  return FD;
 }
 
 int32_t EmulatedFDManager::ProcAuxv(FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode) {
@@ -10,6 +10,7 @@ $end_info$
 #include <FEXCore/fextl/unordered_map.h>
 #include <FEXCore/fextl/string.h>
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <sys/types.h>
@@ -24,6 +25,9 @@ public:
   EmulatedFDManager(FEXCore::Context::Context* ctx);
   ~EmulatedFDManager();
   int32_t Open(const char* pathname, int flags, uint32_t mode);
+  bool IsEmulated(const char* pathname) const {
+    return pathname && FDReadCreators.contains(pathname);
+  }
 
 private:
   FEXCore::Context::Context* CTX;
@@ -31,7 +35,22 @@ private:
   std::once_flag cpu_info_initialized {};
   fextl::string cpu_info {};
   using FDReadStringFunc = std::function<int32_t(FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode)>;
-  fextl::unordered_map<fextl::string, FDReadStringFunc> FDReadCreators;
+  struct FDReadCreator {
+    FDReadStringFunc Func;
+
+    // The generated contents don't change for the lifetime of the process, so the first memfd is kept
+    // and reopened through /proc/self/fd, which gives each open its own file offset.
+    // Negative while there is none. The device and inode detect the guest closing or replacing the FD.
+    std::atomic<int32_t> CachedFD {-1};
+    std::atomic<uint64_t> CachedDev {};
+    std::atomic<uint64_t> CachedInode {};
+  };
+  // Below the default soft RLIMIT_NOFILE of 1024, caching is skipped if the limit is lower
+  constexpr static int32_t CACHED_FD_MINIMUM = 512;
+  fextl::unordered_map<fextl::string, FDReadCreator> FDReadCreators;
+
+  static int32_t ReopenCachedFD(FDReadCreator& Creator, int flags);
+  static void CacheFD(FDReadCreator& Creator, int32_t FD);
 
   static int32_t ProcAuxv(FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode);
   const uint32_t ThreadsConfig;
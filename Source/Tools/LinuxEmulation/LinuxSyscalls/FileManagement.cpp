@@ -8,6 +8,7 @@ $end_info$
 
 #include "Common/Config.h"
 #include "Common/FDUtils.h"
+#include "Common/FEXServerClient.h"
 #include "Common/JSONPool.h"
 
 #include "FEXCore/Config/Config.h"
@@ -36,6 +37,7 @@ $end_info$
 #include <stdio.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
+#include <sys/statvfs.h>
 #include <sys/xattr.h>
 #include <syscall.h>
 #include <system_error>
@@ -236,6 +238,21 @@ FileManager::FileManager(FEXCore::Context::Context* ctx)
       RootFSFD = AT_FDCWD;
     } else {
       TrackFEXFD(RootFSFD);
+
+      // A writable RootFS could gain any of the missing paths at any time
+      struct statvfs Buffer {};
+      if (fstatvfs(RootFSFD, &Buffer) == 0 && (Buffer.f_flag & ST_RDONLY)) {
+        RootFSLookups.Enable(RootFSFD);
+      }
+
+      if (const int ServerFD = FEXServerClient::GetServerFD(); ServerFD != -1) {
+        const int IndexFD = FEXServerClient::RequestRootFSIndexFD(ServerFD);
+        if (IndexFD != -1) {
+          // Only used if the index belongs to this RootFS
+          RootFSIndex.Load(IndexFD, LDPath());
+          close(IndexFD);
+        }
+      }
     }
   }
 
@@ -515,6 +532,12 @@ FileManager::GetEmulatedFDPath(int dirfd, const char* pathname, bool FollowSymli
     return NoEntry;
   }
 
+  // Known to not exist in the RootFS, skip straight to the host path
+  if (auto Indexed = RootFSIndex.Lookup(&pathname[1]); Indexed ? Indexed->Type == FEX::RootFSIndex::EntryType::Missing :
+                                                                 RootFSLookups.IsMissing(&pathname[1])) {
+    return NoEntry;
+  }
+
   // Starting subpath is the pathname passed in.
   const char* SubPath = pathname;
 
@@ -532,26 +555,39 @@ FileManager::GetEmulatedFDPath(int dirfd, const char* pathname, bool FollowSymli
     bool HadAtLeastOne {};
     struct stat Buffer {};
     for (;;) {
+      // Choose the current temporary working path.
+      auto CurrentTmp = TmpPaths[CurrentIndex];
+      ssize_t SymlinkSize = -1;
+
       // We need to check if the filepath exists and is a symlink.
       // If the initial filepath doesn't exist then early exit.
       // If it did exist at some state then trace it all all the way to the final link.
-      int Result = fstatat(RootFSFD, &SubPath[1], &Buffer, AT_SYMLINK_NOFOLLOW);
-      if (Result != 0 && errno == ENOENT && !HadAtLeastOne) {
-        // Initial file didn't exist at all
-        return NoEntry;
-      }
-
-      const bool IsLink = Result == 0 && S_ISLNK(Buffer.st_mode);
+      if (auto Indexed = RootFSIndex.Lookup(&SubPath[1])) {
+        if (Indexed->Type == FEX::RootFSIndex::EntryType::Missing && !HadAtLeastOne) {
+          // Initial file didn't exist at all
+          return NoEntry;
+        }
 
-      HadAtLeastOne = true;
+        if (Indexed->Type == FEX::RootFSIndex::EntryType::Symlink) {
+          SymlinkSize = std::min<size_t>(Indexed->Target.size(), PATH_MAX - 1);
+          memcpy(CurrentTmp, Indexed->Target.data(), SymlinkSize);
+        }
+      } else {
+        int Result = fstatat(RootFSFD, &SubPath[1], &Buffer, AT_SYMLINK_NOFOLLOW);
+        if (Result != 0 && errno == ENOENT && !HadAtLeastOne) {
+          // Initial file didn't exist at all
+          return NoEntry;
+        }
 
-      if (IsLink) {
-        // Choose the current temporary working path.
-        auto CurrentTmp = TmpPaths[CurrentIndex];
+        if (Result == 0 && S_ISLNK(Buffer.st_mode)) {
+          // Get the symlink of RootFS FD + stripped subpath.
+          SymlinkSize = FEX::HLE::GetSymlink(RootFSFD, &SubPath[1], CurrentTmp, PATH_MAX - 1);
+        }
+      }
 
-        // Get the symlink of RootFS FD + stripped subpath.
-        auto SymlinkSize = FEX::HLE::GetSymlink(RootFSFD, &SubPath[1], CurrentTmp, PATH_MAX - 1);
+      HadAtLeastOne = true;
 
+      if (SymlinkSize >= 0) {
         // This might be a /proc symlink into the RootFS, so strip it in that case.
         SymlinkSize = StripRootFSPrefix(CurrentTmp, SymlinkSize, false);
 
@@ -664,6 +700,12 @@ uint64_t FileManager::Open(const char* pathname, int flags, uint32_t mode) {
   int fd = -1;
 
   if (!ShouldSkipOpenInEmu(flags)) {
+    // Emulated files are matched against the host path that was opened, but they are almost always opened through
+    // their canonical path. Skip resolving it in that case, glibc's sysconf(_SC_NPROCESSORS_ONLN) does this for example.
+    if (int32_t EmuFd = EmuFD.Open(SelfPath, flags, mode); EmuFd != -1) {
+      return EmuFd;
+    }
+
     FDPathTmpData TmpFilename;
     auto Path = GetEmulatedFDPath(AT_FDCWD, SelfPath, false, TmpFilename);
     if (Path.FD != -1) {
@@ -918,6 +960,11 @@ uint64_t FileManager::Openat([[maybe_unused]] int dirfs, const char* pathname, i
   int32_t fd = -1;
 
   if (!ShouldSkipOpenInEmu(flags)) {
+    // Canonical emulated file paths skip resolving, see Open
+    if (int32_t EmuFd = EmuFD.Open(SelfPath, flags, mode); EmuFd != -1) {
+      return EmuFd;
+    }
+
     FDPathTmpData TmpFilename;
     auto Path = GetEmulatedFDPath(dirfs, SelfPath, false, TmpFilename);
     if (Path.FD != -1) {
@@ -954,6 +1001,14 @@ uint64_t FileManager::Openat2(int dirfs, const char* pathname, FEX::HLE::open_ho
   int32_t fd = -1;
 
   if (!ShouldSkipOpenInEmu(how->flags)) {
+    // Canonical emulated file paths skip resolving, see Open.
+    // Resolve restrictions need the kernel to walk the path, which the emulated file cache doesn't.
+    if (how->resolve == 0) {
+      if (int32_t EmuFd = EmuFD.Open(SelfPath, how->flags, how->mode); EmuFd != -1) {
+        return EmuFd;
+      }
+    }
+
     FDPathTmpData TmpFilename;
     auto Path = GetEmulatedFDPath(dirfs, SelfPath, false, TmpFilename);
     if (Path.FD != -1 && !(how->resolve & RESOLVE_IN_ROOT)) {
@@ -1004,6 +1059,68 @@ uint64_t FileManager::Statx(int dirfd, const char* pathname, int flags, uint32_t
   return FHU::Syscalls::statx(dirfd, SelfPath, flags, mask, statxbuf);
 }
 
+static FileManager::AsyncPathResult CopyAsyncPath(int FD, const char* Path, bool InRootFS, char (&Buffer)[PATH_MAX]) {
+  const size_t Length = strlen(Path);
+  if (Length >= PATH_MAX) {
+    return FileManager::AsyncPathResult {-1, nullptr, false};
+  }
+  memcpy(Buffer, Path, Length + 1);
+  return FileManager::AsyncPathResult {FD, Buffer, InRootFS};
+}
+
+FileManager::AsyncPathResult
+FileManager::GetAsyncPath(int dirfd, const char* pathname, bool FollowSymlink, char (&Buffer)[PATH_MAX]) const {
+  constexpr auto NoEntry = AsyncPathResult {-1, nullptr, false};
+
+  auto NewPath = GetSelf(pathname);
+  const char* SelfPath = NewPath ? NewPath->data() : nullptr;
+
+  FDPathTmpData TmpFilename;
+  auto Path = GetEmulatedFDPath(dirfd, SelfPath, FollowSymlink, TmpFilename);
+  const bool InRootFS = Path.FD != -1 && Path.FD != AT_FDCWD;
+
+  // The kernel can't fall back to the host path like the synchronous syscalls do, so only redirect to files that exist in the RootFS.
+  struct stat Stat;
+  if (InRootFS && fstatat(Path.FD, Path.Path, &Stat, AT_SYMLINK_NOFOLLOW) != 0) {
+    Path.FD = -1;
+  }
+
+  if (Path.FD == -1) {
+    if (SelfPath == pathname) {
+      return NoEntry;
+    }
+    return CopyAsyncPath(dirfd, SelfPath, false, Buffer);
+  }
+
+  return CopyAsyncPath(Path.FD, Path.Path, InRootFS, Buffer);
+}
+
+FileManager::AsyncPathResult
+FileManager::GetAsyncOpenPath(int dirfd, const char* pathname, uint64_t flags, char (&Buffer)[PATH_MAX]) const {
+  if (ShouldSkipOpenInEmu(flags)) {
+    // Matches Openat, which only rewrites the self path in this case
+    auto NewPath = GetSelf(pathname);
+    if (!NewPath || NewPath->data() == pathname) {
+      return AsyncPathResult {-1, nullptr, false};
+    }
+    return CopyAsyncPath(dirfd, NewPath->data(), false, Buffer);
+  }
+
+  return GetAsyncPath(dirfd, pathname, false, Buffer);
+}
+
+FileManager::AsyncPathResult FileManager::GetAsyncStatPath(int dirfd, const char* pathname, int flags, char (&Buffer)[PATH_MAX]) const {
+  if (IsSelfNoFollow(pathname, flags)) {
+    return AsyncPathResult {-1, nullptr, false};
+  }
+
+  return GetAsyncPath(dirfd, pathname, (flags & AT_SYMLINK_NOFOLLOW) == 0, Buffer);
+}
+
+bool FileManager::IsEmulatedOpen(const char* pathname, uint64_t flags) const {
+  return !ShouldSkipOpenInEmu(flags) && EmuFD.IsEmulated(pathname);
+}
+
 uint64_t FileManager::Mknod(const char* pathname, mode_t mode, dev_t dev) {
   auto NewPath = GetSelf(pathname);
   const char* SelfPath = NewPath ? NewPath->data() : nullptr;
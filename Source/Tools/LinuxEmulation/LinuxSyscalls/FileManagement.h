@@ -25,7 +25,9 @@ $end_info$
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "Common/RootFSIndex.h"
 #include "LinuxSyscalls/EmulatedFiles/EmulatedFiles.h"
+#include "LinuxSyscalls/RootFSLookupCache.h"
 
 namespace FEXCore::Context {
 class Context;
@@ -104,6 +106,20 @@ public:
 
   bool ReplaceEmuFd(int fd, int flags, uint32_t mode);
 
+  struct AsyncPathResult final {
+    int FD;
+    const char* Path;
+    // The path is relative to the RootFS and needs RESOLVE_IN_ROOT to be opened
+    bool InRootFS;
+  };
+
+  // Path translation for io_uring submissions, which the kernel resolves asynchronously.
+  // Returns the directory FD and path to submit instead, copied in to Buffer, or an FD of -1 if the original can be submitted.
+  AsyncPathResult GetAsyncOpenPath(int dirfd, const char* pathname, uint64_t flags, char (&Buffer)[PATH_MAX]) const;
+  AsyncPathResult GetAsyncStatPath(int dirfd, const char* pathname, int flags, char (&Buffer)[PATH_MAX]) const;
+  // Returns true if opening the path synchronously would give an emulated file instead
+  bool IsEmulatedOpen(const char* pathname, uint64_t flags) const;
+
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
   void TrackFEXFD(int FD) noexcept {
     std::lock_guard lk(FEXTrackingFDMutex);
@@ -164,6 +180,7 @@ private:
 
   std::optional<std::string_view> GetSelf(const char* Pathname) const;
   bool IsSelfNoFollow(const char* Pathname, int flags) const;
+  AsyncPathResult GetAsyncPath(int dirfd, const char* pathname, bool FollowSymlink, char (&Buffer)[PATH_MAX]) const;
 
   bool RootFSPathExists(const char* Filepath) const;
   size_t GetRootFSPrefixLen(const char* pathname, size_t len, bool AliasedOnly) const;
@@ -178,6 +195,13 @@ private:
   void LoadThunkDatabase(fextl::unordered_map<fextl::string, ThunkDBObject>& ThunkDB, bool Global);
   FEX::EmulatedFile::EmulatedFDManager EmuFD;
 
+  // Lets lookups beneath missing RootFS paths (/proc, /sys, $HOME, ...) go straight to the host.
+  // Only enabled when the RootFS is mounted read-only.
+  RootFSLookupCache RootFSLookups;
+
+  // Resolves paths in a RootFS image mounted by FEXServer without any syscalls, when available
+  FEX::RootFSIndex::Reader RootFSIndex;
+
   fextl::map<fextl::string, fextl::string, std::less<>> ThunkOverlays;
 
   FEX_CONFIG_OPT(Filename, APP_FILENAME);
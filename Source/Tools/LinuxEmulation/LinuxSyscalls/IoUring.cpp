@@ -0,0 +1,439 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|syscalls-x86-64
+desc: Inspects io_uring submissions before the kernel sees them
+$end_info$
+*/
+
+#include "LinuxSyscalls/IoUring.h"
+#include "LinuxSyscalls/ScratchArena.h"
+#include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/ThreadManager.h"
+#include "LinuxSyscalls/Types.h"
+
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/TypeDefines.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string_view>
+#include <fcntl.h>
+#include <linux/kcmp.h>
+#include <linux/limits.h>
+#include <linux/openat2.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef IORING_SETUP_SUBMIT_ALL
+#define IORING_SETUP_SUBMIT_ALL (1U << 7)
+#endif
+#ifndef IORING_SETUP_NO_MMAP
+#define IORING_SETUP_NO_MMAP (1U << 14)
+#endif
+#ifndef IORING_SETUP_REGISTERED_FD_ONLY
+#define IORING_SETUP_REGISTERED_FD_ONLY (1U << 15)
+#endif
+#ifndef IORING_SETUP_NO_SQARRAY
+#define IORING_SETUP_NO_SQARRAY (1U << 16)
+#endif
+#ifndef IORING_ENTER_REGISTERED_RING
+#define IORING_ENTER_REGISTERED_RING (1U << 4)
+#endif
+#ifndef IORING_REGISTER_USE_REGISTERED_RING
+#define IORING_REGISTER_USE_REGISTERED_RING (1U << 31)
+#endif
+
+namespace FEX::HLE {
+// Not in older kernel headers
+constexpr uint32_t IORING_REGISTER_RING_FDS_OP = 20;
+constexpr uint32_t IORING_REGISTER_RESIZE_RINGS_OP = 33;
+
+// Opcodes after this one haven't been checked for structures that have a different layout on the host
+constexpr uint8_t LAST_CHECKED_OPCODE = 58;
+// Not a valid opcode, so the kernel completes the SQE with -EINVAL.
+// Unless the ring was set up with IORING_SETUP_SUBMIT_ALL that also ends the submission after the link chain of the SQE,
+// so Enter submits what comes after it separately.
+constexpr uint8_t FAILED_OPCODE = 0xFF;
+
+IoUringTracking::Ring::~Ring() {
+  if (SQRing) {
+    ::munmap(SQRing, SQRingSize);
+  }
+  if (SQEs) {
+    ::munmap(SQEs, SQEsSize);
+  }
+}
+
+fextl::unique_ptr<IoUringTracking::Ring> IoUringTracking::MapRing(int FD, const io_uring_params& Params) {
+  auto NewRing = fextl::make_unique<Ring>();
+  const bool NoSQArray = Params.flags & IORING_SETUP_NO_SQARRAY;
+
+  // Without the index array the SQ ring only needs to reach the CQEs, which come after all of its fields
+  NewRing->SQRingSize = NoSQArray ? Params.cq_off.cqes : Params.sq_off.array + Params.sq_entries * sizeof(uint32_t);
+  NewRing->SQESize = (Params.flags & IORING_SETUP_SQE128) ? 2 * sizeof(io_uring_sqe) : sizeof(io_uring_sqe);
+  NewRing->SQEsSize = Params.sq_entries * NewRing->SQESize;
+
+  auto SQRing = ::mmap(nullptr, NewRing->SQRingSize, PROT_READ, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_SQ_RING);
+  if (SQRing == MAP_FAILED) {
+    return nullptr;
+  }
+  NewRing->SQRing = SQRing;
+
+  auto SQEs = ::mmap(nullptr, NewRing->SQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_SQES);
+  if (SQEs == MAP_FAILED) {
+    return nullptr;
+  }
+  NewRing->SQEs = static_cast<std::byte*>(SQEs);
+
+  const auto Base = static_cast<std::byte*>(SQRing);
+  NewRing->Head = reinterpret_cast<uint32_t*>(Base + Params.sq_off.head);
+  NewRing->Tail = reinterpret_cast<uint32_t*>(Base + Params.sq_off.tail);
+  NewRing->Mask = *reinterpret_cast<const uint32_t*>(Base + Params.sq_off.ring_mask);
+  NewRing->Array = NoSQArray ? nullptr : reinterpret_cast<uint32_t*>(Base + Params.sq_off.array);
+  NewRing->Entries = Params.sq_entries;
+  NewRing->SubmitAll = Params.flags & IORING_SETUP_SUBMIT_ALL;
+  return NewRing;
+}
+
+uint64_t IoUringTracking::Setup(FEXCore::Core::InternalThreadState* Thread, uint32_t Entries, io_uring_params* Params) {
+  FaultSafeUserMemAccess::VerifyIsWritable(Params, sizeof(*Params));
+
+  // SQPOLL has a kernel thread consume SQEs without io_uring_enter, so they couldn't be rewritten first.
+  // NO_MMAP and REGISTERED_FD_ONLY don't give FEX a way to map the rings itself.
+  if (Params->flags & (IORING_SETUP_SQPOLL | IORING_SETUP_NO_MMAP | IORING_SETUP_REGISTERED_FD_ONLY)) {
+    return -EINVAL;
+  }
+
+  const int FD = ::syscall(SYSCALL_DEF(io_uring_setup), Entries, Params);
+  if (FD == -1) {
+    return -errno;
+  }
+
+  // Rewritten SQEs point to FEX memory that is only valid until io_uring_enter returns
+  if (!(Params->features & IORING_FEAT_SUBMIT_STABLE)) {
+    ::close(FD);
+    return -ENOSYS;
+  }
+
+  auto NewRing = MapRing(FD, *Params);
+  if (!NewRing) {
+    ::close(FD);
+    return -ENOMEM;
+  }
+
+  auto lk = FEXCore::GuardSignalDeferringSection(Mutex, Thread);
+  NewRing->ID = NextID++;
+  Rings[FD] = std::move(NewRing);
+  NumRings.store(Rings.size(), std::memory_order_relaxed);
+  return FD;
+}
+
+// Rings the guest got some other way, like through SCM_RIGHTS or from before an execve, were never mapped by FEX
+static bool IsIoUringFD(int FD) {
+  constexpr std::string_view IoUringTarget = "anon_inode:[io_uring]";
+  char Target[IoUringTarget.size() + 1];
+  const auto Path = fextl::fmt::format("/proc/self/fd/{}", FD);
+  const ssize_t Length = ::readlink(Path.c_str(), Target, sizeof(Target));
+  return Length == static_cast<ssize_t>(IoUringTarget.size()) && std::string_view(Target, Length) == IoUringTarget;
+}
+
+IoUringTracking::Ring* IoUringTracking::FindRing(int FD) const {
+  if (auto It = Rings.find(FD); It != Rings.end()) {
+    return It->second.get();
+  }
+
+  if (Rings.empty() || !IsIoUringFD(FD)) {
+    return nullptr;
+  }
+
+  // A duplicate of a tracked ring, like from dup or F_DUPFD
+  const pid_t PID = ::getpid();
+  for (const auto& [RingFD, TrackedRing] : Rings) {
+    if (::syscall(SYS_kcmp, PID, PID, KCMP_FILE, FD, RingFD) == 0) {
+      return TrackedRing.get();
+    }
+  }
+
+  return nullptr;
+}
+
+static uint64_t CopyPath(ScratchArena::Scope& Scratch, const char* Path) {
+  const size_t Size = strlen(Path) + 1;
+  auto Copy = Scratch.Allocate<char>(Size);
+  memcpy(Copy, Path, Size);
+  return reinterpret_cast<uint64_t>(Copy);
+}
+
+// Returns true if the SQE was modified
+static bool RewriteSQE(io_uring_sqe* SQE, ScratchArena::Scope& Scratch) {
+  auto& FM = FEX::HLE::_SyscallHandler->FM;
+  char Buffer[PATH_MAX];
+
+  switch (SQE->opcode) {
+  case IORING_OP_OPENAT: {
+    // The kernel wants the host open flags, same as the openat syscall
+    const uint64_t Flags = FEX::HLE::RemapFromX86Flags(SQE->open_flags);
+    const bool Remapped = Flags != SQE->open_flags;
+    SQE->open_flags = Flags;
+
+    // Registered files can't be used as the directory
+    if (SQE->flags & IOSQE_FIXED_FILE) {
+      return Remapped;
+    }
+
+    const auto Path = reinterpret_cast<const char*>(SQE->addr);
+    if (FM.IsEmulatedOpen(Path, Flags)) {
+      SQE->opcode = FAILED_OPCODE;
+      return true;
+    }
+
+    const auto Resolved = FM.GetAsyncOpenPath(SQE->fd, Path, Flags, Buffer);
+    if (Resolved.FD == -1) {
+      return Remapped;
+    }
+
+    // openat has no way to pass RESOLVE_IN_ROOT
+    auto How = Scratch.Allocate<FEX::HLE::open_how>(1);
+    *How = {
+      .flags = Flags,
+      .mode = (Flags & (O_CREAT | O_TMPFILE)) ? SQE->len & 07777 : 0, // openat2() is stricter about this
+      .resolve = Resolved.InRootFS ? RESOLVE_IN_ROOT : 0u,
+    };
+    SQE->opcode = IORING_OP_OPENAT2;
+    SQE->fd = Resolved.FD;
+    SQE->addr = CopyPath(Scratch, Resolved.Path);
+    SQE->addr2 = reinterpret_cast<uint64_t>(How);
+    SQE->len = sizeof(*How);
+    return true;
+  }
+  case IORING_OP_OPENAT2: {
+    // The kernel fails anything outside of these sizes without reading the structure
+    const size_t HowSize = SQE->len;
+    if (HowSize < sizeof(FEX::HLE::open_how) || HowSize > FEXCore::Utils::FEX_PAGE_SIZE) {
+      return false;
+    }
+
+    const auto Path = reinterpret_cast<const char*>(SQE->addr);
+    const auto GuestHow = reinterpret_cast<const FEX::HLE::open_how*>(SQE->addr2);
+    FaultSafeUserMemAccess::VerifyIsReadable(GuestHow, HowSize);
+    const uint64_t Flags = FEX::HLE::RemapFromX86Flags(GuestHow->flags);
+
+    // Registered files can't be used as the directory
+    const bool CanResolve = !(SQE->flags & IOSQE_FIXED_FILE) && !(GuestHow->resolve & RESOLVE_IN_ROOT);
+    if (CanResolve && FM.IsEmulatedOpen(Path, Flags)) {
+      SQE->opcode = FAILED_OPCODE;
+      return true;
+    }
+
+    const auto Resolved = CanResolve ? FM.GetAsyncOpenPath(SQE->fd, Path, Flags, Buffer) : FileManager::AsyncPathResult {-1};
+    if (Resolved.FD == -1 && Flags == GuestHow->flags) {
+      return false;
+    }
+
+    // The kernel copies the structure when the SQE is submitted. Extended structures are copied along as they are.
+    const size_t HowWords = FEXCore::AlignUp(HowSize, sizeof(uint64_t)) / sizeof(uint64_t);
+    auto How = reinterpret_cast<FEX::HLE::open_how*>(Scratch.Allocate<uint64_t>(HowWords));
+    memcpy(How, GuestHow, HowSize);
+    How->flags = Flags;
+    SQE->addr2 = reinterpret_cast<uint64_t>(How);
+
+    if (Resolved.FD != -1) {
+      if (Resolved.InRootFS) {
+        How->resolve |= RESOLVE_IN_ROOT;
+      }
+      SQE->fd = Resolved.FD;
+      SQE->addr = CopyPath(Scratch, Resolved.Path);
+    }
+    return true;
+  }
+  case IORING_OP_STATX: {
+    // Before 5.19 the kernel only copies the statx path when the request is issued, which can be after io_uring_enter returned
+    // and the copy is gone again.
+    if ((SQE->flags & IOSQE_FIXED_FILE) || !FEX::HLE::_SyscallHandler->IsHostKernelVersionAtLeast(5, 19)) {
+      return false;
+    }
+
+    const auto Resolved = FM.GetAsyncStatPath(SQE->fd, reinterpret_cast<const char*>(SQE->addr), SQE->statx_flags, Buffer);
+    if (Resolved.FD == -1) {
+      return false;
+    }
+
+    SQE->fd = Resolved.FD;
+    SQE->addr = CopyPath(Scratch, Resolved.Path);
+    return true;
+  }
+#ifndef ARCHITECTURE_x86_64
+  case IORING_OP_EPOLL_CTL: {
+    // epoll_event is only packed on x86-64, see FEX::HLE::epoll_event_x86
+    if (SQE->len == EPOLL_CTL_DEL || !SQE->addr) {
+      return false;
+    }
+
+    const auto GuestEvent = reinterpret_cast<const FEX::HLE::epoll_event_x86*>(SQE->addr);
+    FaultSafeUserMemAccess::VerifyIsReadable(GuestEvent, sizeof(*GuestEvent));
+    auto Event = Scratch.Allocate<struct epoll_event>(1);
+    *Event = *GuestEvent;
+    SQE->addr = reinterpret_cast<uint64_t>(Event);
+    return true;
+  }
+#endif
+  default:
+#ifndef ARCHITECTURE_x86_64
+    // Newer opcodes such as IORING_OP_EPOLL_WAIT would hand back structures in the host layout
+    if (SQE->opcode > LAST_CHECKED_OPCODE) {
+      SQE->opcode = FAILED_OPCODE;
+      return true;
+    }
+#endif
+    return false;
+  }
+}
+
+uint64_t IoUringTracking::Enter(FEXCore::Core::InternalThreadState* Thread, int FD, uint32_t ToSubmit, uint32_t MinComplete,
+                                uint32_t Flags, const void* Arg, size_t ArgSize) {
+  // Ring FDs are never registered, see Register
+  if (Flags & IORING_ENTER_REGISTERED_RING) {
+    return -EINVAL;
+  }
+
+  if (ToSubmit == 0) {
+    uint64_t Result = ::syscall(SYSCALL_DEF(io_uring_enter), FD, ToSubmit, MinComplete, Flags, Arg, ArgSize);
+    SYSCALL_ERRNO();
+  }
+
+  if (NumRings.load(std::memory_order_relaxed) == 0) {
+    // The SQEs of an untracked ring can't be rewritten, so don't let the kernel see them
+    if (IsIoUringFD(FD)) {
+      return -EINVAL;
+    }
+
+    uint64_t Result = ::syscall(SYSCALL_DEF(io_uring_enter), FD, ToSubmit, MinComplete, Flags, Arg, ArgSize);
+    SYSCALL_ERRNO();
+  }
+
+  ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(Thread)->SyscallScratch};
+  SavedSQE* Saved {};
+  uint32_t NumSaved {};
+  // Where each submission ends, after the link chain of every SQE that FEX failed
+  uint32_t* SubmitEnds {};
+  uint32_t NumSubmitEnds {};
+  uint32_t Head {};
+  uint64_t ID {};
+
+  {
+    auto lk = FEXCore::GuardSignalDeferringSection<std::shared_lock>(Mutex, Thread);
+    const auto TrackedRing = FindRing(FD);
+    if (!TrackedRing && IsIoUringFD(FD)) {
+      // The SQEs of an untracked ring can't be rewritten, so don't let the kernel see them
+      return -EINVAL;
+    }
+
+    if (TrackedRing) {
+      const auto& CurrentRing = *TrackedRing;
+      ID = CurrentRing.ID;
+      Head = std::atomic_ref(*CurrentRing.Head).load(std::memory_order_acquire);
+      const uint32_t Tail = std::atomic_ref(*CurrentRing.Tail).load(std::memory_order_acquire);
+
+      // The kernel doesn't look past what is queued either
+      ToSubmit = std::min(ToSubmit, Tail - Head);
+      bool InFailedChain = false;
+      for (uint32_t i = 0; i < ToSubmit; ++i) {
+        uint32_t Index = (Head + i) & CurrentRing.Mask;
+        if (CurrentRing.Array) {
+          Index = CurrentRing.Array[Index];
+        }
+
+        if (Index >= CurrentRing.Entries) {
+          // Dropped by the kernel
+          continue;
+        }
+
+        auto SQE = reinterpret_cast<io_uring_sqe*>(CurrentRing.SQEs + Index * CurrentRing.SQESize);
+        const io_uring_sqe Original = *SQE;
+        if (RewriteSQE(SQE, Scratch)) {
+          if (!Saved) {
+            Saved = Scratch.Allocate<SavedSQE>(ToSubmit);
+          }
+          Saved[NumSaved++] = {i, SQE, Original};
+          InFailedChain |= SQE->opcode == FAILED_OPCODE && !CurrentRing.SubmitAll;
+        }
+
+        // The kernel keeps going until the end of the link chain the failed SQE is in
+        if (InFailedChain && !(SQE->flags & (IOSQE_IO_LINK | IOSQE_IO_HARDLINK)) && i + 1 < ToSubmit) {
+          if (!SubmitEnds) {
+            SubmitEnds = Scratch.Allocate<uint32_t>(ToSubmit);
+          }
+          SubmitEnds[NumSubmitEnds++] = i + 1;
+          InFailedChain = false;
+        }
+      }
+    }
+  }
+
+  // Only the last submission waits for completions
+  uint32_t Submitted {};
+  uint64_t Result {};
+  for (uint32_t i = 0; i <= NumSubmitEnds; ++i) {
+    const bool Last = i == NumSubmitEnds;
+    const uint32_t Count = (Last ? ToSubmit : SubmitEnds[i]) - Submitted;
+    const uint64_t SubmitResult = ::syscall(SYSCALL_DEF(io_uring_enter), FD, Count, Last ? MinComplete : 0,
+                                            Last ? Flags : Flags & ~IORING_ENTER_GETEVENTS, Arg, ArgSize);
+    if (SubmitResult == -1) {
+      // Same as the kernel, an error is only returned if nothing was submitted
+      Result = Submitted ? Submitted : -errno;
+      break;
+    }
+
+    Submitted += SubmitResult;
+    Result = Submitted;
+    if (SubmitResult != Count) {
+      break;
+    }
+  }
+
+  if (NumSaved) {
+    // The guest may reuse SQEs the kernel didn't consume, so they need to look like it wrote them
+    auto lk = FEXCore::GuardSignalDeferringSection<std::shared_lock>(Mutex, Thread);
+    if (auto TrackedRing = FindRing(FD); TrackedRing && TrackedRing->ID == ID) {
+      const uint32_t Consumed = std::atomic_ref(*TrackedRing->Head).load(std::memory_order_acquire) - Head;
+      for (uint32_t i = 0; i < NumSaved; ++i) {
+        if (Saved[i].Position >= Consumed) {
+          *Saved[i].SQE = Saved[i].Original;
+        }
+      }
+    }
+  }
+
+  return Result;
+}
+
+uint64_t IoUringTracking::Register(FEXCore::Core::InternalThreadState* Thread, int FD, uint32_t Opcode, void* Arg, uint32_t NumArgs) {
+  // Registered ring FDs would let the guest submit without FEX knowing which ring it is.
+  // Resizing would move the SQEs out from under FEX's mapping.
+  // Kernels that don't support these return the same error.
+  if ((Opcode & IORING_REGISTER_USE_REGISTERED_RING) || Opcode == IORING_REGISTER_RING_FDS_OP ||
+      Opcode == IORING_REGISTER_RESIZE_RINGS_OP) {
+    return -EINVAL;
+  }
+
+  uint64_t Result = ::syscall(SYSCALL_DEF(io_uring_register), FD, Opcode, Arg, NumArgs);
+  SYSCALL_ERRNO();
+}
+
+void IoUringTracking::CloseFDs(FEXCore::Core::InternalThreadState* Thread, uint32_t First, uint32_t Last) {
+  if (NumRings.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+
+  auto lk = FEXCore::GuardSignalDeferringSection(Mutex, Thread);
+  std::erase_if(Rings, [First, Last](const auto& It) {
+    const uint32_t FD = It.first;
+    return FD >= First && FD <= Last;
+  });
+  NumRings.store(Rings.size(), std::memory_order_relaxed);
+}
+} // namespace FEX::HLE
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/Utils/SignalScopeGuards.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/unordered_map.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+
+namespace FEXCore::Core {
+struct InternalThreadState;
+}
+
+namespace FEX::HLE {
+/**
+ * Tracks the io_uring instances of 64-bit guests.
+ *
+ * The submission and completion rings are shared with the guest unmodified. FEX maps the submission ring a
+ * second time, so that on io_uring_enter it can rewrite the few SQEs the kernel must not see as-is before
+ * submitting them: paths that need to go through the RootFS and structures with a different host layout.
+ * Rewritten SQEs that the kernel didn't consume are restored afterwards.
+ *
+ * Configurations where the kernel reads SQEs without io_uring_enter (SQPOLL) are rejected, as are submissions to
+ * rings that FEX didn't set up itself.
+ */
+class IoUringTracking final {
+public:
+  uint64_t Setup(FEXCore::Core::InternalThreadState* Thread, uint32_t Entries, io_uring_params* Params);
+  uint64_t Enter(FEXCore::Core::InternalThreadState* Thread, int FD, uint32_t ToSubmit, uint32_t MinComplete, uint32_t Flags,
+                 const void* Arg, size_t ArgSize);
+  uint64_t Register(FEXCore::Core::InternalThreadState* Thread, int FD, uint32_t Opcode, void* Arg, uint32_t NumArgs);
+
+  // Drops the tracking of rings whose FDs the guest closed or replaced. Last is inclusive.
+  void CloseFDs(FEXCore::Core::InternalThreadState* Thread, uint32_t First, uint32_t Last);
+  void CloseFD(FEXCore::Core::InternalThreadState* Thread, int FD) {
+    if (FD >= 0) {
+      CloseFDs(Thread, FD, FD);
+    }
+  }
+
+  FEXCore::ForkableSharedMutex Mutex;
+
+private:
+  struct Ring final {
+    Ring() = default;
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+    ~Ring();
+
+    // Detects an FD being reused for a different ring while the lock was released
+    uint64_t ID;
+
+    void* SQRing {};
+    size_t SQRingSize {};
+    std::byte* SQEs {};
+    size_t SQEsSize {};
+
+    uint32_t* Head;
+    uint32_t* Tail;
+    uint32_t Mask;
+    // nullptr with IORING_SETUP_NO_SQARRAY
+    uint32_t* Array;
+    uint32_t Entries;
+    uint32_t SQESize;
+    // IORING_SETUP_SUBMIT_ALL, failed SQEs don't end the submission
+    bool SubmitAll;
+  };
+
+  struct SavedSQE {
+    // Position of the SQE relative to the SQ head at submission
+    uint32_t Position;
+    io_uring_sqe* SQE;
+    io_uring_sqe Original;
+  };
+
+  static fextl::unique_ptr<Ring> MapRing(int FD, const io_uring_params& Params);
+  // Also finds tracked rings through duplicated FDs. Requires Mutex to be held.
+  Ring* FindRing(int FD) const;
+
+  fextl::unordered_map<int, fextl::unique_ptr<Ring>> Rings;
+  uint64_t NextID {};
+  // Lets close skip the lock when the guest never used io_uring
+  std::atomic<uint32_t> NumRings {};
+};
+} // namespace FEX::HLE
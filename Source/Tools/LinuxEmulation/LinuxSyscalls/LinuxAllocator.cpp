@@ -2,13 +2,17 @@
 #include "LinuxSyscalls/LinuxAllocator.h"
 #include "LinuxSyscalls/Syscalls.h"
 
+#include <FEXCore/Utils/FileLoading.h>
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/TypeDefines.h>
 #include <FEXHeaderUtils/Syscalls.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/string.h>
 
-#include <bitset>
+#include <algorithm>
+#include <charconv>
 #include <linux/mman.h>
 #include <unistd.h>
 #include <sys/user.h>
@@ -24,26 +28,15 @@ class MemAllocator32Bit final : public FEX::HLE::MemAllocator {
 private:
   static constexpr uint64_t BASE_KEY = 16;
   static constexpr uint64_t TOP_KEY = 0xFFFF'F000ULL >> FEXCore::Utils::FEX_PAGE_SHIFT;
-  static constexpr uint64_t TOP_KEY32BIT = 0x7FFF'F000ULL >> FEXCore::Utils::FEX_PAGE_SHIFT;
+  // MAP_32BIT allocations must end below 2GB
+  static constexpr uint64_t TOP_KEY32BIT = 0x8000'0000ULL >> FEXCore::Utils::FEX_PAGE_SHIFT;
+  // How many times a range is retried when a colliding mapping isn't in /proc/self/maps anymore
+  static constexpr uint32_t MAX_UNKNOWN_MAPPING_RETRIES = 8;
 
 public:
   MemAllocator32Bit() {
-    // First 16 pages are taken by the Linux kernel
-    for (size_t i = 0; i < 16; ++i) {
-      MappedPages.set(i);
-    }
-    // Take the top page as well
-    MappedPages.set(TOP_KEY);
-    if (SearchDown) {
-      LastScanLocation = TOP_KEY;
-      LastKeyLocation = TOP_KEY;
-      LastKeyLocation32Bit = TOP_KEY32BIT;
-      FindPageRangePtr = &MemAllocator32Bit::FindPageRange_TopDown;
-    } else {
-      LastScanLocation = BASE_KEY;
-      LastKeyLocation = BASE_KEY;
-      FindPageRangePtr = &MemAllocator32Bit::FindPageRange;
-    }
+    // First 16 pages are taken by the Linux kernel, take the top page as well
+    InsertFreeRange(BASE_KEY, TOP_KEY);
   }
 
   void* Mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset) override;
@@ -51,85 +44,141 @@ public:
   void* Mremap(void* old_address, size_t old_size, size_t new_size, int flags, void* new_address) override;
   uint64_t Shmat(int shmid, const void* shmaddr, int shmflg, uint32_t* ResultAddress) override;
   uint64_t Shmdt(const void* shmaddr) override;
-  static constexpr bool SearchDown = true;
 
   // PageAddr is a page already shifted to page index
   // PagesLength is the number of pages
   void SetUsedPages(uint64_t PageAddr, size_t PagesLength) {
-    // Set the range as mapped
-    for (size_t i = 0; i < PagesLength; ++i) {
-      MappedPages.set(PageAddr + i);
+    const uint64_t Start = PageAddr;
+    const uint64_t End = PageAddr + PagesLength;
+
+    // Start from the free range that contains Start, if any
+    auto It = FreeRanges.upper_bound(Start);
+    if (It != FreeRanges.begin() && std::prev(It)->second > Start) {
+      --It;
+    }
+
+    // Carve the range out of every free range it overlaps
+    while (It != FreeRanges.end() && It->first < End) {
+      const auto [RangeStart, RangeEnd] = *It;
+      It = EraseFreeRange(It);
+      if (RangeStart < Start) {
+        InsertFreeRange(RangeStart, Start);
+      }
+      if (RangeEnd > End) {
+        InsertFreeRange(End, RangeEnd);
+      }
     }
   }
 
   // PageAddr is a page already shifted to page index
   // PagesLength is the number of pages
   void SetFreePages(uint64_t PageAddr, size_t PagesLength) {
-    // Set the range as unused
-    for (size_t i = 0; i < PagesLength; ++i) {
-      MappedPages.reset(PageAddr + i);
+    // The reserved pages are never handed out
+    uint64_t Start = std::max(PageAddr, BASE_KEY);
+    uint64_t End = std::min(PageAddr + PagesLength, TOP_KEY);
+    if (Start >= End) {
+      return;
+    }
+
+    // Merge with any free range that overlaps or touches the new one
+    auto It = FreeRanges.upper_bound(Start);
+    if (It != FreeRanges.begin() && std::prev(It)->second >= Start) {
+      --It;
+      Start = It->first;
     }
+
+    while (It != FreeRanges.end() && It->first <= End) {
+      End = std::max(End, It->second);
+      It = EraseFreeRange(It);
+    }
+
+    InsertFreeRange(Start, End);
   }
 
 private:
-  // Set that contains 4k mapped pages
-  // This is the full 32bit memory range
-  std::bitset<0x10'0000> MappedPages;
+  // Free page ranges, keyed by first page with the end page as value.
+  // Ranges never overlap or touch, adjacent ranges are merged.
+  using FreeRangeMap = fextl::map<uint64_t, uint64_t>;
+  FreeRangeMap FreeRanges;
+  // The same ranges as {Pages, First page}, for best-fit lookups
+  fextl::set<std::pair<uint64_t, uint64_t>> FreeRangesBySize;
+
   fextl::map<uint32_t, int> PageToShm {};
-  uint64_t LastScanLocation {};
-  uint64_t LastKeyLocation {};
-  uint64_t LastKeyLocation32Bit {};
   std::mutex AllocMutex {};
-  uint64_t FindPageRange(uint64_t Start, size_t Pages) const;
-  uint64_t FindPageRange_TopDown(uint64_t Start, size_t Pages) const;
-  using FindHandler = uint64_t (MemAllocator32Bit::*)(uint64_t Start, size_t Pages) const;
-  FindHandler FindPageRangePtr {};
-};
 
-uint64_t MemAllocator32Bit::FindPageRange(uint64_t Start, size_t Pages) const {
-  // Linear range scan
-  while (Start != TOP_KEY) {
-    bool Free = true;
-    if ((Start + Pages) > TOP_KEY) {
-      return 0;
-    }
-    uint64_t Offset = 0;
-    for (; Offset < Pages; ++Offset) {
-      if (MappedPages.test(Start + Offset)) {
-        Free = false;
-        break;
-      }
+  void InsertFreeRange(uint64_t Start, uint64_t End) {
+    FreeRanges.emplace(Start, End);
+    FreeRangesBySize.emplace(End - Start, Start);
+  }
+
+  FreeRangeMap::iterator EraseFreeRange(FreeRangeMap::iterator It) {
+    FreeRangesBySize.erase({It->second - It->first, It->first});
+    return FreeRanges.erase(It);
+  }
+
+  bool IsFreeRange(uint64_t PageAddr, size_t PagesLength) const {
+    auto It = FreeRanges.upper_bound(PageAddr);
+    if (It == FreeRanges.begin()) {
+      return false;
     }
+    --It;
+    return It->second >= PageAddr + PagesLength;
+  }
 
-    if (Free) {
-      return Start;
+  uint64_t FindPageRange(size_t Pages, uint64_t TopPage) const;
+  bool TrackUnknownMappings(uint64_t PageAddr, size_t PagesLength);
+};
+
+uint64_t MemAllocator32Bit::FindPageRange(size_t Pages, uint64_t TopPage) const {
+  // Best fit, so that small allocations fill holes instead of splitting up the large free ranges.
+  // Allocations are placed at the top of the range to keep the top-down layout the kernel uses.
+  for (auto It = FreeRangesBySize.lower_bound({Pages, 0}); It != FreeRangesBySize.end(); ++It) {
+    const auto [RangePages, RangeStart] = *It;
+    const uint64_t RangeEnd = std::min(RangeStart + RangePages, TopPage);
+    if (RangeEnd >= RangeStart + Pages) {
+      return RangeEnd - Pages;
     }
-    Start += Offset + 1;
   }
 
   return 0;
 }
 
-uint64_t MemAllocator32Bit::FindPageRange_TopDown(uint64_t Start, size_t Pages) const {
-  // Linear range scan
-  while (Start >= BASE_KEY && Start <= TOP_KEY) {
-    bool Free = true;
+bool MemAllocator32Bit::TrackUnknownMappings(uint64_t PageAddr, size_t PagesLength) {
+  // Something we didn't allocate is mapped in this range, like FEX's own mappings from before the allocator existed.
+  // Find which pages they cover so the range isn't tried again.
+  fextl::string MapsFile;
+  if (!FEXCore::FileLoading::LoadFile(MapsFile, "/proc/self/maps")) {
+    return false;
+  }
+
+  const uint64_t RangeEnd = PageAddr + PagesLength;
+  bool Found = false;
+  std::string_view Maps {MapsFile};
 
-    uint64_t Offset = 0;
-    for (; Offset < Pages; ++Offset) {
-      if (MappedPages.test(Start - Offset)) {
-        Free = false;
-        break;
-      }
+  // 7ff5dd6d2000-7ff5dd6d3000 rw-p 0000a000 103:0b 1881447                   /usr/lib/x86_64-linux-gnu/libnss_compat.so.2
+  while (!Maps.empty()) {
+    const auto LineEnd = std::min(Maps.find('\n'), Maps.size());
+    const auto Line = Maps.substr(0, LineEnd);
+    Maps.remove_prefix(std::min(LineEnd + 1, Maps.size()));
+
+    uint64_t Begin {}, End {};
+    const auto BeginResult = std::from_chars(Line.data(), Line.data() + Line.size(), Begin, 16);
+    if (BeginResult.ec != std::errc {} || BeginResult.ptr == Line.data() + Line.size() || *BeginResult.ptr != '-') {
+      continue;
+    }
+    if (std::from_chars(BeginResult.ptr + 1, Line.data() + Line.size(), End, 16).ec != std::errc {}) {
+      continue;
     }
 
-    if (Free) {
-      return Start - Offset;
+    const uint64_t BeginPage = std::max(Begin >> FEXCore::Utils::FEX_PAGE_SHIFT, PageAddr);
+    const uint64_t EndPage = std::min(FEXCore::AlignUp(End, FEXCore::Utils::FEX_PAGE_SIZE) >> FEXCore::Utils::FEX_PAGE_SHIFT, RangeEnd);
+    if (BeginPage < EndPage) {
+      SetUsedPages(BeginPage, EndPage - BeginPage);
+      Found = true;
     }
-    Start -= Offset + 1;
   }
 
-  return 0;
+  return Found;
 }
 
 void* MemAllocator32Bit::Mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset) {
@@ -174,56 +223,28 @@ void* MemAllocator32Bit::Mmap(void* addr, size_t length, int prot, int flags, in
   flags &= ~FEX::HLE::X86_64_MAP_32BIT;
 
   auto AllocateNoHint = [&]() -> void* {
-    bool Wrapped = false;
-    uint64_t BottomPage = Map32Bit && (LastScanLocation >= LastKeyLocation32Bit) ? LastKeyLocation32Bit : LastScanLocation;
-restart: {
-  // Linear range scan
-  uint64_t LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
-  if (LowerPage == 0) {
-    // Try again but this time from the start
-    BottomPage = Map32Bit ? LastKeyLocation32Bit : LastKeyLocation;
-    LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
-  }
+    // Whatever was mapped there may be gone again by the time the maps are read, so the same range is retried.
+    uint32_t RaceRetries {};
+    while (true) {
+      const uint64_t LowerPage = FindPageRange(PagesLength, Map32Bit ? TOP_KEY32BIT : TOP_KEY);
+      if (LowerPage == 0) {
+        return reinterpret_cast<void*>(-ENOMEM);
+      }
 
-  uint64_t UpperPage = LowerPage + PagesLength;
-  if (LowerPage == 0) {
-    return reinterpret_cast<void*>(-ENOMEM);
-  }
-  {
-    // Try and map the range
-    void* MappedPtr =
-      ::mmap(reinterpret_cast<void*>(LowerPage << FEXCore::Utils::FEX_PAGE_SHIFT), length, prot, flags | FEX_MAP_FIXED_NOREPLACE, fd, offset);
+      // Try and map the range
+      void* MappedPtr = ::mmap(reinterpret_cast<void*>(LowerPage << FEXCore::Utils::FEX_PAGE_SHIFT), length, prot,
+                               flags | FEX_MAP_FIXED_NOREPLACE, fd, offset);
 
-    if (MappedPtr == MAP_FAILED && errno != EEXIST) {
-      return reinterpret_cast<void*>(-errno);
-    } else if (MappedPtr == MAP_FAILED) {
-      if (UpperPage == TOP_KEY) {
-        BottomPage = BASE_KEY;
-        Wrapped = true;
-        goto restart;
-      } else if (Wrapped && LowerPage >= LastScanLocation) {
-        // We linear scanned the entire memory range. Give up
-        return (void*)(uintptr_t)-errno;
-      } else {
-        // Try again
-        if (SearchDown) {
-          --BottomPage;
-        } else {
-          ++BottomPage;
-        }
-        goto restart;
-      }
-    } else {
-      if (SearchDown) {
-        LastScanLocation = LowerPage;
-      } else {
-        LastScanLocation = UpperPage;
+      if (MappedPtr != MAP_FAILED) {
+        SetUsedPages(LowerPage, PagesLength);
+        return MappedPtr;
+      } else if (errno != EEXIST) {
+        return reinterpret_cast<void*>(-errno);
+      } else if (!TrackUnknownMappings(LowerPage, PagesLength) && ++RaceRetries > MAX_UNKNOWN_MAPPING_RETRIES) {
+        // Whatever was mapped there keeps coming and going, don't keep racing it forever
+        return reinterpret_cast<void*>(-ENOMEM);
       }
-      SetUsedPages(LowerPage, PagesLength);
-      return MappedPtr;
     }
-  }
-}
   };
 
   // Find a region that fits our address
@@ -250,8 +271,6 @@ int MemAllocator32Bit::Munmap(void* addr, size_t length) {
   uintptr_t Addr = reinterpret_cast<uintptr_t>(addr);
   uintptr_t PageAddr = Addr >> FEXCore::Utils::FEX_PAGE_SHIFT;
 
-  uintptr_t PageEnd = PageAddr + PagesLength;
-
   // Both Addr and length must be page aligned
   if (Addr & ~FEXCore::Utils::FEX_PAGE_MASK) {
     return -EINVAL;
@@ -271,20 +290,14 @@ int MemAllocator32Bit::Munmap(void* addr, size_t length) {
     return 0;
   }
 
-  while (PageAddr != PageEnd) {
-    // Always pass to munmap, it may be something allocated we aren't tracking
-    int Result = ::munmap(reinterpret_cast<void*>(PageAddr << FEXCore::Utils::FEX_PAGE_SHIFT), FEXCore::Utils::FEX_PAGE_SIZE);
-    if (Result != 0) {
-      return -errno;
-    }
-
-    if (MappedPages.test(PageAddr)) {
-      MappedPages.reset(PageAddr);
-    }
-
-    ++PageAddr;
+  // Always pass to munmap, it may be something allocated we aren't tracking
+  int Result = ::munmap(addr, length);
+  if (Result != 0) {
+    return -errno;
   }
 
+  SetFreePages(PageAddr, PagesLength);
+
   return 0;
 }
 
@@ -327,17 +340,8 @@ void* MemAllocator32Bit::Mremap(void* old_address, size_t old_size, size_t new_s
           return reinterpret_cast<void*>(-errno);
         }
       } else {
-        // Scan the region forward from our first region's endd to see if it can be extended
-        bool CanExtend {true};
-
-        for (size_t i = OldPagesLength; i < NewPagesLength; ++i) {
-          if (MappedPages[OldPageAddr + i]) {
-            CanExtend = false;
-            break;
-          }
-        }
-
-        if (CanExtend) {
+        // Check if the pages after the region are free so it can be extended in place
+        if (IsFreeRange(OldPageAddr + OldPagesLength, NewPagesLength - OldPagesLength)) {
           void* MappedPtr = ::mremap(old_address, old_size, new_size, flags & ~MREMAP_MAYMOVE);
 
           if (MappedPtr != MAP_FAILED) {
@@ -437,59 +441,42 @@ uint64_t MemAllocator32Bit::Shmat(int shmid, const void* shmaddr, int shmflg, ui
       return -EINVAL;
     }
 
-    bool Wrapped = false;
-    uint64_t BottomPage = LastScanLocation;
-restart: {
-  // Linear range scan
-  uint64_t LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
-  if (LowerPage == 0) {
-    // Try again but this time from the start
-    BottomPage = LastKeyLocation;
-    LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
-  }
-
-  uint64_t UpperPage = LowerPage + PagesLength;
-  if (LowerPage == 0) {
-    return -ENOMEM;
-  }
-  {
-    // Try and map the range
-    void* MappedPtr = ::shmat(shmid, reinterpret_cast<const void*>(LowerPage << FEXCore::Utils::FEX_PAGE_SHIFT), shmflg);
-
-    if (MappedPtr == MAP_FAILED) {
-      if (UpperPage == TOP_KEY) {
-        BottomPage = LastKeyLocation;
-        Wrapped = true;
-        goto restart;
-      } else if (Wrapped && LowerPage >= LastScanLocation) {
-        // We linear scanned the entire memory range. Give up
-        return -errno;
-      } else {
-        // Try again
-        BottomPage += PagesLength;
-        goto restart;
-      }
-    } else {
-      if (SearchDown) {
-        LastScanLocation = LowerPage;
-      } else {
-        LastScanLocation = UpperPage;
+    uint32_t RaceRetries {};
+    while (true) {
+      const uint64_t LowerPage = FindPageRange(PagesLength, TOP_KEY);
+      if (LowerPage == 0) {
+        return -ENOMEM;
       }
-      // Set the range as mapped
-      SetUsedPages(LowerPage, PagesLength);
 
-      *ResultAddress = reinterpret_cast<uint64_t>(MappedPtr);
+      // Try and map the range
+      void* MappedPtr = ::shmat(shmid, reinterpret_cast<const void*>(LowerPage << FEXCore::Utils::FEX_PAGE_SHIFT), shmflg);
 
-      // Add to the map
-      PageToShm[LowerPage] = shmid;
+      if (MappedPtr != MAP_FAILED) {
+        // Set the range as mapped
+        SetUsedPages(LowerPage, PagesLength);
 
-      // Zero on working result
-      return 0;
+        *ResultAddress = reinterpret_cast<uint64_t>(MappedPtr);
+
+        // Add to the map
+        PageToShm[LowerPage] = shmid;
+
+        // Zero on working result
+        return 0;
+      }
+
+      // shmat fails with EINVAL when the range overlaps an existing mapping
+      const int Error = errno;
+      if (Error != EINVAL) {
+        return -Error;
+      }
+
+      if (!TrackUnknownMappings(LowerPage, PagesLength) && ++RaceRetries > MAX_UNKNOWN_MAPPING_RETRIES) {
+        return -Error;
+      }
     }
   }
 }
-  }
-}
+
 uint64_t MemAllocator32Bit::Shmdt(const void* shmaddr) {
   std::scoped_lock<std::mutex> lk {AllocMutex};
 
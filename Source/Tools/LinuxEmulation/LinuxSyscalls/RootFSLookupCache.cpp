@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: MIT
+#include "LinuxSyscalls/RootFSLookupCache.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/limits.h>
+#include <string_view>
+#include <sys/stat.h>
+
+namespace FEX::HLE {
+void RootFSLookupCache::Enable(int RootFSFD) {
+  this->RootFSFD = RootFSFD;
+  Entries = fextl::make_unique<EntryArray>();
+}
+
+std::optional<RootFSLookupCache::State> RootFSLookupCache::Lookup(uint64_t Hash) const {
+  const uint64_t Key = Hash & ~STATE_MASK;
+  for (size_t i = 0; i < MAX_PROBES; ++i) {
+    const auto Entry = (*Entries)[(Hash + i) % NUM_ENTRIES].load(std::memory_order_relaxed);
+    if (Entry == 0) {
+      return std::nullopt;
+    }
+    if ((Entry & ~STATE_MASK) == Key) {
+      return static_cast<State>(Entry & STATE_MASK);
+    }
+  }
+  return std::nullopt;
+}
+
+void RootFSLookupCache::Insert(uint64_t Hash, State NewState) const {
+  const uint64_t Key = Hash & ~STATE_MASK;
+  for (size_t i = 0; i < MAX_PROBES; ++i) {
+    uint64_t Expected = 0;
+    if ((*Entries)[(Hash + i) % NUM_ENTRIES].compare_exchange_strong(Expected, Key | NewState, std::memory_order_relaxed) ||
+        (Expected & ~STATE_MASK) == Key) {
+      // Inserted, or another thread raced us with the same prefix
+      return;
+    }
+  }
+  Full.store(true, std::memory_order_relaxed);
+}
+
+bool RootFSLookupCache::IsMissing(const char* Pathname) const {
+  if (!Entries) {
+    return false;
+  }
+
+  // FNV-1a over the path so far, extended one component at a time
+  uint64_t Hash = 0xcbf29ce484222325ULL;
+  const char* Component = Pathname;
+  while (*Component) {
+    const char* End = strchrnul(Component, '/');
+    const std::string_view Name(Component, End - Component);
+
+    if (Name == "..") {
+      // The prefix can't be checked without resolving where this leads
+      return false;
+    }
+
+    for (const char* c = Component; c != End; ++c) {
+      Hash = (Hash ^ static_cast<uint8_t>(*c)) * 0x100000001b3ULL;
+    }
+
+    if (!Name.empty() && Name != ".") {
+      auto PrefixState = Lookup(Hash);
+      if (!PrefixState) {
+        const size_t Length = End - Pathname;
+        if (Full.load(std::memory_order_relaxed) || Length >= PATH_MAX) {
+          return false;
+        }
+
+        // Symlinks aren't followed, so that every cached prefix only consists of real directories
+        char Prefix[PATH_MAX];
+        memcpy(Prefix, Pathname, Length);
+        Prefix[Length] = 0;
+        struct stat Buffer {};
+        if (fstatat(RootFSFD, Prefix, &Buffer, AT_SYMLINK_NOFOLLOW) == 0) {
+          PrefixState = S_ISDIR(Buffer.st_mode) ? STATE_DIRECTORY : STATE_OTHER;
+        } else if (errno == ENOENT) {
+          PrefixState = STATE_MISSING;
+        } else {
+          return false;
+        }
+        Insert(Hash, *PrefixState);
+      }
+
+      if (*PrefixState == STATE_MISSING) {
+        return true;
+      } else if (*PrefixState == STATE_OTHER) {
+        return false;
+      }
+    }
+
+    if (*End == 0) {
+      break;
+    }
+    Hash = (Hash ^ '/') * 0x100000001b3ULL;
+    Component = End + 1;
+  }
+
+  return false;
+}
+} // namespace FEX::HLE
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/fextl/memory.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace FEX::HLE {
+/**
+ * Remembers which RootFS path prefixes are missing, so paths that only exist on the host skip the RootFS lookup.
+ *
+ * Entries are never invalidated, so this must only be enabled for a RootFS that can't change.
+ * Lookups are lock-free, a guest signal or fork can't leave the cache locked.
+ */
+class RootFSLookupCache final {
+public:
+  // RootFSFD must stay open for as long as the cache is used
+  void Enable(int RootFSFD);
+
+  // Returns true if the RootFS relative path can't exist because it or one of its prefixes is missing.
+  bool IsMissing(const char* Pathname) const;
+
+private:
+  enum State : uint64_t {
+    STATE_DIRECTORY = 1,
+    STATE_MISSING = 2,
+    // Symlinks and files, which end the walk
+    STATE_OTHER = 3,
+  };
+  static constexpr uint64_t STATE_MASK = 3;
+  static constexpr size_t NUM_ENTRIES = 8192;
+  static constexpr size_t MAX_PROBES = 8;
+
+  // Each entry holds the hash of a prefix with the state in the low bits, or zero if unused
+  using EntryArray = std::array<std::atomic<uint64_t>, NUM_ENTRIES>;
+
+  std::optional<State> Lookup(uint64_t Hash) const;
+  void Insert(uint64_t Hash, State NewState) const;
+
+  int RootFSFD {-1};
+  fextl::unique_ptr<EntryArray> Entries;
+  // Set once an insert fails, after which unknown prefixes aren't probed anymore
+  mutable std::atomic<bool> Full {};
+};
+} // namespace FEX::HLE
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Built-in sampling profiler attributing JIT time to guest code
+$end_info$
+*/
+
+#include "ArchHelpers/MContext.h"
+#include "LinuxSyscalls/SamplingProfiler.h"
+#include "LinuxSyscalls/SignalDelegator.h"
+#include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/ThreadManager.h"
+
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/SignalDelegator.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/robin_map.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace FEX::HLE {
+SamplingProfiler::SamplingProfiler(FEXCore::Context::Context* CTX, uint32_t Frequency, fextl::string OutputPrefix)
+  : CTX {CTX}
+  , IntervalNS {1'000'000'000ULL / std::max<uint32_t>(Frequency, 1)}
+  , OutputPrefix {std::move(OutputPrefix)} {
+  FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
+  Is64Bit = Is64BitMode();
+
+  // Pages are only populated as samples come in
+  Buffer = reinterpret_cast<uint64_t*>(
+    FEXCore::Allocator::mmap(nullptr, BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+  LOGMAN_THROW_A_FMT(Buffer != MAP_FAILED, "Failed to allocate sampling profiler buffer");
+  FEXCore::Allocator::VirtualName("FEXMem_Misc", Buffer, BUFFER_SIZE);
+}
+
+SamplingProfiler::~SamplingProfiler() {
+  FEXCore::Allocator::munmap(Buffer, BUFFER_SIZE);
+}
+
+void SamplingProfiler::StartThread(FEX::HLE::ThreadStateObject* Thread) {
+  // Raw syscalls are used since glibc's timer IDs don't map to kernel timer IDs for SIGEV_THREAD_ID
+  sigevent Event {};
+  Event.sigev_notify = SIGEV_THREAD_ID;
+  Event.sigev_signo = SignalDelegator::SIGNAL_FOR_PROFILING;
+  Event.sigev_value.sival_ptr = this;
+  Event._sigev_un._tid = FHU::Syscalls::gettid();
+
+  int TimerID {};
+  if (::syscall(SYS_timer_create, CLOCK_THREAD_CPUTIME_ID, &Event, &TimerID) == -1) {
+    LogMan::Msg::EFmt("Failed to create sampling profiler timer: {}", strerror(errno));
+    return;
+  }
+
+  const itimerspec Interval {
+    .it_interval = {.tv_sec = static_cast<time_t>(IntervalNS / 1'000'000'000ULL), .tv_nsec = static_cast<long>(IntervalNS % 1'000'000'000ULL)},
+    .it_value = {.tv_sec = static_cast<time_t>(IntervalNS / 1'000'000'000ULL), .tv_nsec = static_cast<long>(IntervalNS % 1'000'000'000ULL)},
+  };
+  ::syscall(SYS_timer_settime, TimerID, 0, &Interval, nullptr);
+  Thread->ProfilerTimerID = TimerID;
+}
+
+void SamplingProfiler::StopThread(FEX::HLE::ThreadStateObject* Thread) {
+  if (Thread->ProfilerTimerID != -1) {
+    ::syscall(SYS_timer_delete, Thread->ProfilerTimerID);
+    Thread->ProfilerTimerID = -1;
+  }
+}
+
+size_t SamplingProfiler::WalkGuestStack(uint64_t RBP, std::span<uint64_t> Frames) const {
+  // Guest memory is read using process_vm_readv since the stack may be unmapped or garbage
+  // in functions that don't maintain a frame pointer. This avoids faulting inside the signal handler.
+  const size_t WordSize = Is64Bit ? 8 : 4;
+  const pid_t PID = ::getpid();
+
+  size_t NumFrames = 0;
+  while (NumFrames < Frames.size() && RBP != 0) {
+    // Each frame holds the caller's frame pointer followed by the return address
+    uint64_t Record[2] {};
+    uint32_t Record32[2] {};
+    iovec Local {.iov_base = Is64Bit ? static_cast<void*>(Record) : static_cast<void*>(Record32), .iov_len = WordSize * 2};
+    iovec Remote {.iov_base = reinterpret_cast<void*>(RBP), .iov_len = WordSize * 2};
+    if (::process_vm_readv(PID, &Local, 1, &Remote, 1, 0) != static_cast<ssize_t>(WordSize * 2)) {
+      break;
+    }
+    if (!Is64Bit) {
+      Record[0] = Record32[0];
+      Record[1] = Record32[1];
+    }
+
+    const auto [NextRBP, ReturnAddress] = Record;
+    if (ReturnAddress == 0) {
+      break;
+    }
+    Frames[NumFrames++] = ReturnAddress;
+
+    // Stacks grow down, so caller frames must be at higher addresses. Bail on obviously broken chains.
+    if (NextRBP <= RBP || NextRBP - RBP > 16 * 1024 * 1024) {
+      break;
+    }
+    RBP = NextRBP;
+  }
+  return NumFrames;
+}
+
+bool SamplingProfiler::HandleSignal(FEXCore::Core::InternalThreadState* Thread, const FEXCore::SignalDelegatorConfig& Config, void* Info,
+                                    void* UContext) {
+  const auto* SigInfo = reinterpret_cast<const siginfo_t*>(Info);
+  if (SigInfo->si_code != SI_TIMER || SigInfo->si_value.sival_ptr != this) {
+    // Not ours, let the guest handle it
+    return false;
+  }
+
+  const auto Frame = Thread->CurrentFrame;
+  uint64_t Sample[1 + 1 + MAX_STACK_DEPTH];
+  uint64_t Flags = 0;
+  uint64_t RBP = Frame->State.gregs[FEXCore::X86State::REG_RBP];
+
+  const auto PC = ArchHelpers::Context::GetPc(UContext);
+#ifdef ARCHITECTURE_arm64
+  if (CTX->IsAddressInCodeBuffer(Thread, PC)) {
+    // Guest registers are still statically allocated in host registers
+    Sample[1] = CTX->RestoreRIPFromHostPC(Thread, PC);
+    RBP = ArchHelpers::Context::GetArmReg(UContext, Config.SRAGPRMapping[FEXCore::X86State::REG_RBP]);
+  } else
+#endif
+  {
+    // Outside of JIT code, RIP points to the entry of the block that was last executed
+    Sample[1] = Frame->State.rip;
+    Flags |= SAMPLE_IN_FEX;
+  }
+
+  const size_t NumFrames = 1 + WalkGuestStack(RBP, std::span {Sample + 2, MAX_STACK_DEPTH});
+  Sample[0] = (NumFrames << 1) | Flags;
+
+  const size_t SampleSize = 1 + NumFrames;
+  const size_t Offset = BufferOffset.fetch_add(SampleSize, std::memory_order_relaxed);
+  if ((Offset + SampleSize) * sizeof(uint64_t) > BUFFER_SIZE) {
+    DroppedSamples.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // The header is written last so that readers never observe partially written samples
+  memcpy(&Buffer[Offset + 1], &Sample[1], NumFrames * sizeof(uint64_t));
+  std::atomic_ref(Buffer[Offset]).store(Sample[0], std::memory_order_release);
+  return true;
+}
+
+void SamplingProfiler::WriteProfile(FEXCore::Core::InternalThreadState* Thread) {
+  std::lock_guard lk(WriteMutex);
+
+  fextl::robin_map<uint64_t, fextl::string> FrameNames;
+  const auto ResolveFrame = [&](uint64_t RIP) -> const fextl::string& {
+    auto It = FrameNames.find(RIP);
+    if (It != FrameNames.end()) {
+      return It->second;
+    }
+
+    fextl::string Name;
+    if (auto Section = FEX::HLE::_SyscallHandler->LookupExecutableFileSection(Thread, RIP)) {
+      std::string_view Filename = Section->FileInfo.Filename;
+      Filename = Filename.substr(Filename.find_last_of('/') + 1);
+      Name = fextl::fmt::format("{}+{:#x}", Filename, RIP - Section->FileStartVA);
+      // Semicolons separate frames in the collapsed stack format
+      std::replace(Name.begin(), Name.end(), ';', '_');
+    } else {
+      Name = fextl::fmt::format("{:#x}", RIP);
+    }
+    return FrameNames.emplace(RIP, std::move(Name)).first->second;
+  };
+
+  // Ordered so that the output is stable across runs
+  fextl::map<fextl::string, uint64_t> Stacks;
+  const size_t End = std::min(BufferOffset.load(std::memory_order_relaxed), BUFFER_SIZE / sizeof(uint64_t));
+  size_t NumSamples = 0;
+  fextl::string Stack;
+  for (size_t Offset = 0; Offset < End;) {
+    const uint64_t Header = std::atomic_ref(Buffer[Offset]).load(std::memory_order_acquire);
+    const size_t NumFrames = Header >> 1;
+    if (NumFrames == 0 || Offset + 1 + NumFrames > End) {
+      // Sample is still being written or was dropped
+      break;
+    }
+
+    // Collapsed stacks list the outermost frame first
+    Stack.clear();
+    for (size_t i = NumFrames; i != 0; --i) {
+      if (!Stack.empty()) {
+        Stack += ';';
+      }
+      Stack += ResolveFrame(Buffer[Offset + i]);
+    }
+    if (Header & SAMPLE_IN_FEX) {
+      Stack += ";[FEX]";
+    }
+    ++Stacks[Stack];
+    ++NumSamples;
+    Offset += 1 + NumFrames;
+  }
+
+  // Forked children write their own profile
+  const auto OutputFile = fextl::fmt::format("{}-{}.folded", OutputPrefix, ::getpid());
+  int FD = ::open(OutputFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (FD == -1) {
+    LogMan::Msg::EFmt("Failed to open sampling profiler output {}: {}", OutputFile, strerror(errno));
+    return;
+  }
+
+  fextl::string Output;
+  for (const auto& [CollapsedStack, Count] : Stacks) {
+    Output += fextl::fmt::format("{} {}\n", CollapsedStack, Count);
+  }
+  for (size_t Written = 0; Written < Output.size();) {
+    auto Result = ::write(FD, Output.data() + Written, Output.size() - Written);
+    if (Result <= 0) {
+      break;
+    }
+    Written += Result;
+  }
+  close(FD);
+
+  LogMan::Msg::IFmt("Wrote {} profiler samples to {} ({} dropped)", NumSamples, OutputFile, DroppedSamples.load(std::memory_order_relaxed));
+}
+
+void SamplingProfiler::ResetAfterFork(FEX::HLE::ThreadStateObject* LiveThread) {
+  // Timers aren't inherited by the child, and the parent's samples are written by the parent
+  BufferOffset.store(0, std::memory_order_relaxed);
+  DroppedSamples.store(0, std::memory_order_relaxed);
+  ::madvise(Buffer, BUFFER_SIZE, MADV_DONTNEED);
+
+  LiveThread->ProfilerTimerID = -1;
+  StartThread(LiveThread);
+}
+} // namespace FEX::HLE
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Built-in sampling profiler attributing JIT time to guest code
+$end_info$
+*/
+
+#pragma once
+
+#include <FEXCore/Utils/AllocatorHooks.h>
+#include <FEXCore/fextl/string.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+namespace FEXCore::Context {
+class Context;
+}
+namespace FEXCore::Core {
+struct InternalThreadState;
+}
+namespace FEXCore {
+struct SignalDelegatorConfig;
+}
+
+namespace FEX::HLE {
+struct ThreadStateObject;
+
+/**
+ * Samples guest threads on a per-thread CPU time timer and writes the results as collapsed stacks.
+ *
+ * Each sample maps the interrupted host PC back to a guest RIP and walks the guest frame-pointer chain.
+ * Samples are appended to a preallocated buffer from the signal handler, and frames are only resolved
+ * to "module+offset" once the profile is written (on exit or execve).
+ *
+ * The output can be consumed by flamegraph.pl, speedscope, or any other tool that accepts the collapsed stack format.
+ */
+class SamplingProfiler final : public FEXCore::Allocator::FEXAllocOperators {
+public:
+  SamplingProfiler(FEXCore::Context::Context* CTX, uint32_t Frequency, fextl::string OutputPrefix);
+  ~SamplingProfiler();
+
+  // Arms or disarms the sampling timer for the calling thread
+  void StartThread(FEX::HLE::ThreadStateObject* Thread);
+  void StopThread(FEX::HLE::ThreadStateObject* Thread);
+
+  // Records a sample for a profiler signal. Returns false if the signal wasn't sent by the profiler timer.
+  bool HandleSignal(FEXCore::Core::InternalThreadState* Thread, const FEXCore::SignalDelegatorConfig& Config, void* Info, void* UContext);
+
+  // Resolves all samples collected so far and (re)writes the output file
+  void WriteProfile(FEXCore::Core::InternalThreadState* Thread);
+
+  // Drops samples inherited from the parent process and re-arms the timer of the only surviving thread
+  void ResetAfterFork(FEX::HLE::ThreadStateObject* LiveThread);
+
+private:
+  constexpr static size_t MAX_STACK_DEPTH = 64;
+  constexpr static size_t BUFFER_SIZE = 128 * 1024 * 1024;
+
+  // Marks samples that were taken outside of JIT code, e.g. during compilation or syscalls
+  constexpr static uint64_t SAMPLE_IN_FEX = 1;
+
+  size_t WalkGuestStack(uint64_t RBP, std::span<uint64_t> Frames) const;
+
+  FEXCore::Context::Context* CTX;
+  const uint64_t IntervalNS;
+  const fextl::string OutputPrefix;
+  bool Is64Bit;
+
+  // Each sample is a header ((NumFrames << 1) | flags) followed by its guest RIPs, innermost first
+  uint64_t* Buffer;
+  std::atomic<size_t> BufferOffset {};
+  std::atomic<uint64_t> DroppedSamples {};
+
+  std::mutex WriteMutex;
+};
+} // namespace FEX::HLE
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/Utils/AllocatorHooks.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace FEX::HLE {
+/**
+ * Per-thread bump allocator for syscall argument marshaling, so converting guest structures
+ * doesn't need a heap allocation on every syscall.
+ *
+ * Allocations are released in LIFO order when their Scope ends. A guest signal handler that
+ * interrupts a syscall and makes its own always releases its scope before the interrupted syscall
+ * resumes, so nesting is safe without deferring signals.
+ */
+class ScratchArena final {
+public:
+  // Fits IOV_MAX iovecs or a few thousand epoll events. Larger requests fall back to the heap.
+  static constexpr size_t SIZE = 64 * 1024;
+
+  ScratchArena() = default;
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+  ~ScratchArena() {
+    FEXCore::Allocator::free(Base);
+  }
+
+  class Scope final {
+  public:
+    explicit Scope(ScratchArena& Arena)
+      : Arena {Arena}
+      , Offset {Arena.Offset} {}
+
+    ~Scope() {
+      // Don't let the compiler sink any use of the allocations past the release
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+      Arena.Offset = Offset;
+
+      for (auto Ptr : HeapAllocations) {
+        FEXCore::Allocator::free(Ptr);
+      }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // Uninitialized storage for Count objects, valid until the scope ends
+    template<typename T>
+    T* Allocate(size_t Count) {
+      static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+      return static_cast<T*>(Arena.Allocate(sizeof(T) * Count, alignof(T), HeapAllocations));
+    }
+
+    // Converts Count guest structures to their host layout, or the other way around.
+    // The loop is kept trivial so the compiler can vectorize the widening or narrowing.
+    template<typename To, typename From>
+    To* Convert(const From* Src, size_t Count) {
+      auto Dst = Allocate<To>(Count);
+      std::copy_n(Src, Count, Dst);
+      return Dst;
+    }
+
+  private:
+    ScratchArena& Arena;
+    size_t Offset;
+    fextl::vector<void*> HeapAllocations;
+  };
+
+private:
+  void* Allocate(size_t Size, size_t Alignment, fextl::vector<void*>& HeapAllocations) {
+    if (!Base) {
+      Base = static_cast<std::byte*>(FEXCore::Allocator::aligned_alloc(alignof(std::max_align_t), SIZE));
+    }
+
+    const size_t Start = FEXCore::AlignUp(Offset, Alignment);
+    if (Base && Start <= SIZE && Size <= SIZE - Start) {
+      Offset = Start + Size;
+      // A nested scope from a signal handler must see the new offset before the memory is used
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+      return Base + Start;
+    }
+
+    auto Ptr = FEXCore::Allocator::aligned_alloc(Alignment, FEXCore::AlignUp(std::max<size_t>(Size, 1), Alignment));
+    HeapAllocations.emplace_back(Ptr);
+    return Ptr;
+  }
+
+  std::byte* Base {};
+  size_t Offset {};
+};
+} // namespace FEX::HLE
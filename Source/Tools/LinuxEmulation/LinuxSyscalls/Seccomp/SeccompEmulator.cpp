@@ -164,6 +164,11 @@ void SeccompEmulator::InheritSeccompFilters(FEX::HLE::ThreadStateObject* Parent,
 
   // Copy the operating mode.
   Child->SeccompMode = Parent->SeccompMode;
+  UpdateForceSyscallHandler(Child);
+}
+
+void SeccompEmulator::UpdateForceSyscallHandler(FEX::HLE::ThreadStateObject* Thread) {
+  Thread->Thread->CurrentFrame->ForceSyscallHandler = !Thread->Filters.empty();
 }
 
 void SeccompEmulator::FreeSeccompFilters(FEX::HLE::ThreadStateObject* Thread) {
@@ -179,6 +184,7 @@ void SeccompEmulator::FreeSeccompFilters(FEX::HLE::ThreadStateObject* Thread) {
     }
   }
   Thread->Filters.clear();
+  UpdateForceSyscallHandler(Thread);
 
   if (HasFiltersToDelete) {
     // Garbage collect filters
@@ -309,6 +315,7 @@ void SeccompEmulator::DeserializeFilters(FEXCore::Core::CpuStateFrame* Frame, in
 
     // Append the filter to the thread.
     Thread->Filters.emplace_back(&it);
+    UpdateForceSyscallHandler(Thread);
   }
 
   Thread->SeccompMode = Header.SeccompMode;
@@ -592,6 +599,7 @@ void SeccompEmulator::TSyncFilters(FEXCore::Core::CpuStateFrame* Frame) {
       std::atomic_ref<uint64_t>(Filter->RefCount)++;
     }
     Thread->SeccompMode = ParentThread->SeccompMode;
+    UpdateForceSyscallHandler(Thread);
   }
 }
 
@@ -673,6 +681,7 @@ uint64_t SeccompEmulator::SetModeFilter(FEXCore::Core::CpuStateFrame* Frame, uin
     // Append the filter to the thread.
     Thread->Filters.emplace_back(&it);
     Thread->SeccompMode = SECCOMP_MODE_FILTER;
+    UpdateForceSyscallHandler(Thread);
     if (flags & SECCOMP_FILTER_FLAG_TSYNC) {
       TSyncFilters(Frame);
     }
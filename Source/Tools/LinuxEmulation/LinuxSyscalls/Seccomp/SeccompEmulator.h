@@ -96,6 +96,10 @@ private:
   uint64_t CanDoTSync(FEXCore::Core::CpuStateFrame* Frame);
   void TSyncFilters(FEXCore::Core::CpuStateFrame* Frame);
 
+  // The JIT does some passthrough syscalls inline, which would skip the filters.
+  // Force those through the SyscallHandler while the thread has any filters installed.
+  static void UpdateForceSyscallHandler(FEX::HLE::ThreadStateObject* Thread);
+
   static void DumpProgram(const sock_fprog* prog);
 
   // Multiple filter instruction count penalty.
@@ -6,6 +6,8 @@ desc: Handles host -> host and host -> guest signal routing, emulates procmask &
 $end_info$
 */
 
+#include "Common/FEXServerClient.h"
+#include "LinuxSyscalls/SamplingProfiler.h"
 #include "LinuxSyscalls/SignalDelegator.h"
 #include "LinuxSyscalls/Syscalls.h"
 
@@ -60,7 +62,7 @@ static FEX::HLE::ThreadStateObject* GetThreadFromAltStack(const stack_t& alt_sta
 static void SignalHandlerThunk(int Signal, siginfo_t* Info, void* UContext) {
   ucontext_t* _context = (ucontext_t*)UContext;
   auto ThreadObject = GetThreadFromAltStack(_context->uc_stack);
-  FEXCORE_PROFILE_ACCUMULATION(ThreadObject->Thread, AccumulatedSignalTime);
+  FEXCORE_PROFILE_ACCUMULATION_HISTOGRAM(ThreadObject->Thread, AccumulatedSignalTime, SignalTimeHistogram);
   ThreadObject->SignalInfo.Delegator->HandleSignal(ThreadObject, Signal, Info, UContext);
 }
 
@@ -986,6 +988,23 @@ SignalDelegator::SignalDelegator(FEXCore::Context::Context* _CTX, const std::str
   // Register pause signal handler.
   RegisterHostSignalHandler(SignalDelegator::SIGNAL_FOR_PAUSE, PauseHandler, true);
 
+  FEX_CONFIG_OPT(SamplingProfilerFrequency, SAMPLINGPROFILERFREQUENCY);
+  if (SamplingProfilerFrequency()) {
+    FEX_CONFIG_OPT(SamplingProfilerOutput, SAMPLINGPROFILEROUTPUT);
+    fextl::string OutputFolder = SamplingProfilerOutput();
+    if (OutputFolder.empty()) {
+      OutputFolder = FEXServerClient::GetTempFolder();
+    }
+    Profiler = fextl::make_unique<SamplingProfiler>(
+      CTX, SamplingProfilerFrequency(), fextl::fmt::format("{}/{}", OutputFolder, ApplicationName.empty() ? "FEX" : ApplicationName));
+
+    const auto ProfilerHandler = [](FEXCore::Core::InternalThreadState* Thread, int Signal, void* info, void* ucontext) -> bool {
+      auto Delegator = FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(Thread)->SignalInfo.Delegator;
+      return Delegator->Profiler->HandleSignal(Thread, Delegator->GetConfig(), info, ucontext);
+    };
+    RegisterHostSignalHandler(SignalDelegator::SIGNAL_FOR_PROFILING, ProfilerHandler, true);
+  }
+
   // Guest signal handlers.
   for (uint32_t Signal = 0; Signal <= SignalDelegator::MAX_SIGNALS; ++Signal) {
     RegisterHostSignalHandlerForGuest(Signal, GuestSignalHandler);
@@ -1032,6 +1051,10 @@ void SignalDelegator::RegisterTLSState(FEX::HLE::ThreadStateObject* Thread) {
   // Get the current host signal mask
   ::syscall(SYS_rt_sigprocmask, 0, nullptr, &Thread->SignalInfo.CurrentSignalMask.Val, 8);
 
+  if (Thread->Thread && Profiler) {
+    Profiler->StartThread(Thread);
+  }
+
   if (Thread->Thread) {
     // Reserve a small amount of deferred signal frames. Usually the stack won't be utilized beyond
     // 1 or 2 signals but add a few more just in case.
@@ -1040,6 +1063,10 @@ void SignalDelegator::RegisterTLSState(FEX::HLE::ThreadStateObject* Thread) {
 }
 
 void SignalDelegator::UninstallTLSState(FEX::HLE::ThreadStateObject* Thread) {
+  if (Profiler) {
+    Profiler->StopThread(Thread);
+  }
+
   FEXCore::Allocator::munmap(Thread->SignalInfo.AltStackPtr, SIGSTKSZ * 16);
 
   Thread->SignalInfo.AltStackPtr = nullptr;
@@ -36,6 +36,7 @@ struct InternalThreadState;
 }
 namespace FEX::HLE {
 enum class SignalEvent : uint32_t;
+class SamplingProfiler;
 struct ThreadStateObject;
 } // namespace FEX::HLE
 
@@ -52,6 +53,9 @@ public:
   // 64 is used internally by Valgrind
   constexpr static size_t SIGNAL_FOR_PAUSE {63};
 
+  // Only installed when the sampling profiler is enabled, see SamplingProfiler
+  constexpr static size_t SIGNAL_FOR_PROFILING {62};
+
   // Returns true if the host handled the signal
   // Arguments are the same as sigaction handler
   SignalDelegator(FEXCore::Context::Context* _CTX, const std::string_view ApplicationName, bool SupportsAVX, bool SupportsSVE256);
@@ -144,6 +148,15 @@ public:
 
   void SaveTelemetry();
 
+  // Returns nullptr unless the sampling profiler is enabled
+  SamplingProfiler* GetProfiler() const {
+    return Profiler.get();
+  }
+
+  const fextl::string& GetApplicationName() const {
+    return ApplicationName;
+  }
+
   void SpillSRA(FEXCore::Core::InternalThreadState* Thread, void* ucontext, uint32_t IgnoreMask);
 
 private:
@@ -198,6 +211,8 @@ private:
   bool SupportsAVX;
   bool SupportsSVE256;
 
+  fextl::unique_ptr<SamplingProfiler> Profiler;
+
   // Called from the thunk handler to handle the signal
   void HandleGuestSignal(FEX::HLE::ThreadStateObject* ThreadObject, int Signal, void* Info, void* UContext);
   bool HandleFrontendSIGSEGV(FEXCore::Core::InternalThreadState* Thread, int Signal, void* Info, void* UContext);
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Per-syscall counts and latency accounting
+$end_info$
+*/
+
+#include "LinuxSyscalls/SyscallStats.h"
+
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <span>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+#include <utility>
+
+namespace FEX::HLE {
+namespace {
+  using SyscallNameTable = std::span<const std::pair<int, const char*>>;
+
+  constexpr std::pair<int, const char*> x64SyscallNames[] = {
+#include "LinuxSyscalls/x64/SyscallsNames.inl"
+  };
+
+  constexpr std::pair<int, const char*> x32SyscallNames[] = {
+#include "LinuxSyscalls/x32/SyscallsNames.inl"
+  };
+
+  uint64_t GetMonotonicNS() {
+    timespec Time {};
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+    return Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec;
+  }
+
+  uint64_t GetThreadUserNS() {
+    rusage Usage {};
+    getrusage(RUSAGE_THREAD, &Usage);
+    return Usage.ru_utime.tv_sec * 1'000'000'000ULL + Usage.ru_utime.tv_usec * 1'000ULL;
+  }
+} // namespace
+
+SyscallStats::SyscallStats(bool Is64Bit, size_t NumSyscalls, fextl::string OutputPrefix)
+  : Is64Bit {Is64Bit}
+  , OutputPrefix {std::move(OutputPrefix)}
+  , Entries(NumSyscalls) {}
+
+// The user time is sampled outside of the wall clock window so that getrusage itself isn't accounted to the host
+SyscallStats::Scope::Scope(SyscallStats& Stats, uint64_t Syscall)
+  : Stats {Stats}
+  , Syscall {Syscall}
+  , BeginUserNS {GetThreadUserNS()} {
+  BeginNS = GetMonotonicNS();
+}
+
+SyscallStats::Scope::~Scope() {
+  const auto TotalNS = GetMonotonicNS() - BeginNS;
+  const auto UserNS = GetThreadUserNS() - BeginUserNS;
+
+  auto& Entry = Stats.Entries[Syscall];
+  Entry.Count.fetch_add(1, std::memory_order_relaxed);
+  Entry.TotalNS.fetch_add(TotalNS, std::memory_order_relaxed);
+  Entry.FEXNS.fetch_add(std::min(UserNS, TotalNS), std::memory_order_relaxed);
+}
+
+void SyscallStats::Write() {
+  std::lock_guard lk(WriteMutex);
+
+  fextl::vector<const char*> Names(Entries.size());
+  for (auto [Number, Name] : Is64Bit ? SyscallNameTable {x64SyscallNames} : SyscallNameTable {x32SyscallNames}) {
+    if (static_cast<size_t>(Number) < Names.size()) {
+      Names[Number] = Name;
+    }
+  }
+
+  struct Row {
+    size_t Syscall;
+    uint64_t Count;
+    uint64_t TotalNS;
+    uint64_t FEXNS;
+  };
+  fextl::vector<Row> Rows;
+  uint64_t TotalNS = 0;
+  for (size_t i = 0; i < Entries.size(); ++i) {
+    const auto Count = Entries[i].Count.load(std::memory_order_relaxed);
+    if (Count) {
+      Rows.push_back({i, Count, Entries[i].TotalNS.load(std::memory_order_relaxed), Entries[i].FEXNS.load(std::memory_order_relaxed)});
+      TotalNS += Rows.back().TotalNS;
+    }
+  }
+  std::ranges::sort(Rows, [](const Row& LHS, const Row& RHS) { return LHS.TotalNS > RHS.TotalNS; });
+
+  fextl::string Output = fextl::fmt::format("{:>7} {:>12} {:>12} {:>10} {:>7} {:>7}  {}\n", "Time%", "Calls", "Total us", "us/call",
+                                            "FEX%", "Host%", "Syscall");
+  for (const auto& Row : Rows) {
+    const auto FEXPercent = Row.TotalNS ? 100.0 * Row.FEXNS / Row.TotalNS : 0.0;
+    const auto Name = Names[Row.Syscall] ? fextl::string(Names[Row.Syscall]) : fextl::fmt::format("syscall_{}", Row.Syscall);
+    Output += fextl::fmt::format("{:>6.2f}% {:>12} {:>12} {:>10.2f} {:>6.2f}% {:>6.2f}%  {}\n",
+                                 TotalNS ? 100.0 * Row.TotalNS / TotalNS : 0.0, Row.Count, Row.TotalNS / 1000,
+                                 Row.TotalNS / 1000.0 / Row.Count, FEXPercent, 100.0 - FEXPercent, Name);
+  }
+
+  // Forked children write their own statistics
+  const auto OutputFile = fextl::fmt::format("{}-{}.syscalls", OutputPrefix, ::getpid());
+  int FD = ::open(OutputFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (FD == -1) {
+    LogMan::Msg::EFmt("Failed to open syscall statistics output {}: {}", OutputFile, strerror(errno));
+    return;
+  }
+
+  for (size_t Written = 0; Written < Output.size();) {
+    auto Result = ::write(FD, Output.data() + Written, Output.size() - Written);
+    if (Result <= 0) {
+      break;
+    }
+    Written += Result;
+  }
+  close(FD);
+
+  LogMan::Msg::IFmt("Wrote statistics for {} syscalls to {}", Rows.size(), OutputFile);
+}
+
+void SyscallStats::ResetAfterFork() {
+  for (auto& Entry : Entries) {
+    Entry.Count.store(0, std::memory_order_relaxed);
+    Entry.TotalNS.store(0, std::memory_order_relaxed);
+    Entry.FEXNS.store(0, std::memory_order_relaxed);
+  }
+}
+} // namespace FEX::HLE
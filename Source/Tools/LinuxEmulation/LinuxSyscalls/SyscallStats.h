@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Per-syscall counts and latency accounting
+$end_info$
+*/
+
+#pragma once
+
+#include <FEXCore/Utils/AllocatorHooks.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace FEX::HLE {
+/**
+ * Records how often each guest syscall is issued and where its time goes.
+ *
+ * Time is split between FEX (user mode CPU time spent marshaling and emulating the syscall)
+ * and the host (time spent in the kernel or blocked in it). User CPU time comes from
+ * RUSAGE_THREAD, so its precision depends on the host kernel's CPU time accounting.
+ */
+class SyscallStats final : public FEXCore::Allocator::FEXAllocOperators {
+public:
+  SyscallStats(bool Is64Bit, size_t NumSyscalls, fextl::string OutputPrefix);
+
+  class Scope final {
+  public:
+    Scope(SyscallStats& Stats, uint64_t Syscall);
+    ~Scope();
+
+  private:
+    SyscallStats& Stats;
+    uint64_t Syscall;
+    uint64_t BeginNS;
+    uint64_t BeginUserNS;
+  };
+
+  // (Re)writes the output file with the statistics collected so far
+  void Write();
+
+  // Drops statistics inherited from the parent process
+  void ResetAfterFork();
+
+private:
+  struct Entry {
+    std::atomic<uint64_t> Count;
+    std::atomic<uint64_t> TotalNS;
+    std::atomic<uint64_t> FEXNS;
+  };
+
+  const bool Is64Bit;
+  const fextl::string OutputPrefix;
+  fextl::vector<Entry> Entries;
+  std::mutex WriteMutex;
+};
+} // namespace FEX::HLE
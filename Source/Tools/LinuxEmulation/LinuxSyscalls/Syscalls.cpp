@@ -8,12 +8,14 @@ $end_info$
 */
 
 #include "CodeLoader.h"
+#include "Common/FEXServerClient.h"
 
 #include "FEXHeaderUtils/StringArgumentParser.h"
 #include "Linux/Utils/ELFContainer.h"
 #include "Linux/Utils/ELFParser.h"
 
 #include "LinuxSyscalls/LinuxAllocator.h"
+#include "LinuxSyscalls/SamplingProfiler.h"
 #include "LinuxSyscalls/SignalDelegator.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/Syscalls/Thread.h"
@@ -48,6 +50,7 @@ $end_info$
 #include <linux/audit.h>
 #include <linux/seccomp.h>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <sched.h>
 #include <span>
@@ -199,6 +202,15 @@ static fextl::string GetShebangInterpFilename(const fextl::string& Filename) {
 uint64_t ExecveHandler(FEXCore::Core::CpuStateFrame* Frame, const char* pathname, char* const* argv, char* const* envp, ExecveAtArgs Args) {
   auto SyscallHandler = FEX::HLE::_SyscallHandler;
   Frame->Thread->CTX->FlushAndCloseCodeMap();
+  Frame->Thread->CTX->WriteBlockStats(Frame->Thread);
+  Frame->Thread->CTX->FlushCompileTrace();
+  Frame->Thread->CTX->FlushJITSymbols(Frame->Thread);
+  if (auto Profiler = SyscallHandler->GetSignalDelegator()->GetProfiler()) {
+    Profiler->WriteProfile(Frame->Thread);
+  }
+  if (auto Stats = SyscallHandler->GetSyscallStats()) {
+    Stats->Write();
+  }
 
   fextl::string Filename {};
 
@@ -797,9 +809,29 @@ SyscallHandler::SyscallHandler(FEXCore::Context::Context* _CTX, FEX::HLE::Signal
   SignalDelegation->RegisterHostSignalHandler(SIGSEGV, HandleSegfault, true);
 
   ExtendedMetaData = FEX::VolatileMetadata::ParseExtendedVolatileMetadata(FEXCore::Config::Get_EXTENDEDVOLATILEMETADATA()());
+
+  FEX_CONFIG_OPT(SyscallStatsEnabled, SYSCALLSTATS);
+  if (SyscallStatsEnabled()) {
+    const auto& ApplicationName = SignalDelegation->GetApplicationName();
+    SyscallStatistics = fextl::make_unique<SyscallStats>(
+      Is64BitMode(), Definitions.size(),
+      fextl::fmt::format("{}/{}", FEXServerClient::GetTempFolder(), ApplicationName.empty() ? "FEX" : ApplicationName));
+  }
+
+  FEX_CONFIG_OPT(ProfileStats, PROFILESTATS);
+  InlinePassthroughSyscalls = !SyscallStatistics && !ProfileStats();
 }
 
 SyscallHandler::~SyscallHandler() {
+  if (CodeCacheFinalizationThread) {
+    {
+      std::lock_guard lk(CodeCacheFinalizationMutex);
+      StopCodeCacheFinalization = true;
+    }
+    CodeCacheFinalizationCV.notify_one();
+    CodeCacheFinalizationThread->join(nullptr);
+  }
+
   FEXCore::Allocator::munmap(reinterpret_cast<void*>(DataSpace), DataSpaceMappedSize);
 }
 
@@ -811,6 +843,7 @@ uint32_t SyscallHandler::CalculateGuestKernelVersion() {
 uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXCore::HLE::SyscallArguments* Args) {
   // Grab the return address which will be inside the JIT.
   const uint64_t JITPC = reinterpret_cast<uint64_t>(__builtin_extract_return_addr(__builtin_return_address(0)));
+  FEXCORE_PROFILE_HISTOGRAM(Frame->Thread, SyscallTimeHistogram);
 
   const auto SeccompResult = SeccompEmulator.ExecuteFilter(Frame, JITPC, Args);
 
@@ -822,6 +855,11 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXC
     return -ENOSYS;
   }
 
+  std::optional<SyscallStats::Scope> StatsScope;
+  if (SyscallStatistics) [[unlikely]] {
+    StatsScope.emplace(*SyscallStatistics, Args->Argument[0]);
+  }
+
   auto& Def = Definitions[Args->Argument[0]];
   uint64_t Result {};
   switch (Def.NumArgs) {
@@ -850,6 +888,33 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXC
   return Result;
 }
 
+FEXCore::HLE::SyscallABI SyscallHandler::GetSyscallABI(uint64_t Syscall) {
+  FEXCore::HLE::SyscallABI ABI {
+    .NumArgs = 0,
+    .HasReturn = true,
+    .HostSyscallNumber = -1,
+  };
+
+  if (Syscall >= Definitions.size()) {
+    return ABI;
+  }
+
+  const auto& Def = Definitions[Syscall];
+  if (Def.NumArgs != 255) {
+    ABI.NumArgs = Def.NumArgs;
+  }
+
+#if defined(ARCHITECTURE_arm64) && !defined(DEBUG_STRACE)
+  // Passthrough syscalls can be done inline by the JIT, unless syscall statistics or the syscall time histogram need to see every syscall.
+  // Seccomp filters are checked at runtime through CpuStateFrame::ForceSyscallHandler.
+  if (InlinePassthroughSyscalls) {
+    ABI.HostSyscallNumber = Def.HostSyscallNumber;
+  }
+#endif
+
+  return ABI;
+}
+
 #ifdef DEBUG_STRACE
 void SyscallHandler::Strace(FEXCore::HLE::SyscallArguments* Args, uint64_t Ret) {
   auto& Def = Definitions[Args->Argument[0]];
@@ -884,7 +949,7 @@ void SyscallHandler::LockBeforeFork(FEXCore::Core::InternalThreadState* Thread)
   while (true) {
     TM.LockBeforeFork();
     Thread->CTX->LockBeforeFork(Thread);
-    if (std::try_lock(CodeCachePatchingMutex, VMATracking.Mutex) == -1) {
+    if (std::try_lock(CodeCacheFinalizationMutex, CodeCachePatchingMutex, VMATracking.Mutex, IoUrings.Mutex) == -1) {
       break;
     }
 
@@ -901,11 +966,26 @@ void SyscallHandler::UnlockAfterFork(FEXCore::Core::InternalThreadState* LiveThr
     // Code maps are closed upon fork in the child
     FM.SetProtectedCodeMapFD(-1);
 
+    if (auto Profiler = SignalDelegation->GetProfiler()) {
+      Profiler->ResetAfterFork(FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(LiveThread));
+    }
+    if (SyscallStatistics) {
+      SyscallStatistics->ResetAfterFork();
+    }
+
+    IoUrings.Mutex.StealAndDropActiveLocks();
     VMATracking.Mutex.StealAndDropActiveLocks();
     CodeCachePatchingMutex.StealAndDropActiveLocks();
+
+    // The finalization thread doesn't exist in the child. Pages it didn't get to are finalized on first use instead.
+    CodeCacheFinalizationMutex.StealAndDropActiveLocks();
+    CodeCacheFinalizationQueue.clear();
+    (void)CodeCacheFinalizationThread.release();
   } else {
+    IoUrings.Mutex.unlock();
     VMATracking.Mutex.unlock();
     CodeCachePatchingMutex.unlock();
+    CodeCacheFinalizationMutex.unlock();
   }
 
   CTX->UnlockAfterFork(LiveThread, Child);
@@ -11,9 +11,11 @@ $end_info$
 #include "Common/Linux/LinuxVersion.h"
 #include "Common/VolatileMetadata.h"
 #include "LinuxSyscalls/FileManagement.h"
+#include "LinuxSyscalls/IoUring.h"
 #include "LinuxSyscalls/LinuxAllocator.h"
 #include "LinuxSyscalls/ThreadManager.h"
 #include "LinuxSyscalls/Seccomp/SeccompEmulator.h"
+#include "LinuxSyscalls/SyscallStats.h"
 #include "LinuxSyscalls/SyscallsVMATracking.h"
 #include "ArchHelpers/MContext.h"
 
@@ -24,6 +26,8 @@ $end_info$
 #include <FEXCore/IR/IR.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/SignalScopeGuards.h>
+#include <FEXCore/Utils/Threads.h>
+#include <FEXCore/fextl/deque.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/functional.h>
 #include <FEXCore/fextl/map.h>
@@ -31,6 +35,9 @@ $end_info$
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <shared_mutex>
 
@@ -126,6 +133,7 @@ public:
 
   // In the case that the syscall doesn't hit the optimized path then we still need to go here
   uint64_t HandleSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXCore::HLE::SyscallArguments* Args) final override;
+  FEXCore::HLE::SyscallABI GetSyscallABI(uint64_t Syscall) override;
 
   void DefaultProgramBreak(uint64_t Base, uint64_t Size);
   void DeserializeSeccompFD(FEX::HLE::ThreadStateObject* Thread, int FD) {
@@ -155,6 +163,8 @@ public:
       SyscallPtrArg6 Ptr6;
     };
     uint8_t NumArgs;
+    // Host syscall for syscalls that are passed through unmodified, or -1
+    int32_t HostSyscallNumber {-1};
 #ifdef DEBUG_STRACE
     fextl::string StraceFmt;
 #endif
@@ -168,14 +178,14 @@ public:
 #ifdef DEBUG_STRACE
                                   const fextl::string& TraceFormatString,
 #endif
-                                  void* SyscallHandler, int ArgumentCount) {
+                                  void* SyscallHandler, int ArgumentCount, int32_t HostSyscallNumber) {
   }
 
   virtual void RegisterSyscall_64(int SyscallNumber,
 #ifdef DEBUG_STRACE
                                   const fextl::string& TraceFormatString,
 #endif
-                                  void* SyscallHandler, int ArgumentCount) {
+                                  void* SyscallHandler, int ArgumentCount, int32_t HostSyscallNumber) {
   }
 
   uint64_t HandleBRK(FEXCore::Core::CpuStateFrame* Frame, void* Addr);
@@ -191,6 +201,11 @@ public:
     return SignalDelegation;
   }
 
+  // Returns nullptr unless SyscallStats is enabled
+  SyscallStats* GetSyscallStats() const {
+    return SyscallStatistics.get();
+  }
+
   FEX::HLE::ThunkHandler* GetThunkHandler() {
     return ThunkHandler;
   }
@@ -202,6 +217,8 @@ public:
   FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
   FEX_CONFIG_OPT(NeedsSeccomp, NEEDSSECCOMP);
   FEX_CONFIG_OPT(EnableCodeCaching, ENABLECODECACHINGWIP);
+  FEX_CONFIG_OPT(EnableLazyCodeCaching, ENABLELAZYCODECACHINGWIP);
+  FEX_CONFIG_OPT(CodeCacheEagerFinalization, CODECACHEEAGERFINALIZATION);
 
   uint32_t GetHostKernelVersion() const {
     return HostKernelVersion;
@@ -291,8 +308,23 @@ public:
   void TriggerGuestLibWrapperCodeCacheLoad(FEXCore::Core::InternalThreadState&, uint64_t AnyAddr);
   int OpenCodeMapFile() override;
 
+  // FD provided by FEXServer to receive notifications about code caches compiled in the background
+  void SetCodeCacheUpdateFD(int FD) {
+    CodeCacheUpdateFD = FD;
+  }
+  // Loads code caches that became available after the corresponding file was mapped.
+  // This is polled from mmap/mprotect, but only checks for notifications once every CODE_CACHE_UPDATE_POLL_INTERVAL.
+  void LoadUpdatedCodeCaches(FEXCore::Core::InternalThreadState* Thread);
+
+  // Schedules all pages of a lazily loaded code cache for finalization on a background thread (see CodeCacheEagerFinalization)
+  void QueueCodeCacheFinalization(FEXCore::Core::InternalThreadState* Thread, FEXCore::MappedCodeCacheFile& Code);
+
   FEXCore::HLE::ExecutableRangeInfo QueryGuestExecutableRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Address) override;
 
+  // Finds the VMA containing the address. Repeated lookups within the same VMA don't take VMATracking.Mutex
+  // until the VMAs change, since block compilation queries the same VMA many times.
+  std::optional<VMATracking::CachedVMA> FindVMA(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestAddr);
+
   ///// FORK tracking /////
   void LockBeforeFork(FEXCore::Core::InternalThreadState* Thread);
   void UnlockAfterFork(FEXCore::Core::InternalThreadState* LiveThread, bool Child);
@@ -321,7 +353,7 @@ public:
 
   VMATracking::VMATracking VMATracking;
 
-  const uint64_t CodeCacheConfigId = 0; // TODO: Make unique to active configuration
+  FEX::HLE::IoUringTracking IoUrings;
 
   uint64_t read_ldt(FEXCore::Core::CpuStateFrame* Frame, void* ptr, unsigned long bytecount);
   uint64_t write_ldt(FEXCore::Core::CpuStateFrame* Frame, void* ptr, unsigned long bytecount, bool legacy);
@@ -368,6 +400,35 @@ private:
 
   fextl::unique_ptr<FEX::HLE::MemAllocator> Alloc32Handler {};
   std::atomic<uint64_t> AnonSharedId {1};
+
+  constexpr static auto CODE_CACHE_UPDATE_POLL_INTERVAL = std::chrono::milliseconds {100};
+  int CodeCacheUpdateFD {-1};
+  std::atomic<int64_t> NextCodeCacheUpdatePoll {};
+
+  // Eager code cache finalization
+  struct PendingCodeCacheFinalization {
+    FEXCore::MappedCodeCacheFile* Code;
+    uintptr_t CodeBufferBase; // Used to detect if Code was unmapped in the meantime
+    fextl::vector<uint32_t> PageOrder;
+    size_t NextPage {};
+    size_t NumRangesFinalized {};
+    std::chrono::steady_clock::time_point QueueTime;
+  };
+  // Upper bound for the number of pages finalized without releasing VMATracking.Mutex
+  constexpr static size_t CODE_CACHE_FINALIZATION_BATCH_SIZE = 16;
+  static void* CodeCacheFinalizationThreadFunc(void* Arg);
+  void CodeCacheFinalizationLoop();
+  bool FinalizeCodeCacheBatch(PendingCodeCacheFinalization&);
+
+  FEXCore::ForkableUniqueMutex CodeCacheFinalizationMutex;
+  std::condition_variable_any CodeCacheFinalizationCV;
+  fextl::deque<PendingCodeCacheFinalization> CodeCacheFinalizationQueue;
+  fextl::unique_ptr<FEXCore::Threads::Thread> CodeCacheFinalizationThread;
+  std::atomic<bool> StopCodeCacheFinalization {};
+
+  fextl::unique_ptr<SyscallStats> SyscallStatistics;
+  // Inline syscalls bypass HandleSyscall and its statistics hooks.
+  bool InlinePassthroughSyscalls {};
 };
 
 #define SYSCALL_ERRNO()              \
@@ -665,3 +726,13 @@ inline static uint64_t futimesat_compat(int dirfd, const char* pathname, const T
     FEX::HLE::x64::RegisterSyscall(Handler, FEX::HLE::x64::SYSCALL_x64_##name, #name, (lambda)); \
     FEX::HLE::x32::RegisterSyscall(Handler, FEX::HLE::x32::SYSCALL_x86_##name, #name, (lambda)); \
   } while (false)
+
+// Registers a syscall for both 32bit and 64bit that is passed through to the host syscall of the same name
+// The JIT can do these inline when the syscall number is known
+#define REGISTER_SYSCALL_PASSTHROUGH(name, argc)                                                                                   \
+  do {                                                                                                                             \
+    FEX::HLE::x64::RegisterSyscall(Handler, FEX::HLE::x64::SYSCALL_x64_##name, #name, SyscallPassthrough##argc<SYSCALL_DEF(name)>, \
+                                   SYSCALL_DEF(name));                                                                             \
+    FEX::HLE::x32::RegisterSyscall(Handler, FEX::HLE::x32::SYSCALL_x86_##name, #name, SyscallPassthrough##argc<SYSCALL_DEF(name)>, \
+                                   SYSCALL_DEF(name));                                                                             \
+  } while (false)
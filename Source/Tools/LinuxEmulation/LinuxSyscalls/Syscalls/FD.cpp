@@ -26,6 +26,10 @@ $end_info$
 #include <sys/eventfd.h>
 #include <sys/syscall.h>
 
+#ifndef CLOSE_RANGE_CLOEXEC
+#define CLOSE_RANGE_CLOEXEC (1U << 2)
+#endif
+
 namespace FEX::HLE {
 void RegisterFD(FEX::HLE::SyscallHandler* Handler) {
   REGISTER_SYSCALL_IMPL(poll, [](FEXCore::Core::CpuStateFrame* Frame, struct pollfd* fds, nfds_t nfds, int timeout) -> uint64_t {
@@ -44,6 +48,8 @@ void RegisterFD(FEX::HLE::SyscallHandler* Handler) {
   });
 
   REGISTER_SYSCALL_IMPL(close, [](FEXCore::Core::CpuStateFrame* Frame, int fd) -> uint64_t {
+    // Before closing, so a new ring can't reuse the FD in between
+    FEX::HLE::_SyscallHandler->IoUrings.CloseFD(Frame->Thread, fd);
     uint64_t Result = FEX::HLE::_SyscallHandler->FM.Close(fd);
     SYSCALL_ERRNO();
   });
@@ -71,6 +77,9 @@ void RegisterFD(FEX::HLE::SyscallHandler* Handler) {
   REGISTER_SYSCALL_IMPL(dup3, [](FEXCore::Core::CpuStateFrame* Frame, int oldfd, int newfd, int flags) -> uint64_t {
     flags = FEX::HLE::RemapFromX86Flags(flags);
     uint64_t Result = ::dup3(oldfd, newfd, flags);
+    if (Result != -1) {
+      FEX::HLE::_SyscallHandler->IoUrings.CloseFD(Frame->Thread, newfd);
+    }
     SYSCALL_ERRNO();
   });
 
@@ -130,6 +139,9 @@ void RegisterFD(FEX::HLE::SyscallHandler* Handler) {
     });
 
   REGISTER_SYSCALL_IMPL(close_range, [](FEXCore::Core::CpuStateFrame* Frame, unsigned int first, unsigned int last, unsigned int flags) -> uint64_t {
+    if (!(flags & CLOSE_RANGE_CLOEXEC)) {
+      FEX::HLE::_SyscallHandler->IoUrings.CloseFDs(Frame->Thread, first, last);
+    }
     uint64_t Result = FEX::HLE::_SyscallHandler->FM.CloseRange(first, last, flags);
     SYSCALL_ERRNO();
   });
@@ -210,191 +210,183 @@ uint64_t SyscallPassthrough7(FEXCore::Core::CpuStateFrame* Frame, uint64_t arg1,
 #endif
 
 static void RegisterCommon(FEX::HLE::SyscallHandler* Handler) {
-  REGISTER_SYSCALL_IMPL(read, SyscallPassthrough3<SYSCALL_DEF(read)>);
-  REGISTER_SYSCALL_IMPL(write, SyscallPassthrough3<SYSCALL_DEF(write)>);
-  REGISTER_SYSCALL_IMPL(lseek, SyscallPassthrough3<SYSCALL_DEF(lseek)>);
-  REGISTER_SYSCALL_IMPL(sched_yield, SyscallPassthrough0<SYSCALL_DEF(sched_yield)>);
-  REGISTER_SYSCALL_IMPL(msync, SyscallPassthrough3<SYSCALL_DEF(msync)>);
-  REGISTER_SYSCALL_IMPL(mincore, SyscallPassthrough3<SYSCALL_DEF(mincore)>);
-  REGISTER_SYSCALL_IMPL(shmget, SyscallPassthrough3<SYSCALL_DEF(shmget)>);
-  REGISTER_SYSCALL_IMPL(shmctl, SyscallPassthrough3<SYSCALL_DEF(shmctl)>);
-  REGISTER_SYSCALL_IMPL(getpid, SyscallPassthrough0<SYSCALL_DEF(getpid)>);
-  REGISTER_SYSCALL_IMPL(socket, SyscallPassthrough3<SYSCALL_DEF(socket)>);
-  REGISTER_SYSCALL_IMPL(connect, SyscallPassthrough3<SYSCALL_DEF(connect)>);
-  REGISTER_SYSCALL_IMPL(sendto, SyscallPassthrough6<SYSCALL_DEF(sendto)>);
-  REGISTER_SYSCALL_IMPL(recvfrom, SyscallPassthrough6<SYSCALL_DEF(recvfrom)>);
-  REGISTER_SYSCALL_IMPL(shutdown, SyscallPassthrough2<SYSCALL_DEF(shutdown)>);
-  REGISTER_SYSCALL_IMPL(bind, SyscallPassthrough3<SYSCALL_DEF(bind)>);
-  REGISTER_SYSCALL_IMPL(listen, SyscallPassthrough2<SYSCALL_DEF(listen)>);
-  REGISTER_SYSCALL_IMPL(getsockname, SyscallPassthrough3<SYSCALL_DEF(getsockname)>);
-  REGISTER_SYSCALL_IMPL(getpeername, SyscallPassthrough3<SYSCALL_DEF(getpeername)>);
-  REGISTER_SYSCALL_IMPL(socketpair, SyscallPassthrough4<SYSCALL_DEF(socketpair)>);
-  REGISTER_SYSCALL_IMPL(kill, SyscallPassthrough2<SYSCALL_DEF(kill)>);
-  REGISTER_SYSCALL_IMPL(semget, SyscallPassthrough3<SYSCALL_DEF(semget)>);
-  REGISTER_SYSCALL_IMPL(msgget, SyscallPassthrough2<SYSCALL_DEF(msgget)>);
-  REGISTER_SYSCALL_IMPL(msgsnd, SyscallPassthrough4<SYSCALL_DEF(msgsnd)>);
-  REGISTER_SYSCALL_IMPL(msgrcv, SyscallPassthrough5<SYSCALL_DEF(msgrcv)>);
-  REGISTER_SYSCALL_IMPL(msgctl, SyscallPassthrough3<SYSCALL_DEF(msgctl)>);
-  REGISTER_SYSCALL_IMPL(flock, SyscallPassthrough2<SYSCALL_DEF(flock)>);
-  REGISTER_SYSCALL_IMPL(fsync, SyscallPassthrough1<SYSCALL_DEF(fsync)>);
-  REGISTER_SYSCALL_IMPL(fdatasync, SyscallPassthrough1<SYSCALL_DEF(fdatasync)>);
-  REGISTER_SYSCALL_IMPL(truncate, SyscallPassthrough2<SYSCALL_DEF(truncate)>);
-  REGISTER_SYSCALL_IMPL(getcwd, SyscallPassthrough2<SYSCALL_DEF(getcwd)>);
-  REGISTER_SYSCALL_IMPL(chdir, SyscallPassthrough1<SYSCALL_DEF(chdir)>);
-  REGISTER_SYSCALL_IMPL(fchdir, SyscallPassthrough1<SYSCALL_DEF(fchdir)>);
-  REGISTER_SYSCALL_IMPL(fchmod, SyscallPassthrough2<SYSCALL_DEF(fchmod)>);
-  REGISTER_SYSCALL_IMPL(fchown, SyscallPassthrough3<SYSCALL_DEF(fchown)>);
-  REGISTER_SYSCALL_IMPL(umask, SyscallPassthrough1<SYSCALL_DEF(umask)>);
-  REGISTER_SYSCALL_IMPL(getuid, SyscallPassthrough0<SYSCALL_DEF(getuid)>);
-  REGISTER_SYSCALL_IMPL(syslog, SyscallPassthrough3<SYSCALL_DEF(syslog)>);
-  REGISTER_SYSCALL_IMPL(getgid, SyscallPassthrough0<SYSCALL_DEF(getgid)>);
-  REGISTER_SYSCALL_IMPL(setuid, SyscallPassthrough1<SYSCALL_DEF(setuid)>);
-  REGISTER_SYSCALL_IMPL(setgid, SyscallPassthrough1<SYSCALL_DEF(setgid)>);
-  REGISTER_SYSCALL_IMPL(geteuid, SyscallPassthrough0<SYSCALL_DEF(geteuid)>);
-  REGISTER_SYSCALL_IMPL(getegid, SyscallPassthrough0<SYSCALL_DEF(getegid)>);
-  REGISTER_SYSCALL_IMPL(setpgid, SyscallPassthrough2<SYSCALL_DEF(setpgid)>);
-  REGISTER_SYSCALL_IMPL(getppid, SyscallPassthrough0<SYSCALL_DEF(getppid)>);
-  REGISTER_SYSCALL_IMPL(setsid, SyscallPassthrough0<SYSCALL_DEF(setsid)>);
-  REGISTER_SYSCALL_IMPL(setreuid, SyscallPassthrough2<SYSCALL_DEF(setreuid)>);
-  REGISTER_SYSCALL_IMPL(setregid, SyscallPassthrough2<SYSCALL_DEF(setregid)>);
-  REGISTER_SYSCALL_IMPL(getgroups, SyscallPassthrough2<SYSCALL_DEF(getgroups)>);
-  REGISTER_SYSCALL_IMPL(setgroups, SyscallPassthrough2<SYSCALL_DEF(setgroups)>);
-  REGISTER_SYSCALL_IMPL(setresuid, SyscallPassthrough3<SYSCALL_DEF(setresuid)>);
-  REGISTER_SYSCALL_IMPL(getresuid, SyscallPassthrough3<SYSCALL_DEF(getresuid)>);
-  REGISTER_SYSCALL_IMPL(setresgid, SyscallPassthrough3<SYSCALL_DEF(setresgid)>);
-  REGISTER_SYSCALL_IMPL(getresgid, SyscallPassthrough3<SYSCALL_DEF(getresgid)>);
-  REGISTER_SYSCALL_IMPL(getpgid, SyscallPassthrough1<SYSCALL_DEF(getpgid)>);
-  REGISTER_SYSCALL_IMPL(setfsuid, SyscallPassthrough1<SYSCALL_DEF(setfsuid)>);
-  REGISTER_SYSCALL_IMPL(setfsgid, SyscallPassthrough1<SYSCALL_DEF(setfsgid)>);
-  REGISTER_SYSCALL_IMPL(getsid, SyscallPassthrough1<SYSCALL_DEF(getsid)>);
-  REGISTER_SYSCALL_IMPL(capget, SyscallPassthrough2<SYSCALL_DEF(capget)>);
-  REGISTER_SYSCALL_IMPL(capset, SyscallPassthrough2<SYSCALL_DEF(capset)>);
-  REGISTER_SYSCALL_IMPL(getpriority, SyscallPassthrough2<SYSCALL_DEF(getpriority)>);
-  REGISTER_SYSCALL_IMPL(setpriority, SyscallPassthrough3<SYSCALL_DEF(setpriority)>);
-  REGISTER_SYSCALL_IMPL(sched_setparam, SyscallPassthrough2<SYSCALL_DEF(sched_setparam)>);
-  REGISTER_SYSCALL_IMPL(sched_getparam, SyscallPassthrough2<SYSCALL_DEF(sched_getparam)>);
-  REGISTER_SYSCALL_IMPL(sched_setscheduler, SyscallPassthrough3<SYSCALL_DEF(sched_setscheduler)>);
-  REGISTER_SYSCALL_IMPL(sched_getscheduler, SyscallPassthrough1<SYSCALL_DEF(sched_getscheduler)>);
-  REGISTER_SYSCALL_IMPL(sched_get_priority_max, SyscallPassthrough1<SYSCALL_DEF(sched_get_priority_max)>);
-  REGISTER_SYSCALL_IMPL(sched_get_priority_min, SyscallPassthrough1<SYSCALL_DEF(sched_get_priority_min)>);
-  REGISTER_SYSCALL_IMPL(mlock, SyscallPassthrough2<SYSCALL_DEF(mlock)>);
-  REGISTER_SYSCALL_IMPL(munlock, SyscallPassthrough2<SYSCALL_DEF(munlock)>);
-  REGISTER_SYSCALL_IMPL(pivot_root, SyscallPassthrough2<SYSCALL_DEF(pivot_root)>);
-  REGISTER_SYSCALL_IMPL(chroot, SyscallPassthrough1<SYSCALL_DEF(chroot)>);
-  REGISTER_SYSCALL_IMPL(sync, SyscallPassthrough0<SYSCALL_DEF(sync)>);
-  REGISTER_SYSCALL_IMPL(acct, SyscallPassthrough1<SYSCALL_DEF(acct)>);
-  REGISTER_SYSCALL_IMPL(mount, SyscallPassthrough5<SYSCALL_DEF(mount)>);
-  REGISTER_SYSCALL_IMPL(umount2, SyscallPassthrough2<SYSCALL_DEF(umount2)>);
-  REGISTER_SYSCALL_IMPL(swapon, SyscallPassthrough2<SYSCALL_DEF(swapon)>);
-  REGISTER_SYSCALL_IMPL(swapoff, SyscallPassthrough1<SYSCALL_DEF(swapoff)>);
-  REGISTER_SYSCALL_IMPL(gettid, SyscallPassthrough0<SYSCALL_DEF(gettid)>);
-  REGISTER_SYSCALL_IMPL(fsetxattr, SyscallPassthrough5<SYSCALL_DEF(fsetxattr)>);
-  REGISTER_SYSCALL_IMPL(fgetxattr, SyscallPassthrough4<SYSCALL_DEF(fgetxattr)>);
-  REGISTER_SYSCALL_IMPL(flistxattr, SyscallPassthrough3<SYSCALL_DEF(flistxattr)>);
-  REGISTER_SYSCALL_IMPL(fremovexattr, SyscallPassthrough2<SYSCALL_DEF(fremovexattr)>);
-  REGISTER_SYSCALL_IMPL(tkill, SyscallPassthrough2<SYSCALL_DEF(tkill)>);
-  REGISTER_SYSCALL_IMPL(sched_setaffinity, SyscallPassthrough3<SYSCALL_DEF(sched_setaffinity)>);
-  REGISTER_SYSCALL_IMPL(sched_getaffinity, SyscallPassthrough3<SYSCALL_DEF(sched_getaffinity)>);
-  REGISTER_SYSCALL_IMPL(io_setup, SyscallPassthrough2<SYSCALL_DEF(io_setup)>);
-  REGISTER_SYSCALL_IMPL(io_destroy, SyscallPassthrough1<SYSCALL_DEF(io_destroy)>);
-  REGISTER_SYSCALL_IMPL(io_submit, SyscallPassthrough3<SYSCALL_DEF(io_submit)>);
-  REGISTER_SYSCALL_IMPL(io_cancel, SyscallPassthrough3<SYSCALL_DEF(io_cancel)>);
-  REGISTER_SYSCALL_IMPL(remap_file_pages, SyscallPassthrough5<SYSCALL_DEF(remap_file_pages)>);
-  REGISTER_SYSCALL_IMPL(timer_getoverrun, SyscallPassthrough1<SYSCALL_DEF(timer_getoverrun)>);
-  REGISTER_SYSCALL_IMPL(timer_delete, SyscallPassthrough1<SYSCALL_DEF(timer_delete)>);
-  REGISTER_SYSCALL_IMPL(tgkill, SyscallPassthrough3<SYSCALL_DEF(tgkill)>);
-  REGISTER_SYSCALL_IMPL(mbind, SyscallPassthrough6<SYSCALL_DEF(mbind)>);
-  REGISTER_SYSCALL_IMPL(set_mempolicy, SyscallPassthrough3<SYSCALL_DEF(set_mempolicy)>);
-  REGISTER_SYSCALL_IMPL(get_mempolicy, SyscallPassthrough5<SYSCALL_DEF(get_mempolicy)>);
-  REGISTER_SYSCALL_IMPL(mq_unlink, SyscallPassthrough1<SYSCALL_DEF(mq_unlink)>);
-  REGISTER_SYSCALL_IMPL(add_key, SyscallPassthrough5<SYSCALL_DEF(add_key)>);
-  REGISTER_SYSCALL_IMPL(request_key, SyscallPassthrough4<SYSCALL_DEF(request_key)>);
-  REGISTER_SYSCALL_IMPL(keyctl, SyscallPassthrough5<SYSCALL_DEF(keyctl)>);
-  REGISTER_SYSCALL_IMPL(ioprio_set, SyscallPassthrough2<SYSCALL_DEF(ioprio_set)>);
-  REGISTER_SYSCALL_IMPL(ioprio_get, SyscallPassthrough3<SYSCALL_DEF(ioprio_get)>);
-  REGISTER_SYSCALL_IMPL(inotify_add_watch, SyscallPassthrough3<SYSCALL_DEF(inotify_add_watch)>);
-  REGISTER_SYSCALL_IMPL(inotify_rm_watch, SyscallPassthrough2<SYSCALL_DEF(inotify_rm_watch)>);
-  REGISTER_SYSCALL_IMPL(migrate_pages, SyscallPassthrough4<SYSCALL_DEF(migrate_pages)>);
-  REGISTER_SYSCALL_IMPL(mkdirat, SyscallPassthrough3<SYSCALL_DEF(mkdirat)>);
-  REGISTER_SYSCALL_IMPL(mknodat, SyscallPassthrough4<SYSCALL_DEF(mknodat)>);
-  REGISTER_SYSCALL_IMPL(fchownat, SyscallPassthrough5<SYSCALL_DEF(fchownat)>);
-  REGISTER_SYSCALL_IMPL(unlinkat, SyscallPassthrough3<SYSCALL_DEF(unlinkat)>);
-  REGISTER_SYSCALL_IMPL(renameat, SyscallPassthrough4<SYSCALL_DEF(renameat)>);
-  REGISTER_SYSCALL_IMPL(linkat, SyscallPassthrough5<SYSCALL_DEF(linkat)>);
-  REGISTER_SYSCALL_IMPL(symlinkat, SyscallPassthrough3<SYSCALL_DEF(symlinkat)>);
-  REGISTER_SYSCALL_IMPL(fchmodat, SyscallPassthrough3<SYSCALL_DEF(fchmodat)>);
-  REGISTER_SYSCALL_IMPL(unshare, SyscallPassthrough1<SYSCALL_DEF(unshare)>);
-  REGISTER_SYSCALL_IMPL(splice, SyscallPassthrough6<SYSCALL_DEF(splice)>);
-  REGISTER_SYSCALL_IMPL(tee, SyscallPassthrough4<SYSCALL_DEF(tee)>);
-  REGISTER_SYSCALL_IMPL(move_pages, SyscallPassthrough6<SYSCALL_DEF(move_pages)>);
-  REGISTER_SYSCALL_IMPL(timerfd_create, SyscallPassthrough2<SYSCALL_DEF(timerfd_create)>);
-  REGISTER_SYSCALL_IMPL(accept4, SyscallPassthrough4<SYSCALL_DEF(accept4)>);
-  REGISTER_SYSCALL_IMPL(eventfd2, SyscallPassthrough2<SYSCALL_DEF(eventfd2)>);
-  REGISTER_SYSCALL_IMPL(epoll_create1, SyscallPassthrough1<SYSCALL_DEF(epoll_create1)>);
-  REGISTER_SYSCALL_IMPL(inotify_init1, SyscallPassthrough1<SYSCALL_DEF(inotify_init1)>);
-  REGISTER_SYSCALL_IMPL(fanotify_init, SyscallPassthrough2<SYSCALL_DEF(fanotify_init)>);
-  REGISTER_SYSCALL_IMPL(fanotify_mark, SyscallPassthrough5<SYSCALL_DEF(fanotify_mark)>);
-  REGISTER_SYSCALL_IMPL(prlimit_64, SyscallPassthrough4<SYSCALL_DEF(prlimit_64)>);
-  REGISTER_SYSCALL_IMPL(name_to_handle_at, SyscallPassthrough5<SYSCALL_DEF(name_to_handle_at)>);
-  REGISTER_SYSCALL_IMPL(open_by_handle_at, SyscallPassthrough3<SYSCALL_DEF(open_by_handle_at)>);
-  REGISTER_SYSCALL_IMPL(syncfs, SyscallPassthrough1<SYSCALL_DEF(syncfs)>);
-  REGISTER_SYSCALL_IMPL(setns, SyscallPassthrough2<SYSCALL_DEF(setns)>);
-  REGISTER_SYSCALL_IMPL(getcpu, SyscallPassthrough3<SYSCALL_DEF(getcpu)>);
-  REGISTER_SYSCALL_IMPL(kcmp, SyscallPassthrough5<SYSCALL_DEF(kcmp)>);
-  REGISTER_SYSCALL_IMPL(sched_setattr, SyscallPassthrough3<SYSCALL_DEF(sched_setattr)>);
-  REGISTER_SYSCALL_IMPL(sched_getattr, SyscallPassthrough4<SYSCALL_DEF(sched_getattr)>);
-  REGISTER_SYSCALL_IMPL(renameat2, SyscallPassthrough5<SYSCALL_DEF(renameat2)>);
-  REGISTER_SYSCALL_IMPL(getrandom, SyscallPassthrough3<SYSCALL_DEF(getrandom)>);
-  REGISTER_SYSCALL_IMPL(memfd_create, SyscallPassthrough2<SYSCALL_DEF(memfd_create)>);
-  REGISTER_SYSCALL_IMPL(membarrier, SyscallPassthrough2<SYSCALL_DEF(membarrier)>);
-  REGISTER_SYSCALL_IMPL(mlock2, SyscallPassthrough3<SYSCALL_DEF(mlock2)>);
-  REGISTER_SYSCALL_IMPL(copy_file_range, SyscallPassthrough6<SYSCALL_DEF(copy_file_range)>);
-  REGISTER_SYSCALL_IMPL(pkey_mprotect, SyscallPassthrough4<SYSCALL_DEF(pkey_mprotect)>);
-  REGISTER_SYSCALL_IMPL(pkey_alloc, SyscallPassthrough2<SYSCALL_DEF(pkey_alloc)>);
-  REGISTER_SYSCALL_IMPL(pkey_free, SyscallPassthrough1<SYSCALL_DEF(pkey_free)>);
-  // io_uring can't be emulated as it can pass `epoll_event` objects around.
-  // These are 12-byte packed structs on x86/x86-64, but on other architectures are 16-byte.
-  // This means the `data` member is at offset 4 on x86, but offset 8 on other architectures, corrupting the data.
-  // The queue data is entirely user-controlled, so we can't rewrite data in any sane fashion.
-  // This is visible with `node.js` as a hang.
-  REGISTER_SYSCALL_IMPL(io_uring_setup, UnimplementedSyscallSafe);
-  REGISTER_SYSCALL_IMPL(io_uring_enter, UnimplementedSyscallSafe);
-  REGISTER_SYSCALL_IMPL(io_uring_register, UnimplementedSyscallSafe);
-  REGISTER_SYSCALL_IMPL(open_tree, SyscallPassthrough3<SYSCALL_DEF(open_tree)>);
-  REGISTER_SYSCALL_IMPL(move_mount, SyscallPassthrough5<SYSCALL_DEF(move_mount)>);
-  REGISTER_SYSCALL_IMPL(fsopen, SyscallPassthrough3<SYSCALL_DEF(fsopen)>);
-  REGISTER_SYSCALL_IMPL(fsconfig, SyscallPassthrough5<SYSCALL_DEF(fsconfig)>);
-  REGISTER_SYSCALL_IMPL(fsmount, SyscallPassthrough3<SYSCALL_DEF(fsmount)>);
-  REGISTER_SYSCALL_IMPL(fspick, SyscallPassthrough3<SYSCALL_DEF(fspick)>);
-  REGISTER_SYSCALL_IMPL(pidfd_open, SyscallPassthrough2<SYSCALL_DEF(pidfd_open)>);
-  REGISTER_SYSCALL_IMPL(pidfd_getfd, SyscallPassthrough3<SYSCALL_DEF(pidfd_getfd)>);
-  REGISTER_SYSCALL_IMPL(mount_setattr, SyscallPassthrough5<SYSCALL_DEF(mount_setattr)>);
-  REGISTER_SYSCALL_IMPL(quotactl_fd, SyscallPassthrough4<SYSCALL_DEF(quotactl_fd)>);
-  REGISTER_SYSCALL_IMPL(landlock_create_ruleset, SyscallPassthrough3<SYSCALL_DEF(landlock_create_ruleset)>);
-  REGISTER_SYSCALL_IMPL(landlock_add_rule, SyscallPassthrough4<SYSCALL_DEF(landlock_add_rule)>);
-  REGISTER_SYSCALL_IMPL(landlock_restrict_self, SyscallPassthrough2<SYSCALL_DEF(landlock_restrict_self)>);
-  REGISTER_SYSCALL_IMPL(memfd_secret, SyscallPassthrough1<SYSCALL_DEF(memfd_secret)>);
-  REGISTER_SYSCALL_IMPL(process_mrelease, SyscallPassthrough2<SYSCALL_DEF(process_mrelease)>);
+  REGISTER_SYSCALL_PASSTHROUGH(read, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(write, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(lseek, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_yield, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(msync, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(mincore, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(shmget, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(shmctl, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(getpid, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(socket, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(connect, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(sendto, 6);
+  REGISTER_SYSCALL_PASSTHROUGH(recvfrom, 6);
+  REGISTER_SYSCALL_PASSTHROUGH(shutdown, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(bind, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(listen, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(getsockname, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(getpeername, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(socketpair, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(kill, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(semget, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(msgget, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(msgsnd, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(msgrcv, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(msgctl, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(flock, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(fsync, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(fdatasync, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(truncate, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(getcwd, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(chdir, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(fchdir, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(fchmod, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(fchown, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(umask, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(getuid, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(syslog, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(getgid, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(setuid, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(setgid, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(geteuid, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(getegid, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(setpgid, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(getppid, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(setsid, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(setreuid, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(setregid, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(getgroups, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(setgroups, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(setresuid, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(getresuid, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(setresgid, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(getresgid, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(getpgid, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(setfsuid, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(setfsgid, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(getsid, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(capget, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(capset, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(getpriority, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(setpriority, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_setparam, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_getparam, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_setscheduler, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_getscheduler, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_get_priority_max, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_get_priority_min, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(mlock, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(munlock, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(pivot_root, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(chroot, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(sync, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(acct, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(mount, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(umount2, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(swapon, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(swapoff, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(gettid, 0);
+  REGISTER_SYSCALL_PASSTHROUGH(fsetxattr, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(fgetxattr, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(flistxattr, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(fremovexattr, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(tkill, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_setaffinity, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_getaffinity, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(io_setup, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(io_destroy, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(io_submit, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(io_cancel, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(remap_file_pages, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(timer_getoverrun, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(timer_delete, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(tgkill, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(mbind, 6);
+  REGISTER_SYSCALL_PASSTHROUGH(set_mempolicy, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(get_mempolicy, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(mq_unlink, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(add_key, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(request_key, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(keyctl, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(ioprio_set, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(ioprio_get, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(inotify_add_watch, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(inotify_rm_watch, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(migrate_pages, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(mkdirat, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(mknodat, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(fchownat, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(unlinkat, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(renameat, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(linkat, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(symlinkat, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(fchmodat, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(unshare, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(splice, 6);
+  REGISTER_SYSCALL_PASSTHROUGH(tee, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(move_pages, 6);
+  REGISTER_SYSCALL_PASSTHROUGH(timerfd_create, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(accept4, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(eventfd2, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(epoll_create1, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(inotify_init1, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(fanotify_init, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(fanotify_mark, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(prlimit_64, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(name_to_handle_at, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(open_by_handle_at, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(syncfs, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(setns, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(getcpu, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(kcmp, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_setattr, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(sched_getattr, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(renameat2, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(getrandom, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(memfd_create, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(membarrier, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(mlock2, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(copy_file_range, 6);
+  REGISTER_SYSCALL_PASSTHROUGH(pkey_mprotect, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(pkey_alloc, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(pkey_free, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(open_tree, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(move_mount, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(fsopen, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(fsconfig, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(fsmount, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(fspick, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(pidfd_open, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(pidfd_getfd, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(mount_setattr, 5);
+  REGISTER_SYSCALL_PASSTHROUGH(quotactl_fd, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(landlock_create_ruleset, 3);
+  REGISTER_SYSCALL_PASSTHROUGH(landlock_add_rule, 4);
+  REGISTER_SYSCALL_PASSTHROUGH(landlock_restrict_self, 2);
+  REGISTER_SYSCALL_PASSTHROUGH(memfd_secret, 1);
+  REGISTER_SYSCALL_PASSTHROUGH(process_mrelease, 2);
   if (Handler->IsHostKernelVersionAtLeast(5, 16, 0)) {
-    REGISTER_SYSCALL_IMPL(futex_waitv, SyscallPassthrough5<SYSCALL_DEF(futex_waitv)>);
+    REGISTER_SYSCALL_PASSTHROUGH(futex_waitv, 5);
   } else {
     REGISTER_SYSCALL_IMPL(futex_waitv, UnimplementedSyscallSafe);
   }
   if (Handler->IsHostKernelVersionAtLeast(5, 17, 0)) {
-    REGISTER_SYSCALL_IMPL(set_mempolicy_home_node, SyscallPassthrough4<SYSCALL_DEF(set_mempolicy_home_node)>);
+    REGISTER_SYSCALL_PASSTHROUGH(set_mempolicy_home_node, 4);
   } else {
     REGISTER_SYSCALL_IMPL(set_mempolicy_home_node, UnimplementedSyscallSafe);
   }
 
   if (Handler->IsHostKernelVersionAtLeast(6, 8, 0)) {
-    REGISTER_SYSCALL_IMPL(futex_wake, SyscallPassthrough4<SYSCALL_DEF(futex_wake)>);
-    REGISTER_SYSCALL_IMPL(futex_wait, SyscallPassthrough6<SYSCALL_DEF(futex_wait)>);
-    REGISTER_SYSCALL_IMPL(futex_requeue, SyscallPassthrough4<SYSCALL_DEF(futex_requeue)>);
-    REGISTER_SYSCALL_IMPL(statmount, SyscallPassthrough4<SYSCALL_DEF(statmount)>);
-    REGISTER_SYSCALL_IMPL(listmount, SyscallPassthrough4<SYSCALL_DEF(listmount)>);
-    REGISTER_SYSCALL_IMPL(lsm_get_self_attr, SyscallPassthrough4<SYSCALL_DEF(lsm_get_self_attr)>);
-    REGISTER_SYSCALL_IMPL(lsm_set_self_attr, SyscallPassthrough4<SYSCALL_DEF(lsm_set_self_attr)>);
-    REGISTER_SYSCALL_IMPL(lsm_list_modules, SyscallPassthrough3<SYSCALL_DEF(lsm_list_modules)>);
+    REGISTER_SYSCALL_PASSTHROUGH(futex_wake, 4);
+    REGISTER_SYSCALL_PASSTHROUGH(futex_wait, 6);
+    REGISTER_SYSCALL_PASSTHROUGH(futex_requeue, 4);
+    REGISTER_SYSCALL_PASSTHROUGH(statmount, 4);
+    REGISTER_SYSCALL_PASSTHROUGH(listmount, 4);
+    REGISTER_SYSCALL_PASSTHROUGH(lsm_get_self_attr, 4);
+    REGISTER_SYSCALL_PASSTHROUGH(lsm_set_self_attr, 4);
+    REGISTER_SYSCALL_PASSTHROUGH(lsm_list_modules, 3);
   } else {
     REGISTER_SYSCALL_IMPL(futex_wake, UnimplementedSyscallSafe);
     REGISTER_SYSCALL_IMPL(futex_wait, UnimplementedSyscallSafe);
@@ -406,7 +398,7 @@ static void RegisterCommon(FEX::HLE::SyscallHandler* Handler) {
     REGISTER_SYSCALL_IMPL(lsm_list_modules, UnimplementedSyscallSafe);
   }
   if (Handler->IsHostKernelVersionAtLeast(6, 10, 0)) {
-    REGISTER_SYSCALL_IMPL(mseal, SyscallPassthrough3<SYSCALL_DEF(mseal)>);
+    REGISTER_SYSCALL_PASSTHROUGH(mseal, 3);
   } else {
     REGISTER_SYSCALL_IMPL(mseal, UnimplementedSyscallSafe);
   }
@@ -415,84 +407,84 @@ static void RegisterCommon(FEX::HLE::SyscallHandler* Handler) {
 namespace x64 {
   void RegisterPassthrough(FEX::HLE::SyscallHandler* Handler) {
     RegisterCommon(Handler);
-    REGISTER_SYSCALL_IMPL_X64(ftruncate, SyscallPassthrough2<SYSCALL_DEF(ftruncate)>);
-    REGISTER_SYSCALL_IMPL_X64(ioctl, SyscallPassthrough3<SYSCALL_DEF(ioctl)>);
-    REGISTER_SYSCALL_IMPL_X64(pread_64, SyscallPassthrough4<SYSCALL_DEF(pread_64)>);
-    REGISTER_SYSCALL_IMPL_X64(pwrite_64, SyscallPassthrough4<SYSCALL_DEF(pwrite_64)>);
-    REGISTER_SYSCALL_IMPL_X64(readv, SyscallPassthrough3<SYSCALL_DEF(readv)>);
-    REGISTER_SYSCALL_IMPL_X64(writev, SyscallPassthrough3<SYSCALL_DEF(writev)>);
-    REGISTER_SYSCALL_IMPL_X64(dup, SyscallPassthrough1<SYSCALL_DEF(dup)>);
-    REGISTER_SYSCALL_IMPL_X64(nanosleep, SyscallPassthrough2<SYSCALL_DEF(nanosleep)>);
-    REGISTER_SYSCALL_IMPL_X64(getitimer, SyscallPassthrough2<SYSCALL_DEF(getitimer)>);
-    REGISTER_SYSCALL_IMPL_X64(setitimer, SyscallPassthrough3<SYSCALL_DEF(setitimer)>);
-    REGISTER_SYSCALL_IMPL_X64(sendfile, SyscallPassthrough4<SYSCALL_DEF(sendfile)>);
-    REGISTER_SYSCALL_IMPL_X64(accept, SyscallPassthrough3<SYSCALL_DEF(accept)>);
-    REGISTER_SYSCALL_IMPL_X64(sendmsg, SyscallPassthrough3<SYSCALL_DEF(sendmsg)>);
-    REGISTER_SYSCALL_IMPL_X64(recvmsg, SyscallPassthrough3<SYSCALL_DEF(recvmsg)>);
-    REGISTER_SYSCALL_IMPL_X64(setsockopt, SyscallPassthrough5<SYSCALL_DEF(setsockopt)>);
-    REGISTER_SYSCALL_IMPL_X64(getsockopt, SyscallPassthrough5<SYSCALL_DEF(getsockopt)>);
-    REGISTER_SYSCALL_IMPL_X64(wait4, SyscallPassthrough4<SYSCALL_DEF(wait4)>);
-    REGISTER_SYSCALL_IMPL_X64(semop, SyscallPassthrough3<SYSCALL_DEF(semop)>);
-    REGISTER_SYSCALL_IMPL_X64(getrlimit, SyscallPassthrough2<SYSCALL_DEF(getrlimit)>);
-    REGISTER_SYSCALL_IMPL_X64(getrusage, SyscallPassthrough2<SYSCALL_DEF(getrusage)>);
-    REGISTER_SYSCALL_IMPL_X64(sysinfo, SyscallPassthrough1<SYSCALL_DEF(sysinfo)>);
-    REGISTER_SYSCALL_IMPL_X64(times, SyscallPassthrough1<SYSCALL_DEF(times)>);
-    REGISTER_SYSCALL_IMPL_X64(rt_sigqueueinfo, SyscallPassthrough3<SYSCALL_DEF(rt_sigqueueinfo)>);
-    REGISTER_SYSCALL_IMPL_X64(fstatfs, SyscallPassthrough2<SYSCALL_DEF(fstatfs)>);
-    REGISTER_SYSCALL_IMPL_X64(sched_rr_get_interval, SyscallPassthrough2<SYSCALL_DEF(sched_rr_get_interval)>);
-    REGISTER_SYSCALL_IMPL_X64(mlockall, SyscallPassthrough1<SYSCALL_DEF(mlockall)>);
-    REGISTER_SYSCALL_IMPL_X64(munlockall, SyscallPassthrough0<SYSCALL_DEF(munlockall)>);
-    REGISTER_SYSCALL_IMPL_X64(adjtimex, SyscallPassthrough1<SYSCALL_DEF(adjtimex)>);
-    REGISTER_SYSCALL_IMPL_X64(setrlimit, SyscallPassthrough2<SYSCALL_DEF(setrlimit)>);
-    REGISTER_SYSCALL_IMPL_X64(settimeofday, SyscallPassthrough2<SYSCALL_DEF(settimeofday)>);
-    REGISTER_SYSCALL_IMPL_X64(readahead, SyscallPassthrough3<SYSCALL_DEF(readahead)>);
-    REGISTER_SYSCALL_IMPL_X64(futex, SyscallPassthrough6<SYSCALL_DEF(futex)>);
-    REGISTER_SYSCALL_IMPL_X64(io_getevents, SyscallPassthrough5<SYSCALL_DEF(io_getevents)>);
-    REGISTER_SYSCALL_IMPL_X64(semtimedop, SyscallPassthrough4<SYSCALL_DEF(semtimedop)>);
-    REGISTER_SYSCALL_IMPL_X64(timer_create, SyscallPassthrough3<SYSCALL_DEF(timer_create)>);
-    REGISTER_SYSCALL_IMPL_X64(timer_settime, SyscallPassthrough4<SYSCALL_DEF(timer_settime)>);
-    REGISTER_SYSCALL_IMPL_X64(timer_gettime, SyscallPassthrough2<SYSCALL_DEF(timer_gettime)>);
-    REGISTER_SYSCALL_IMPL_X64(clock_settime, SyscallPassthrough2<SYSCALL_DEF(clock_settime)>);
-    REGISTER_SYSCALL_IMPL_X64(clock_gettime, SyscallPassthrough2<SYSCALL_DEF(clock_gettime)>);
-    REGISTER_SYSCALL_IMPL_X64(clock_getres, SyscallPassthrough2<SYSCALL_DEF(clock_getres)>);
-    REGISTER_SYSCALL_IMPL_X64(clock_nanosleep, SyscallPassthrough4<SYSCALL_DEF(clock_nanosleep)>);
-    REGISTER_SYSCALL_IMPL_X64(mq_open, SyscallPassthrough4<SYSCALL_DEF(mq_open)>);
-    REGISTER_SYSCALL_IMPL_X64(mq_timedsend, SyscallPassthrough5<SYSCALL_DEF(mq_timedsend)>);
-    REGISTER_SYSCALL_IMPL_X64(mq_timedreceive, SyscallPassthrough5<SYSCALL_DEF(mq_timedreceive)>);
-    REGISTER_SYSCALL_IMPL_X64(mq_notify, SyscallPassthrough2<SYSCALL_DEF(mq_notify)>);
-    REGISTER_SYSCALL_IMPL_X64(mq_getsetattr, SyscallPassthrough3<SYSCALL_DEF(mq_getsetattr)>);
-    REGISTER_SYSCALL_IMPL_X64(waitid, SyscallPassthrough5<SYSCALL_DEF(waitid)>);
-    REGISTER_SYSCALL_IMPL_X64(pselect6, SyscallPassthrough6<SYSCALL_DEF(pselect6)>);
-    REGISTER_SYSCALL_IMPL_X64(ppoll, SyscallPassthrough5<SYSCALL_DEF(ppoll)>);
-    REGISTER_SYSCALL_IMPL_X64(set_robust_list, SyscallPassthrough2<SYSCALL_DEF(set_robust_list)>);
-    REGISTER_SYSCALL_IMPL_X64(get_robust_list, SyscallPassthrough3<SYSCALL_DEF(get_robust_list)>);
-    REGISTER_SYSCALL_IMPL_X64(sync_file_range, SyscallPassthrough4<SYSCALL_DEF(sync_file_range)>);
-    REGISTER_SYSCALL_IMPL_X64(vmsplice, SyscallPassthrough4<SYSCALL_DEF(vmsplice)>);
-    REGISTER_SYSCALL_IMPL_X64(utimensat, SyscallPassthrough4<SYSCALL_DEF(utimensat)>);
-    REGISTER_SYSCALL_IMPL_X64(fallocate, SyscallPassthrough4<SYSCALL_DEF(fallocate)>);
-    REGISTER_SYSCALL_IMPL_X64(timerfd_settime, SyscallPassthrough4<SYSCALL_DEF(timerfd_settime)>);
-    REGISTER_SYSCALL_IMPL_X64(timerfd_gettime, SyscallPassthrough2<SYSCALL_DEF(timerfd_gettime)>);
-    REGISTER_SYSCALL_IMPL_X64(preadv, SyscallPassthrough5<SYSCALL_DEF(preadv)>);
-    REGISTER_SYSCALL_IMPL_X64(pwritev, SyscallPassthrough5<SYSCALL_DEF(pwritev)>);
-    REGISTER_SYSCALL_IMPL_X64(rt_tgsigqueueinfo, SyscallPassthrough4<SYSCALL_DEF(rt_tgsigqueueinfo)>);
-    REGISTER_SYSCALL_IMPL_X64(recvmmsg, SyscallPassthrough5<SYSCALL_DEF(recvmmsg)>);
-    REGISTER_SYSCALL_IMPL_X64(clock_adjtime, SyscallPassthrough2<SYSCALL_DEF(clock_adjtime)>);
-    REGISTER_SYSCALL_IMPL_X64(sendmmsg, SyscallPassthrough4<SYSCALL_DEF(sendmmsg)>);
-    REGISTER_SYSCALL_IMPL_X64(process_vm_readv, SyscallPassthrough6<SYSCALL_DEF(process_vm_readv)>);
-    REGISTER_SYSCALL_IMPL_X64(process_vm_writev, SyscallPassthrough6<SYSCALL_DEF(process_vm_writev)>);
-    REGISTER_SYSCALL_IMPL_X64(preadv2, SyscallPassthrough6<SYSCALL_DEF(preadv2)>);
-    REGISTER_SYSCALL_IMPL_X64(pwritev2, SyscallPassthrough6<SYSCALL_DEF(pwritev2)>);
-    REGISTER_SYSCALL_IMPL_X64(io_pgetevents, SyscallPassthrough6<SYSCALL_DEF(io_pgetevents)>);
-    REGISTER_SYSCALL_IMPL_X64(pidfd_send_signal, SyscallPassthrough4<SYSCALL_DEF(pidfd_send_signal)>);
-    REGISTER_SYSCALL_IMPL_X64(process_madvise, SyscallPassthrough5<SYSCALL_DEF(process_madvise)>);
-    REGISTER_SYSCALL_IMPL_X64(fadvise64, SyscallPassthrough4<SYSCALL_DEF(fadvise64)>);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(ftruncate, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(ioctl, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(pread_64, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(pwrite_64, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(readv, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(writev, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(dup, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(nanosleep, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(getitimer, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(setitimer, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(sendfile, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(accept, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(sendmsg, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(recvmsg, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(setsockopt, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(getsockopt, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(wait4, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(semop, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(getrlimit, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(getrusage, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(sysinfo, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(times, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(rt_sigqueueinfo, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(fstatfs, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(sched_rr_get_interval, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(mlockall, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(munlockall, 0);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(adjtimex, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(setrlimit, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(settimeofday, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(readahead, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(futex, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(io_getevents, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(semtimedop, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(timer_create, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(timer_settime, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(timer_gettime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(clock_settime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(clock_gettime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(clock_getres, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(clock_nanosleep, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(mq_open, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(mq_timedsend, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(mq_timedreceive, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(mq_notify, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(mq_getsetattr, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(waitid, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(pselect6, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(ppoll, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(set_robust_list, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(get_robust_list, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(sync_file_range, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(vmsplice, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(utimensat, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(fallocate, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(timerfd_settime, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(timerfd_gettime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(preadv, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(pwritev, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(rt_tgsigqueueinfo, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(recvmmsg, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(clock_adjtime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(sendmmsg, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(process_vm_readv, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(process_vm_writev, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(preadv2, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(pwritev2, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(io_pgetevents, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(pidfd_send_signal, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(process_madvise, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X64(fadvise64, 4);
     if (Handler->IsHostKernelVersionAtLeast(6, 5, 0)) {
-      REGISTER_SYSCALL_IMPL_X64(cachestat, SyscallPassthrough4<SYSCALL_DEF(cachestat)>);
+      REGISTER_SYSCALL_PASSTHROUGH_X64(cachestat, 4);
     } else {
       REGISTER_SYSCALL_IMPL_X64(cachestat, UnimplementedSyscallSafe);
     }
     if (Handler->IsHostKernelVersionAtLeast(6, 6, 0)) {
-      REGISTER_SYSCALL_IMPL_X64(fchmodat2, SyscallPassthrough4<SYSCALL_DEF(fchmodat2)>);
+      REGISTER_SYSCALL_PASSTHROUGH_X64(fchmodat2, 4);
     } else {
       REGISTER_SYSCALL_IMPL_X64(fchmodat2, UnimplementedSyscallSafe);
     }
@@ -502,41 +494,41 @@ namespace x64 {
 namespace x32 {
   void RegisterPassthrough(FEX::HLE::SyscallHandler* Handler) {
     RegisterCommon(Handler);
-    REGISTER_SYSCALL_IMPL_X32(getuid32, SyscallPassthrough0<SYSCALL_DEF(getuid)>);
-    REGISTER_SYSCALL_IMPL_X32(getgid32, SyscallPassthrough0<SYSCALL_DEF(getgid)>);
-    REGISTER_SYSCALL_IMPL_X32(geteuid32, SyscallPassthrough0<SYSCALL_DEF(geteuid)>);
-    REGISTER_SYSCALL_IMPL_X32(getegid32, SyscallPassthrough0<SYSCALL_DEF(getegid)>);
-    REGISTER_SYSCALL_IMPL_X32(setreuid32, SyscallPassthrough2<SYSCALL_DEF(setreuid)>);
-    REGISTER_SYSCALL_IMPL_X32(setregid32, SyscallPassthrough2<SYSCALL_DEF(setregid)>);
-    REGISTER_SYSCALL_IMPL_X32(getgroups32, SyscallPassthrough2<SYSCALL_DEF(getgroups)>);
-    REGISTER_SYSCALL_IMPL_X32(setgroups32, SyscallPassthrough2<SYSCALL_DEF(setgroups)>);
-    REGISTER_SYSCALL_IMPL_X32(fchown32, SyscallPassthrough3<SYSCALL_DEF(fchown)>);
-    REGISTER_SYSCALL_IMPL_X32(setresuid32, SyscallPassthrough3<SYSCALL_DEF(setresuid)>);
-    REGISTER_SYSCALL_IMPL_X32(getresuid32, SyscallPassthrough3<SYSCALL_DEF(getresuid)>);
-    REGISTER_SYSCALL_IMPL_X32(setresgid32, SyscallPassthrough3<SYSCALL_DEF(setresgid)>);
-    REGISTER_SYSCALL_IMPL_X32(getresgid32, SyscallPassthrough3<SYSCALL_DEF(getresgid)>);
-    REGISTER_SYSCALL_IMPL_X32(setuid32, SyscallPassthrough1<SYSCALL_DEF(setuid)>);
-    REGISTER_SYSCALL_IMPL_X32(setgid32, SyscallPassthrough1<SYSCALL_DEF(setgid)>);
-    REGISTER_SYSCALL_IMPL_X32(setfsuid32, SyscallPassthrough1<SYSCALL_DEF(setfsuid)>);
-    REGISTER_SYSCALL_IMPL_X32(setfsgid32, SyscallPassthrough1<SYSCALL_DEF(setfsgid)>);
-    REGISTER_SYSCALL_IMPL_X32(sendfile64, SyscallPassthrough4<SYSCALL_DEF(sendfile)>);
-    REGISTER_SYSCALL_IMPL_X32(clock_gettime64, SyscallPassthrough2<SYSCALL_DEF(clock_gettime)>);
-    REGISTER_SYSCALL_IMPL_X32(clock_settime64, SyscallPassthrough2<SYSCALL_DEF(clock_settime)>);
-    REGISTER_SYSCALL_IMPL_X32(clock_adjtime64, SyscallPassthrough2<SYSCALL_DEF(clock_adjtime)>);
-    REGISTER_SYSCALL_IMPL_X32(clock_getres_time64, SyscallPassthrough2<SYSCALL_DEF(clock_getres)>);
-    REGISTER_SYSCALL_IMPL_X32(clock_nanosleep_time64, SyscallPassthrough4<SYSCALL_DEF(clock_nanosleep)>);
-    REGISTER_SYSCALL_IMPL_X32(timer_gettime64, SyscallPassthrough2<SYSCALL_DEF(timer_gettime)>);
-    REGISTER_SYSCALL_IMPL_X32(timer_settime64, SyscallPassthrough4<SYSCALL_DEF(timer_settime)>);
-    REGISTER_SYSCALL_IMPL_X32(timerfd_gettime64, SyscallPassthrough2<SYSCALL_DEF(timerfd_gettime)>);
-    REGISTER_SYSCALL_IMPL_X32(timerfd_settime64, SyscallPassthrough4<SYSCALL_DEF(timerfd_settime)>);
-    REGISTER_SYSCALL_IMPL_X32(utimensat_time64, SyscallPassthrough4<SYSCALL_DEF(utimensat)>);
-    REGISTER_SYSCALL_IMPL_X32(ppoll_time64, SyscallPassthrough5<SYSCALL_DEF(ppoll)>);
-    REGISTER_SYSCALL_IMPL_X32(io_pgetevents_time64, SyscallPassthrough6<SYSCALL_DEF(io_pgetevents)>);
-    REGISTER_SYSCALL_IMPL_X32(mq_timedsend_time64, SyscallPassthrough5<SYSCALL_DEF(mq_timedsend)>);
-    REGISTER_SYSCALL_IMPL_X32(mq_timedreceive_time64, SyscallPassthrough5<SYSCALL_DEF(mq_timedreceive)>);
-    REGISTER_SYSCALL_IMPL_X32(semtimedop_time64, SyscallPassthrough4<SYSCALL_DEF(semtimedop)>);
-    REGISTER_SYSCALL_IMPL_X32(futex_time64, SyscallPassthrough6<SYSCALL_DEF(futex)>);
-    REGISTER_SYSCALL_IMPL_X32(sched_rr_get_interval_time64, SyscallPassthrough2<SYSCALL_DEF(sched_rr_get_interval)>);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(getuid32, getuid, 0);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(getgid32, getgid, 0);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(geteuid32, geteuid, 0);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(getegid32, getegid, 0);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setreuid32, setreuid, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setregid32, setregid, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(getgroups32, getgroups, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setgroups32, setgroups, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(fchown32, fchown, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setresuid32, setresuid, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(getresuid32, getresuid, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setresgid32, setresgid, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(getresgid32, getresgid, 3);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setuid32, setuid, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setgid32, setgid, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setfsuid32, setfsuid, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(setfsgid32, setfsgid, 1);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(sendfile64, sendfile, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(clock_gettime64, clock_gettime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(clock_settime64, clock_settime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(clock_adjtime64, clock_adjtime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(clock_getres_time64, clock_getres, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(clock_nanosleep_time64, clock_nanosleep, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(timer_gettime64, timer_gettime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(timer_settime64, timer_settime, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(timerfd_gettime64, timerfd_gettime, 2);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(timerfd_settime64, timerfd_settime, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(utimensat_time64, utimensat, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(ppoll_time64, ppoll, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(io_pgetevents_time64, io_pgetevents, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(mq_timedsend_time64, mq_timedsend, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(mq_timedreceive_time64, mq_timedreceive, 5);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(semtimedop_time64, semtimedop, 4);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(futex_time64, futex, 6);
+    REGISTER_SYSCALL_PASSTHROUGH_X32(sched_rr_get_interval_time64, sched_rr_get_interval, 2);
   }
 } // namespace x32
 } // namespace FEX::HLE
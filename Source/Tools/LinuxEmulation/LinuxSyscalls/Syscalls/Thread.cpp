@@ -7,6 +7,7 @@ $end_info$
 
 #include "CodeLoader.h"
 
+#include "LinuxSyscalls/SamplingProfiler.h"
 #include "LinuxSyscalls/SignalDelegator.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/Syscalls/Thread.h"
@@ -567,9 +568,18 @@ void RegisterThread(FEX::HLE::SyscallHandler* Handler) {
 
   REGISTER_SYSCALL_IMPL(exit_group, [](FEXCore::Core::CpuStateFrame* Frame, int status) -> uint64_t {
     Frame->Thread->CTX->FlushAndCloseCodeMap();
+    Frame->Thread->CTX->WriteBlockStats(Frame->Thread);
+    Frame->Thread->CTX->FlushCompileTrace();
+    Frame->Thread->CTX->FlushJITSymbols(Frame->Thread);
 
     // Save telemetry if we're exiting.
     FEX::HLE::_SyscallHandler->GetSignalDelegator()->SaveTelemetry();
+    if (auto Profiler = FEX::HLE::_SyscallHandler->GetSignalDelegator()->GetProfiler()) {
+      Profiler->WriteProfile(Frame->Thread);
+    }
+    if (auto Stats = FEX::HLE::_SyscallHandler->GetSyscallStats()) {
+      Stats->Write();
+    }
     FEX::HLE::_SyscallHandler->TM.CleanupForExit();
 
     syscall(SYSCALL_DEF(exit_group), status);
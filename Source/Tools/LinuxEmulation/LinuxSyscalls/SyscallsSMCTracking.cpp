@@ -12,7 +12,10 @@ $end_info$
 #include "Common/FEXServerClient.h"
 #include "Common/FileMappingBaseAddress.h"
 
+#include <algorithm>
 #include <filesystem>
+#include <limits>
+#include <span>
 #include <sys/file.h>
 #include <sys/mman.h>
 #include <sys/personality.h>
@@ -24,6 +27,7 @@ $end_info$
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/SHMStats.h>
 #include <FEXCore/Utils/SignalScopeGuards.h>
 #include <FEXCore/Utils/TypeDefines.h>
 #include <FEXHeaderUtils/Filesystem.h>
@@ -38,11 +42,15 @@ static void HandleSegfaultForCodeCacheFinalization(FEXCore::Core::InternalThread
   auto RangeToFinalize = Thread.CTX->GetCodeCache().SelectCodeRangeToFinalize(Code, PageIdx, PageIdx + 1);
   if (!RangeToFinalize.empty()) {
     Thread.CTX->GetCodeCache().FinalizeCodePages(Code, RangeToFinalize);
+    ++Code.NumFinalizationFaults;
+    FEXCORE_PROFILE_INSTANT_INCREMENT((&Thread), AccumulatedCodeCachePrivateBytes, RangeToFinalize.size_bytes());
+    FEXCORE_PROFILE_INSTANT_INCREMENT((&Thread), AccumulatedCodeCacheFaultCount, 1);
   }
 }
 
 // Handles segfaults from:
 // - call-ret shadow stack overflow
+// - writes to code cache pages shared with other processes
 // - guest-side self-modifying code (SMC)
 // - lazy loading of mapped code cache pages
 bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState* Thread, int Signal, void* info, void* ucontext) {
@@ -56,6 +64,11 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState* Thread,
     return true;
   }
 
+  // Checked before locking VMATracking since the writer may hold JIT locks, e.g. when linking blocks
+  if (((siginfo_t*)info)->si_code == SEGV_ACCERR && Thread->CTX->GetCodeCache().HandleSharedCodePageWriteFault(Thread, FaultAddress)) {
+    return true;
+  }
+
   {
     // Can't use the deferred signal lock in the SIGSEGV handler.
     auto lk = FEXCore::MaskSignalsAndLockMutex<std::shared_lock>(_SyscallHandler->VMATracking.Mutex);
@@ -72,6 +85,7 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState* Thread,
         // Untracked address; not handled here
         return false;
       }
+      FEXCORE_PROFILE_ACCUMULATION(Thread, AccumulatedCodeCacheFaultTime);
       std::lock_guard lk(_SyscallHandler->CodeCachePatchingMutex);
       HandleSegfaultForCodeCacheFinalization(*Thread, *Code, FaultAddress);
       return true;
@@ -82,6 +96,7 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState* Thread,
       return false;
     }
 
+    FEXCORE_PROFILE_HISTOGRAM(Thread, SMCTimeHistogram);
     auto FaultBase = FEXCore::AlignDown(FaultAddress, FEXCore::Utils::FEX_PAGE_SIZE);
 
     auto UnprotectRegionCallback = [](uintptr_t Start, uintptr_t Length) {
@@ -203,29 +218,57 @@ static FEXCore::ExecutableFileSectionInfo BuildSectionInfo(const VMATracking::Ma
   return FEXCore::ExecutableFileSectionInfo {*Resource.MappedFile, Resource.FirstVMA->Base, Base, Base + Size};
 }
 
-std::optional<FEXCore::ExecutableFileSectionInfo>
-SyscallHandler::LookupExecutableFileSection(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestAddr) {
+std::optional<VMATracking::CachedVMA> SyscallHandler::FindVMA(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestAddr) {
+  auto& Cache = FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(Thread)->VMALookupCache;
+
+  {
+    // A guest signal handler could overwrite the cache while it's being copied
+    FEXCore::DeferredSignalRefCountGuard Guard {Thread};
+    if (Cache.Generation == VMATracking.Generation.load(std::memory_order_acquire) && GuestAddr - Cache.Base < Cache.Length) {
+      return Cache;
+    }
+  }
+
   auto lk = FEXCore::GuardSignalDeferringSection<std::shared_lock>(VMATracking.Mutex, Thread);
 
   auto EntryIt = VMATracking.FindVMAEntry(GuestAddr);
-  if (EntryIt == VMATracking.VMAs.end() || !EntryIt->second.Resource || !EntryIt->second.Resource->MappedFile) {
+  if (EntryIt == VMATracking.VMAs.end()) {
     return std::nullopt;
   }
 
-  auto& [MappingBaseAddr, Entry] = *EntryIt;
-  return BuildSectionInfo(*Entry.Resource, MappingBaseAddr, Entry.Length);
+  // Writers are excluded while the lock is held, so this is the generation the entry belongs to
+  const auto& [MappingBaseAddr, Entry] = *EntryIt;
+  const auto Resource = Entry.Resource;
+  const bool HasFile = Resource && Resource->MappedFile;
+  Cache = {
+    .Generation = VMATracking.Generation.load(std::memory_order_relaxed),
+    .Base = MappingBaseAddr,
+    .Length = Entry.Length,
+    .Prot = Entry.Prot,
+    .File = HasFile ? Resource->MappedFile.get() : nullptr,
+    .FileStartVA = HasFile ? Resource->FirstVMA->Base : 0,
+  };
+  return Cache;
+}
+
+std::optional<FEXCore::ExecutableFileSectionInfo>
+SyscallHandler::LookupExecutableFileSection(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestAddr) {
+  auto VMA = FindVMA(Thread, GuestAddr);
+  if (!VMA || !VMA->File) {
+    return std::nullopt;
+  }
+
+  return FEXCore::ExecutableFileSectionInfo {*VMA->File, VMA->FileStartVA, VMA->Base, VMA->Base + VMA->Length};
 }
 
 FEXCore::HLE::ExecutableRangeInfo SyscallHandler::QueryGuestExecutableRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Address) {
-  auto lk = FEXCore::GuardSignalDeferringSection<std::shared_lock>(VMATracking.Mutex, Thread);
   auto ThreadObject = FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(Thread);
 
-  auto Entry = VMATracking.FindVMAEntry(Address);
-  if (Entry == VMATracking.VMAs.end() ||
-      (!Entry->second.Prot.Executable && (!(ThreadObject->persona & READ_IMPLIES_EXEC) || !Entry->second.Prot.Readable))) {
+  auto VMA = FindVMA(Thread, Address);
+  if (!VMA || (!VMA->Prot.Executable && (!(ThreadObject->persona & READ_IMPLIES_EXEC) || !VMA->Prot.Readable))) {
     return {0, 0, false};
   }
-  return {Entry->first, Entry->second.Length, Entry->second.Prot.Writable};
+  return {VMA->Base, VMA->Length, VMA->Prot.Writable};
 }
 
 struct ReadELFHeadersResult {
@@ -259,13 +302,55 @@ static ReadELFHeadersResult ReadELFHeaders(int FD, std::span<std::byte> HeaderDa
   return ReadELFHeadersResult {std::move(Parser.phdrs), std::move(Relocations), HasCodeRelocations};
 }
 
+// Maps relocated code that another process shared through FEXServer, or shares our own relocated code if there is none yet.
+// If this fails, code pages are finalized privately instead.
+static void MapSharedCodeCache(FEXCore::Core::InternalThreadState& Thread, FEXCore::MappedCodeCacheFile& Code, const struct stat& CacheFileStats) {
+  const int ServerFD = FEXServerClient::GetServerFD();
+  if (ServerFD == -1) {
+    return;
+  }
+
+  auto& CodeCache = Thread.CTX->GetCodeCache();
+  const FEXServerClient::SharedCodeCacheKey Key {
+    .CacheDev = CacheFileStats.st_dev,
+    .CacheInode = CacheFileStats.st_ino,
+    .CacheMTimeNs = CacheFileStats.st_mtim.tv_sec * 1'000'000'000LL + CacheFileStats.st_mtim.tv_nsec,
+    .GuestBase = Code.GuestBase,
+    .CodeSize = Code.CodeBuffer.size_bytes(),
+  };
+
+  bool IsFirstUser = false;
+  int CodeFD = FEXServerClient::RequestSharedCodeCacheFD(ServerFD, Key);
+  if (CodeFD == -1) {
+    CodeFD = CodeCache.CreateSharedCodeBuffer(Code);
+    if (CodeFD == -1) {
+      return;
+    }
+    IsFirstUser = true;
+  }
+
+  auto NumPrivatePages = CodeCache.MapSharedCodeBuffer(Code, CodeFD);
+  if (NumPrivatePages && IsFirstUser) {
+    FEXServerClient::PublishSharedCodeCache(ServerFD, Key, CodeFD);
+  }
+  close(CodeFD);
+
+  if (NumPrivatePages) {
+    const size_t PrivateBytes = *NumPrivatePages * FEXCore::Utils::FEX_PAGE_SIZE;
+    FEXCORE_PROFILE_INSTANT_INCREMENT((&Thread), AccumulatedCodeCachePrivateBytes, PrivateBytes);
+    FEXCORE_PROFILE_INSTANT_INCREMENT((&Thread), AccumulatedCodeCacheSharedBytes, Code.CodeBuffer.size_bytes() - PrivateBytes);
+    LogMan::Msg::DFmt("Mapped {} shared code cache: {} KiB shared, {} KiB private", IsFirstUser ? "new" : "existing",
+                      (Code.CodeBuffer.size_bytes() - PrivateBytes) / 1024, PrivateBytes / 1024);
+  }
+}
+
 static fextl::unique_ptr<FEXCore::MappedCodeCacheFile>
 LoadCodeCache(FEXCore::Core::InternalThreadState& Thread, VMATracking::VMATracking& VMATracking,
-              const FEXCore::ExecutableFileInfo& FileInfo, uint64_t CodeCacheConfigId, uint64_t FileStartVA) {
+              const FEXCore::ExecutableFileInfo& FileInfo, uint64_t FileStartVA) {
   auto& CodeCache = Thread.CTX->GetCodeCache();
 
   auto CacheFilename = fextl::fmt::format("{}cache/{}-{:016x}", FEX::Config::GetCacheDirectory(),
-                                          FEXCore::CodeMap::GetBaseFilename(FileInfo, false), CodeCacheConfigId);
+                                          FEXCore::CodeMap::GetBaseFilename(FileInfo, false), CodeCache.GetConfigId());
   int CacheFD = open(CacheFilename.c_str(), O_RDONLY);
   if (CacheFD == -1) {
     LogMan::Msg::IFmt("Cache file does not exist: {}", CacheFilename);
@@ -281,18 +366,33 @@ LoadCodeCache(FEXCore::Core::InternalThreadState& Thread, VMATracking::VMATracki
 
   auto CacheFileSize = static_cast<std::size_t>(buf.st_size);
   auto MappedCache = (std::byte*)FEXCore::Allocator::mmap(nullptr, CacheFileSize, PROT_READ, MAP_PRIVATE, CacheFD, 0);
-  close(CacheFD);
   if (!MappedCache || MappedCache == MAP_FAILED) {
     LogMan::Msg::EFmt("Failed to map code cache into memory");
+    close(CacheFD);
     return nullptr;
   }
 
   auto Result = CodeCache.LoadCache(std::span {MappedCache, CacheFileSize}, FileInfo, FileStartVA);
   if (!Result) {
     FEXCore::Allocator::munmap(MappedCache, CacheFileSize);
+    close(CacheFD);
     return nullptr;
   }
 
+  // Position-independent caches can be executed from the page cache directly, which shares them without FEXServer
+  auto NumPrivatePages = CodeCache.MapCodeBufferFromFile(*Result, CacheFD);
+  close(CacheFD);
+  if (NumPrivatePages) {
+    const size_t PrivateBytes = *NumPrivatePages * FEXCore::Utils::FEX_PAGE_SIZE;
+    FEXCORE_PROFILE_INSTANT_INCREMENT((&Thread), AccumulatedCodeCachePrivateBytes, PrivateBytes);
+    FEXCORE_PROFILE_INSTANT_INCREMENT((&Thread), AccumulatedCodeCacheSharedBytes, Result->CodeBuffer.size_bytes() - PrivateBytes);
+  } else {
+    FEX_CONFIG_OPT(CodeCacheSharedPages, CODECACHESHAREDPAGES);
+    if (CodeCacheSharedPages()) {
+      MapSharedCodeCache(Thread, *Result, buf);
+    }
+  }
+
   // NOTE: This is synchronized by acquiring VMATracking.Mutex at call site
   CodeCache.RegisterMappedCodeBuffer(*Result);
 
@@ -342,10 +442,13 @@ void* SyscallHandler::GuestMmap(bool Is64Bit, FEXCore::Core::InternalThreadState
   }
 
   if (EnableCodeCaching && CachedSection) {
-    Thread->CTX->GetCodeCache().EnableLoadedSection(
-      Thread, *static_cast<const VMATracking::ExecutableFileState&>(CachedSection->FileInfo).MappedCache, *CachedSection);
+    auto& Cache = *static_cast<const VMATracking::ExecutableFileState&>(CachedSection->FileInfo).MappedCache;
+    Thread->CTX->GetCodeCache().EnableLoadedSection(Thread, Cache, *CachedSection);
+    QueueCodeCacheFinalization(Thread, Cache);
   }
 
+  LoadUpdatedCodeCaches(Thread);
+
   return reinterpret_cast<void*>(Result);
 }
 
@@ -427,7 +530,7 @@ void SyscallHandler::TriggerGuestLibWrapperCodeCacheLoad(FEXCore::Core::Internal
     }
 
     auto SectionInfo = BuildSectionInfo(*VMAEntry->second.Resource, VMA->Base, VMA->Length);
-    LoadCodeCache(Thread, VMATracking, SectionInfo.FileInfo, CodeCacheConfigId, SectionInfo.FileStartVA);
+    LoadCodeCache(Thread, VMATracking, SectionInfo.FileInfo, SectionInfo.FileStartVA);
   }
 }
 
@@ -447,7 +550,7 @@ int SyscallHandler::OpenCodeMapFile() {
     return -1;
   }
 
-  int CodeMapFD = FEXServerClient::RequestCodeMapFD(FEXServerClient::GetServerFD(), ProgramFD, Multiblock);
+  int CodeMapFD = FEXServerClient::RequestCodeMapFD(FEXServerClient::GetServerFD(), ProgramFD, Multiblock, CTX->GetCodeCache().GetConfigId());
   close(ProgramFD);
   if (CodeMapFD == -1) {
     return -1;
@@ -465,6 +568,180 @@ int SyscallHandler::OpenCodeMapFile() {
   return CodeMapFD;
 }
 
+void SyscallHandler::LoadUpdatedCodeCaches(FEXCore::Core::InternalThreadState* Thread) {
+  if (!EnableCodeCaching || CodeCacheUpdateFD == -1 || !Thread) {
+    return;
+  }
+
+  // Rate-limit polling, and only let one thread poll at a time
+  const int64_t Now = std::chrono::steady_clock::now().time_since_epoch().count();
+  auto NextPoll = NextCodeCacheUpdatePoll.load(std::memory_order_relaxed);
+  if (Now < NextPoll || !NextCodeCacheUpdatePoll.compare_exchange_strong(
+                          NextPoll, Now + std::chrono::steady_clock::duration {CODE_CACHE_UPDATE_POLL_INTERVAL}.count(), std::memory_order_relaxed)) {
+    return;
+  }
+
+  fextl::set<uint64_t> UpdatedFileIds;
+  {
+    FEXServerClient::CodeCacheUpdateNotification Notifications[16];
+    ssize_t Read;
+    while ((Read = read(CodeCacheUpdateFD, Notifications, sizeof(Notifications))) > 0) {
+      for (auto& Notification : std::span {Notifications, Read / sizeof(Notifications[0])}) {
+        UpdatedFileIds.insert(Notification.FileId);
+      }
+    }
+
+    if (Read == 0) {
+      // FEXServer has shut down, so no further notifications will arrive
+      LogMan::Msg::DFmt("FEXServer closed code cache update channel");
+      NextCodeCacheUpdatePoll = std::numeric_limits<int64_t>::max();
+    }
+  }
+
+  if (UpdatedFileIds.empty()) {
+    return;
+  }
+
+  fextl::vector<FEXCore::ExecutableFileSectionInfo> CachedSections;
+  {
+    auto lk = FEXCore::GuardSignalDeferringSection(VMATracking.Mutex, Thread);
+
+    for (auto& [Base, VMA] : VMATracking.VMAs) {
+      // Visit each resource once through its first VMA
+      auto Resource = VMA.Resource;
+      if (!Resource || Resource->FirstVMA != &VMA || !Resource->MappedFile || Resource->MappedFile->MappedCache ||
+          !UpdatedFileIds.contains(Resource->MappedFile->FileId)) {
+        continue;
+      }
+
+      if (Resource->MappedFile->Filename.ends_with("-guest.so")) {
+        // Guest library wrappers are only loaded through LoadLib
+        continue;
+      }
+
+      Resource->MappedFile->MappedCache = LoadCodeCache(*Thread, VMATracking, *Resource->MappedFile, Resource->FirstVMA->Base);
+      Resource->MappedFile->AttemptedCacheLoad = true;
+      if (!Resource->MappedFile->MappedCache || Resource->RequiresDelayedCacheLoad) {
+        // If relocations are still pending, the cache is enabled by the delayed load in GuestMprotect
+        continue;
+      }
+
+      LogMan::Msg::IFmt("Loading background-compiled code cache for {}", Resource->MappedFile->Filename);
+      for (auto ExecVMA = Resource->FirstVMA; ExecVMA; ExecVMA = ExecVMA->ResourceNextVMA) {
+        if (ExecVMA->Prot.Executable) {
+          CachedSections.push_back(BuildSectionInfo(*Resource, ExecVMA->Base, ExecVMA->Length));
+        }
+      }
+    }
+  }
+
+  // EnableLoadedSection will call interfaces that acquire the VMATracking mutex
+  for (auto& CachedSection : CachedSections) {
+    auto Cache = static_cast<const VMATracking::ExecutableFileState&>(CachedSection.FileInfo).MappedCache.get();
+    Thread->CTX->GetCodeCache().EnableLoadedSection(Thread, *Cache, CachedSection);
+    QueueCodeCacheFinalization(Thread, *Cache);
+  }
+}
+
+void SyscallHandler::QueueCodeCacheFinalization(FEXCore::Core::InternalThreadState* Thread, FEXCore::MappedCodeCacheFile& Code) {
+  if (!EnableLazyCodeCaching() || !CodeCacheEagerFinalization()) {
+    return;
+  }
+
+  PendingCodeCacheFinalization Pending {
+    .Code = &Code,
+    .CodeBufferBase = reinterpret_cast<uintptr_t>(Code.CodeBuffer.data()),
+    .QueueTime = std::chrono::steady_clock::now(),
+  };
+
+  {
+    auto lk = FEXCore::GuardSignalDeferringSection(VMATracking.Mutex, Thread);
+    if (VMATracking.FindMappedCodeCacheByHostAddress(Pending.CodeBufferBase) != &Code) {
+      // Mapped into the code buffer eagerly (e.g. shared or position-independent pages) or already unmapped again
+      return;
+    }
+    // The block list is parsed upfront since the worker thread must not touch Code without holding VMATracking.Mutex
+    Pending.PageOrder = FEXCore::AbstractCodeCache::GetEagerFinalizationOrder(Code);
+  }
+
+  auto lk = FEXCore::GuardSignalDeferringSectionWithFallback(CodeCacheFinalizationMutex, Thread);
+  if (std::ranges::any_of(CodeCacheFinalizationQueue, [&](auto& Entry) { return Entry.Code == &Code; })) {
+    return;
+  }
+  CodeCacheFinalizationQueue.push_back(std::move(Pending));
+
+  if (!CodeCacheFinalizationThread) {
+    // Signals are masked on the worker so that it never needs to run guest signal handlers
+    uint64_t OldMask = FEX::HLE::ThreadManager::SetSignalMask(~0ULL);
+    CodeCacheFinalizationThread = FEXCore::Threads::Thread::Create(CodeCacheFinalizationThreadFunc, this);
+    FEX::HLE::ThreadManager::SetSignalMask(OldMask);
+  }
+  CodeCacheFinalizationCV.notify_one();
+}
+
+void* SyscallHandler::CodeCacheFinalizationThreadFunc(void* Arg) {
+  FEX::HLE::ThreadManager::SetThreadName("FEX:cachewarm");
+  reinterpret_cast<SyscallHandler*>(Arg)->CodeCacheFinalizationLoop();
+  return nullptr;
+}
+
+// Finalizes the next few pages of the given cache. Returns false once all pages were processed or the cache was unmapped.
+bool SyscallHandler::FinalizeCodeCacheBatch(PendingCodeCacheFinalization& Pending) {
+  // Lock order matches HandleSegfault
+  std::shared_lock lk(VMATracking.Mutex);
+  auto* Code = Pending.Code;
+  if (VMATracking.FindMappedCodeCacheByHostAddress(Pending.CodeBufferBase) != Code) {
+    return false;
+  }
+
+  std::lock_guard PatchLock(CodeCachePatchingMutex);
+  auto& CodeCache = CTX->GetCodeCache();
+  const size_t BatchEnd = std::min(Pending.PageOrder.size(), Pending.NextPage + CODE_CACHE_FINALIZATION_BATCH_SIZE);
+  for (; Pending.NextPage < BatchEnd; ++Pending.NextPage) {
+    size_t PageIdx = Pending.PageOrder[Pending.NextPage];
+    if (PageIdx >= Code->NumPages()) {
+      continue;
+    }
+
+    auto RangeToFinalize = CodeCache.SelectCodeRangeToFinalize(*Code, PageIdx, PageIdx + 1);
+    if (!RangeToFinalize.empty()) {
+      CodeCache.FinalizeCodePages(*Code, RangeToFinalize);
+      ++Pending.NumRangesFinalized;
+    }
+  }
+
+  if (Pending.NextPage != Pending.PageOrder.size()) {
+    return true;
+  }
+
+  const auto Elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - Pending.QueueTime);
+  LogMan::Msg::IFmt("Code cache at {:#x} warm after {} ms: {} page ranges finalized ahead of execution, {} on first use",
+                    Pending.CodeBufferBase, Elapsed.count(), Pending.NumRangesFinalized, Code->NumFinalizationFaults);
+  return false;
+}
+
+void SyscallHandler::CodeCacheFinalizationLoop() {
+  std::unique_lock lk(CodeCacheFinalizationMutex);
+  while (true) {
+    CodeCacheFinalizationCV.wait(lk, [this] { return StopCodeCacheFinalization || !CodeCacheFinalizationQueue.empty(); });
+    if (StopCodeCacheFinalization) {
+      return;
+    }
+
+    // Take the entry out of the queue so that guest threads aren't blocked on the mutex while pages are finalized.
+    auto Pending = std::move(CodeCacheFinalizationQueue.front());
+    CodeCacheFinalizationQueue.pop_front();
+    lk.unlock();
+
+    bool MorePages;
+    do {
+      MorePages = FinalizeCodeCacheBatch(Pending);
+    } while (MorePages && !StopCodeCacheFinalization.load(std::memory_order_relaxed));
+
+    lk.lock();
+  }
+}
+
 uint64_t SyscallHandler::GuestMprotect(FEXCore::Core::InternalThreadState* Thread, void* addr, size_t len, int prot) {
   uint64_t Result {};
 
@@ -507,9 +784,12 @@ uint64_t SyscallHandler::GuestMprotect(FEXCore::Core::InternalThreadState* Threa
     auto Cache = static_cast<const VMATracking::ExecutableFileState&>(CachedSection.FileInfo).MappedCache.get();
     if (Cache) {
       Thread->CTX->GetCodeCache().EnableLoadedSection(Thread, *Cache, CachedSection);
+      QueueCodeCacheFinalization(Thread, *Cache);
     }
   }
 
+  LoadUpdatedCodeCaches(Thread);
+
   return Result;
 }
 
@@ -696,7 +976,7 @@ SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState* Thread, uint64_t a
   // FEXServer was requested to generate library caches on program launch.
   if (EnableCodeCaching && Resource && Resource->MappedFile && VMATracking::VMAProt::fromProt(prot).Executable) {
     if (!Resource->MappedFile->AttemptedCacheLoad) {
-      Resource->MappedFile->MappedCache = LoadCodeCache(*Thread, VMATracking, *Resource->MappedFile, CodeCacheConfigId, Resource->FirstVMA->Base);
+      Resource->MappedFile->MappedCache = LoadCodeCache(*Thread, VMATracking, *Resource->MappedFile, Resource->FirstVMA->Base);
       Resource->MappedFile->AttemptedCacheLoad = true;
     }
 
@@ -178,6 +178,7 @@ VMATracking::VMACIterator VMATracking::FindVMAEntry(uint64_t GuestAddr) const {
 void VMATracking::TrackVMARange(FEXCore::Context::Context* CTX, MappedResource* MappedResource, uintptr_t Base, uintptr_t Offset,
                                 uintptr_t Length, VMAFlags Flags, VMAProt Prot) {
   Mutex.check_lock_owned_by_self_as_write();
+  Generation.fetch_add(1, std::memory_order_release);
 
   DeleteVMARange(CTX, Base, Length, MappedResource);
 
@@ -207,6 +208,7 @@ void VMATracking::TrackVMARange(FEXCore::Context::Context* CTX, MappedResource*
 // freeing their associated MappedResource unless it is equal to PreservedMappedResource
 void VMATracking::DeleteVMARange(FEXCore::Context::Context* CTX, uintptr_t Base, uintptr_t Length, MappedResource* PreservedMappedResource) {
   Mutex.check_lock_owned_by_self_as_write();
+  Generation.fetch_add(1, std::memory_order_release);
 
   const auto Top = Base + Length;
 
@@ -301,6 +303,7 @@ void VMATracking::FlushPendingResourceDeletions() {
 // Change flags of mappings in a range and split the mappings if needed
 void VMATracking::ChangeProtectionFlags(uintptr_t Base, uintptr_t Length, VMAProt NewProt) {
   Mutex.check_lock_owned_by_self_as_write();
+  Generation.fetch_add(1, std::memory_order_release);
 
   // Handle 0 size as no-op like the kernel
   if (Length == 0) {
@@ -537,6 +540,7 @@ void VMATracking::ChangeProtectionFlags(uintptr_t Base, uintptr_t Length, VMAPro
 
 // This matches the peculiarities algorithm used in linux ksys_shmdt (linux kernel 5.16, ipc/shm.c)
 uintptr_t VMATracking::DeleteSHMRegion(FEXCore::Context::Context* CTX, uintptr_t Base) {
+  Generation.fetch_add(1, std::memory_order_release);
 
   // Find first VMA at or after Base
   // Iterate until first SHM VMA, with matching offset, get length
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <tuple>
 
@@ -99,10 +100,27 @@ struct VMAEntry {
   VMAProt Prot;
 };
 
+// Copy of the VMA last looked up by a thread, see VMATracking::Generation
+struct CachedVMA {
+  uint64_t Generation {~0ULL};
+  uint64_t Base {};
+  uint64_t Length {};
+  VMAProt Prot {};
+
+  // Only set for VMAs backed by an executable file
+  const FEXCore::ExecutableFileInfo* File {};
+  uint64_t FileStartVA {};
+};
+
 struct VMATracking {
   // Held while reading/writing this struct
   FEXCore::ForkableSharedMutex Mutex;
 
+  // Incremented by every function that modifies the VMAs or their resources.
+  // Lookups copy the VMA to a thread local CachedVMA, which can then be used
+  // without taking Mutex for as long as the generation doesn't change.
+  std::atomic<uint64_t> Generation {};
+
   // Memory ranges indexed by page aligned starting address
   fextl::map<uint64_t, VMAEntry> VMAs;
 
@@ -3,6 +3,7 @@
 #include "LinuxSyscalls/ThreadManager.h"
 
 #include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/SamplingProfiler.h"
 #include "LinuxSyscalls/SignalDelegator.h"
 #include "LinuxSyscalls/Seccomp/SeccompEmulator.h"
 
@@ -257,6 +258,15 @@ void ThreadManager::DestroyThread(FEX::HLE::ThreadStateObject* Thread, bool Need
     Threads.erase(It);
     if (Threads.empty()) {
       Thread->Thread->CTX->FlushAndCloseCodeMap();
+      Thread->Thread->CTX->WriteBlockStats(Thread->Thread);
+      Thread->Thread->CTX->FlushCompileTrace();
+      Thread->Thread->CTX->FlushJITSymbols(Thread->Thread);
+      if (auto Profiler = SignalDelegation->GetProfiler()) {
+        Profiler->WriteProfile(Thread->Thread);
+      }
+      if (auto Stats = FEX::HLE::_SyscallHandler->GetSyscallStats()) {
+        Stats->Write();
+      }
     }
   }
 
@@ -10,6 +10,8 @@ $end_info$
 
 #include "Common/SHMStats.h"
 
+#include "LinuxSyscalls/ScratchArena.h"
+#include "LinuxSyscalls/SyscallsVMATracking.h"
 #include "LinuxSyscalls/Types.h"
 #include "LinuxSyscalls/x32/IoctlEmulation.h"
 
@@ -92,6 +94,15 @@ struct ThreadStateObject : public FEXCore::Allocator::FEXAllocOperators {
   // personality emulation.
   uint32_t persona {};
 
+  // Last VMA found by SyscallHandler::FindVMA
+  VMATracking::CachedVMA VMALookupCache {};
+
+  // Temporary storage for converting syscall arguments between guest and host layouts
+  ScratchArena SyscallScratch;
+
+  // Kernel timer ID used by the sampling profiler, -1 if not armed
+  int ProfilerTimerID {-1};
+
   FEXCore::Core::NonMovableUniquePtr<FEXCore::Threads::Thread> ExecutionThread;
 
   // Thread signaling information
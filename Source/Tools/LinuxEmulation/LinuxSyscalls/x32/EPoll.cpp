@@ -6,14 +6,13 @@ tags: LinuxSyscalls|syscalls-x86-32
 $end_info$
 */
 
+#include "LinuxSyscalls/ScratchArena.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/Types.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 
-#include <FEXCore/fextl/vector.h>
-
 #include <algorithm>
 #include <cstdint>
 #include <sys/epoll.h>
@@ -33,8 +32,9 @@ void RegisterEpoll(FEX::HLE::SyscallHandler* Handler) {
   REGISTER_SYSCALL_IMPL_X32(
     epoll_wait,
     [](FEXCore::Core::CpuStateFrame* Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevents, int timeout) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevents));
-      uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events.data(), maxevents, timeout, nullptr, 8);
+      ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
+      auto Events = Scratch.Allocate<struct epoll_event>(std::max(0, maxevents));
+      uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events, maxevents, timeout, nullptr, 8);
 
       if (Result != -1) {
         FaultSafeUserMemAccess::VerifyIsWritable(events, sizeof(FEX::HLE::x32::epoll_event32) * Result);
@@ -66,9 +66,10 @@ void RegisterEpoll(FEX::HLE::SyscallHandler* Handler) {
   REGISTER_SYSCALL_IMPL_X32(epoll_pwait,
                             [](FEXCore::Core::CpuStateFrame* Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent,
                                int timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-                              fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
+                              ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
+                              auto Events = Scratch.Allocate<struct epoll_event>(std::max(0, maxevent));
 
-                              uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events.data(), maxevent, timeout, sigmask, sigsetsize);
+                              uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events, maxevent, timeout, sigmask, sigsetsize);
 
                               if (Result != -1) {
                                 FaultSafeUserMemAccess::VerifyIsWritable(events, sizeof(FEX::HLE::x32::epoll_event32) * Result);
@@ -83,7 +84,8 @@ void RegisterEpoll(FEX::HLE::SyscallHandler* Handler) {
   REGISTER_SYSCALL_IMPL_X32(epoll_pwait2,
                             [](FEXCore::Core::CpuStateFrame* Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent,
                                compat_ptr<timespec32> timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-                              fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
+                              ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
+                              auto Events = Scratch.Allocate<struct epoll_event>(std::max(0, maxevent));
 
                               struct timespec tp64 {};
                               struct timespec* timed_ptr {};
@@ -93,7 +95,7 @@ void RegisterEpoll(FEX::HLE::SyscallHandler* Handler) {
                               }
 
                               uint64_t Result =
-                                ::syscall(SYSCALL_DEF(epoll_pwait2), epfd, Events.data(), maxevent, timed_ptr, sigmask, sigsetsize);
+                                ::syscall(SYSCALL_DEF(epoll_pwait2), epfd, Events, maxevent, timed_ptr, sigmask, sigsetsize);
 
                               if (Result != -1) {
                                 FaultSafeUserMemAccess::VerifyIsWritable(events, sizeof(FEX::HLE::x32::epoll_event32) * Result);
@@ -5,6 +5,7 @@ tags: LinuxSyscalls|syscalls-x86-32
 $end_info$
 */
 
+#include "LinuxSyscalls/ScratchArena.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/x32/IoctlEmulation.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
@@ -16,7 +17,6 @@ $end_info$
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
-#include <FEXCore/fextl/vector.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -282,16 +282,18 @@ void RegisterFD(FEX::HLE::SyscallHandler* Handler) {
     });
 
   REGISTER_SYSCALL_IMPL_X32(readv, [](FEXCore::Core::CpuStateFrame* Frame, int fd, const struct iovec32* iov, int iovcnt) -> uint64_t {
+    ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
     FaultSafeUserMemAccess::VerifyIsReadable(iov, sizeof(struct iovec32) * SanitizeIOCount(iovcnt));
-    fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
-    uint64_t Result = ::readv(fd, Host_iovec.data(), iovcnt);
+    auto Host_iovec = Scratch.Convert<iovec>(iov, SanitizeIOCount(iovcnt));
+    uint64_t Result = ::readv(fd, Host_iovec, iovcnt);
     SYSCALL_ERRNO();
   });
 
   REGISTER_SYSCALL_IMPL_X32(writev, [](FEXCore::Core::CpuStateFrame* Frame, int fd, const struct iovec32* iov, int iovcnt) -> uint64_t {
+    ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
     FaultSafeUserMemAccess::VerifyIsReadable(iov, sizeof(struct iovec32) * SanitizeIOCount(iovcnt));
-    fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
-    uint64_t Result = ::writev(fd, Host_iovec.data(), iovcnt);
+    auto Host_iovec = Scratch.Convert<iovec>(iov, SanitizeIOCount(iovcnt));
+    uint64_t Result = ::writev(fd, Host_iovec, iovcnt);
     SYSCALL_ERRNO();
   });
 
@@ -496,67 +498,71 @@ void RegisterFD(FEX::HLE::SyscallHandler* Handler) {
 
   REGISTER_SYSCALL_IMPL_X32(
     preadv, [](FEXCore::Core::CpuStateFrame* Frame, int fd, const struct iovec32* iov, uint32_t iovcnt, uint32_t pos_low, uint32_t pos_high) -> uint64_t {
+      ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
       FaultSafeUserMemAccess::VerifyIsReadable(iov, sizeof(struct iovec32) * SanitizeIOCount(iovcnt));
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      auto Host_iovec = Scratch.Convert<iovec>(iov, SanitizeIOCount(iovcnt));
 
-      uint64_t Result = ::syscall(SYSCALL_DEF(preadv), fd, Host_iovec.data(), iovcnt, pos_low, pos_high);
+      uint64_t Result = ::syscall(SYSCALL_DEF(preadv), fd, Host_iovec, iovcnt, pos_low, pos_high);
       SYSCALL_ERRNO();
     });
 
   REGISTER_SYSCALL_IMPL_X32(
     pwritev, [](FEXCore::Core::CpuStateFrame* Frame, int fd, const struct iovec32* iov, uint32_t iovcnt, uint32_t pos_low, uint32_t pos_high) -> uint64_t {
+      ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
       FaultSafeUserMemAccess::VerifyIsReadable(iov, sizeof(struct iovec32) * SanitizeIOCount(iovcnt));
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      auto Host_iovec = Scratch.Convert<iovec>(iov, SanitizeIOCount(iovcnt));
 
-      uint64_t Result = ::syscall(SYSCALL_DEF(pwritev), fd, Host_iovec.data(), iovcnt, pos_low, pos_high);
+      uint64_t Result = ::syscall(SYSCALL_DEF(pwritev), fd, Host_iovec, iovcnt, pos_low, pos_high);
       SYSCALL_ERRNO();
     });
 
   REGISTER_SYSCALL_IMPL_X32(process_vm_readv,
                             [](FEXCore::Core::CpuStateFrame* Frame, pid_t pid, const struct iovec32* local_iov, unsigned long liovcnt,
                                const struct iovec32* remote_iov, unsigned long riovcnt, unsigned long flags) -> uint64_t {
+                              ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
                               FaultSafeUserMemAccess::VerifyIsReadable(local_iov, sizeof(struct iovec32) * SanitizeIOCount(liovcnt));
                               FaultSafeUserMemAccess::VerifyIsReadable(remote_iov, sizeof(struct iovec32) * SanitizeIOCount(riovcnt));
 
-                              fextl::vector<iovec> Host_local_iovec(local_iov, local_iov + SanitizeIOCount(liovcnt));
-                              fextl::vector<iovec> Host_remote_iovec(remote_iov, remote_iov + SanitizeIOCount(riovcnt));
+                              auto Host_local_iovec = Scratch.Convert<iovec>(local_iov, SanitizeIOCount(liovcnt));
+                              auto Host_remote_iovec = Scratch.Convert<iovec>(remote_iov, SanitizeIOCount(riovcnt));
 
-                              uint64_t Result =
-                                ::process_vm_readv(pid, Host_local_iovec.data(), liovcnt, Host_remote_iovec.data(), riovcnt, flags);
+                              uint64_t Result = ::process_vm_readv(pid, Host_local_iovec, liovcnt, Host_remote_iovec, riovcnt, flags);
                               SYSCALL_ERRNO();
                             });
 
   REGISTER_SYSCALL_IMPL_X32(process_vm_writev,
                             [](FEXCore::Core::CpuStateFrame* Frame, pid_t pid, const struct iovec32* local_iov, unsigned long liovcnt,
                                const struct iovec32* remote_iov, unsigned long riovcnt, unsigned long flags) -> uint64_t {
+                              ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
                               FaultSafeUserMemAccess::VerifyIsReadable(local_iov, sizeof(struct iovec32) * SanitizeIOCount(liovcnt));
                               FaultSafeUserMemAccess::VerifyIsReadable(remote_iov, sizeof(struct iovec32) * SanitizeIOCount(riovcnt));
 
-                              fextl::vector<iovec> Host_local_iovec(local_iov, local_iov + SanitizeIOCount(liovcnt));
-                              fextl::vector<iovec> Host_remote_iovec(remote_iov, remote_iov + SanitizeIOCount(riovcnt));
+                              auto Host_local_iovec = Scratch.Convert<iovec>(local_iov, SanitizeIOCount(liovcnt));
+                              auto Host_remote_iovec = Scratch.Convert<iovec>(remote_iov, SanitizeIOCount(riovcnt));
 
-                              uint64_t Result =
-                                ::process_vm_writev(pid, Host_local_iovec.data(), liovcnt, Host_remote_iovec.data(), riovcnt, flags);
+                              uint64_t Result = ::process_vm_writev(pid, Host_local_iovec, liovcnt, Host_remote_iovec, riovcnt, flags);
                               SYSCALL_ERRNO();
                             });
 
   REGISTER_SYSCALL_IMPL_X32(preadv2,
                             [](FEXCore::Core::CpuStateFrame* Frame, int fd, const struct iovec32* iov, uint32_t iovcnt, uint32_t pos_low,
                                uint32_t pos_high, int flags) -> uint64_t {
+                              ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
                               FaultSafeUserMemAccess::VerifyIsReadable(iov, sizeof(struct iovec32) * SanitizeIOCount(iovcnt));
-                              fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+                              auto Host_iovec = Scratch.Convert<iovec>(iov, SanitizeIOCount(iovcnt));
 
-                              uint64_t Result = ::syscall(SYSCALL_DEF(preadv2), fd, Host_iovec.data(), iovcnt, pos_low, pos_high, flags);
+                              uint64_t Result = ::syscall(SYSCALL_DEF(preadv2), fd, Host_iovec, iovcnt, pos_low, pos_high, flags);
                               SYSCALL_ERRNO();
                             });
 
   REGISTER_SYSCALL_IMPL_X32(pwritev2,
                             [](FEXCore::Core::CpuStateFrame* Frame, int fd, const struct iovec32* iov, uint32_t iovcnt, uint32_t pos_low,
                                uint32_t pos_high, int flags) -> uint64_t {
+                              ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
                               FaultSafeUserMemAccess::VerifyIsReadable(iov, sizeof(struct iovec32) * SanitizeIOCount(iovcnt));
-                              fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+                              auto Host_iovec = Scratch.Convert<iovec>(iov, SanitizeIOCount(iovcnt));
 
-                              uint64_t Result = ::syscall(SYSCALL_DEF(pwritev2), fd, Host_iovec.data(), iovcnt, pos_low, pos_high, flags);
+                              uint64_t Result = ::syscall(SYSCALL_DEF(pwritev2), fd, Host_iovec, iovcnt, pos_low, pos_high, flags);
                               SYSCALL_ERRNO();
                             });
 
@@ -829,9 +835,10 @@ void RegisterFD(FEX::HLE::SyscallHandler* Handler) {
 
   REGISTER_SYSCALL_IMPL_X32(
     vmsplice, [](FEXCore::Core::CpuStateFrame* Frame, int fd, const struct iovec32* iov, unsigned long nr_segs, unsigned int flags) -> uint64_t {
+      ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
       FaultSafeUserMemAccess::VerifyIsReadable(iov, sizeof(struct iovec32) * SanitizeIOCount(nr_segs));
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(nr_segs));
-      uint64_t Result = ::vmsplice(fd, Host_iovec.data(), nr_segs, flags);
+      auto Host_iovec = Scratch.Convert<iovec>(iov, SanitizeIOCount(nr_segs));
+      uint64_t Result = ::vmsplice(fd, Host_iovec, nr_segs, flags);
       SYSCALL_ERRNO();
     });
 
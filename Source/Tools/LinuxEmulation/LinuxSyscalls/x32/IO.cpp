@@ -46,5 +46,10 @@ void RegisterIO(FEX::HLE::SyscallHandler* Handler) {
                               uint64_t Result = ::syscall(SYSCALL_DEF(io_pgetevents), ctx_id, min_nr, nr, events, timeout_ptr, usig);
                               SYSCALL_ERRNO();
                             });
+
+  // io_uring passes pointers and structures with 64-bit layouts around in its queues, which would all need to be translated.
+  REGISTER_SYSCALL_IMPL_X32(io_uring_setup, UnimplementedSyscallSafe);
+  REGISTER_SYSCALL_IMPL_X32(io_uring_enter, UnimplementedSyscallSafe);
+  REGISTER_SYSCALL_IMPL_X32(io_uring_register, UnimplementedSyscallSafe);
 }
 } // namespace FEX::HLE::x32
@@ -5,6 +5,7 @@ tags: LinuxSyscalls|syscalls-x86-32
 $end_info$
 */
 
+#include "LinuxSyscalls/ScratchArena.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
@@ -134,17 +135,15 @@ enum SockOp {
   OP_SENDMMSG = 20,
 };
 
-static uint64_t SendMsg(int sockfd, const struct msghdr32* msg, int flags) {
+static uint64_t SendMsg(FEXCore::Core::CpuStateFrame* Frame, int sockfd, const struct msghdr32* msg, int flags) {
+  ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
   struct msghdr HostHeader {};
-  fextl::vector<iovec> Host_iovec(msg->msg_iovlen);
-  for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-    Host_iovec[i] = msg->msg_iov[i];
-  }
+  auto Host_iovec = Scratch.Convert<iovec>(static_cast<const iovec32*>(msg->msg_iov), msg->msg_iovlen);
 
   HostHeader.msg_name = msg->msg_name;
   HostHeader.msg_namelen = msg->msg_namelen;
 
-  HostHeader.msg_iov = Host_iovec.data();
+  HostHeader.msg_iov = Host_iovec;
   HostHeader.msg_iovlen = msg->msg_iovlen;
 
   HostHeader.msg_control = alloca(msg->msg_controllen * 2);
@@ -188,17 +187,15 @@ static uint64_t SendMsg(int sockfd, const struct msghdr32* msg, int flags) {
   SYSCALL_ERRNO();
 }
 
-static uint64_t RecvMsg(int sockfd, struct msghdr32* msg, int flags) {
+static uint64_t RecvMsg(FEXCore::Core::CpuStateFrame* Frame, int sockfd, struct msghdr32* msg, int flags) {
+  ScratchArena::Scope Scratch {FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame)->SyscallScratch};
   struct msghdr HostHeader {};
-  fextl::vector<iovec> Host_iovec(msg->msg_iovlen);
-  for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-    Host_iovec[i] = msg->msg_iov[i];
-  }
+  auto Host_iovec = Scratch.Convert<iovec>(static_cast<const iovec32*>(msg->msg_iov), msg->msg_iovlen);
 
   HostHeader.msg_name = msg->msg_name;
   HostHeader.msg_namelen = msg->msg_namelen;
 
-  HostHeader.msg_iov = Host_iovec.data();
+  HostHeader.msg_iov = Host_iovec;
   HostHeader.msg_iovlen = msg->msg_iovlen;
 
   HostHeader.msg_control = alloca(msg->msg_controllen * 2);
@@ -718,11 +715,11 @@ void RegisterSocket(FEX::HLE::SyscallHandler* Handler) {
       break;
     }
     case OP_SENDMSG: {
-      return SendMsg(Arguments[0], reinterpret_cast<const struct msghdr32*>(Arguments[1]), Arguments[2]);
+      return SendMsg(Frame, Arguments[0], reinterpret_cast<const struct msghdr32*>(Arguments[1]), Arguments[2]);
       break;
     }
     case OP_RECVMSG: {
-      return RecvMsg(Arguments[0], reinterpret_cast<struct msghdr32*>(Arguments[1]), Arguments[2]);
+      return RecvMsg(Frame, Arguments[0], reinterpret_cast<struct msghdr32*>(Arguments[1]), Arguments[2]);
       break;
     }
     case OP_ACCEPT4: {
@@ -757,7 +754,7 @@ void RegisterSocket(FEX::HLE::SyscallHandler* Handler) {
   });
 
   REGISTER_SYSCALL_IMPL_X32(sendmsg, [](FEXCore::Core::CpuStateFrame* Frame, int sockfd, const struct msghdr32* msg, int flags) -> uint64_t {
-    return SendMsg(sockfd, msg, flags);
+    return SendMsg(Frame, sockfd, msg, flags);
   });
 
   REGISTER_SYSCALL_IMPL_X32(sendmmsg,
@@ -788,7 +785,7 @@ void RegisterSocket(FEX::HLE::SyscallHandler* Handler) {
                                struct timespec* timeout_ts) -> uint64_t { return RecvMMsg(sockfd, msgvec, vlen, flags, timeout_ts); });
 
   REGISTER_SYSCALL_IMPL_X32(recvmsg, [](FEXCore::Core::CpuStateFrame* Frame, int sockfd, struct msghdr32* msg, int flags) -> uint64_t {
-    return RecvMsg(sockfd, msg, flags);
+    return RecvMsg(Frame, sockfd, msg, flags);
   });
 
   REGISTER_SYSCALL_IMPL_X32(setsockopt,
@@ -56,13 +56,14 @@ public:
 #ifdef DEBUG_STRACE
                           const fextl::string& TraceFormatString,
 #endif
-                          void* SyscallHandler, int ArgumentCount) override {
+                          void* SyscallHandler, int ArgumentCount, int32_t HostSyscallNumber) override {
     auto& Def = Definitions.at(SyscallNumber);
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
     LOGMAN_THROW_A_FMT(Def.Ptr == reinterpret_cast<void*>(&UnimplementedSyscall), "Oops overwriting sysall problem, {}", SyscallNumber);
 #endif
     Def.Ptr = SyscallHandler;
     Def.NumArgs = ArgumentCount;
+    Def.HostSyscallNumber = HostSyscallNumber;
 #ifdef DEBUG_STRACE
     Def.StraceFmt = TraceFormatString;
 #endif
@@ -103,7 +104,8 @@ fextl::unique_ptr<FEX::HLE::SyscallHandler> CreateHandler(FEXCore::Context::Cont
 // Deduces return, args... from the function passed
 // Does not work with lambas, because they are objects with operator (), not functions
 template<typename R, typename... Args>
-void RegisterSyscall(SyscallHandler* Handler, int SyscallNumber, const char* Name, R (*fn)(FEXCore::Core::CpuStateFrame* Frame, Args...)) {
+void RegisterSyscall(SyscallHandler* Handler, int SyscallNumber, const char* Name, R (*fn)(FEXCore::Core::CpuStateFrame* Frame, Args...),
+                     int32_t HostSyscallNumber = -1) {
 #ifdef DEBUG_STRACE
   auto TraceFormatString = fextl::string(Name) + "(" + CollectArgsFmtString<Args...>() + ") = {}";
 #endif
@@ -111,15 +113,15 @@ void RegisterSyscall(SyscallHandler* Handler, int SyscallNumber, const char* Nam
 #ifdef DEBUG_STRACE
                               TraceFormatString,
 #endif
-                              reinterpret_cast<void*>(fn), sizeof...(Args));
+                              reinterpret_cast<void*>(fn), sizeof...(Args), HostSyscallNumber);
 }
 
 // Generic RegisterSyscall for lambdas
 // Non-capturing lambdas can be cast to function pointers, but this does not happen on argument matching
 // This is some glue logic that will cast a lambda and call the base RegisterSyscall implementation
 template<class F>
-void RegisterSyscall(SyscallHandler* _Handler, int num, const char* name, F f) {
-  RegisterSyscall(_Handler, num, name, +f);
+void RegisterSyscall(SyscallHandler* _Handler, int num, const char* name, F f, int32_t HostSyscallNumber = -1) {
+  RegisterSyscall(_Handler, num, name, +f, HostSyscallNumber);
 }
 
 } // namespace FEX::HLE::x32
@@ -129,3 +131,10 @@ void RegisterSyscall(SyscallHandler* _Handler, int num, const char* name, F f) {
   do {                                                                               \
     FEX::HLE::x32::RegisterSyscall(Handler, x32::SYSCALL_x86_##name, #name, lambda); \
   } while (false)
+
+// Registers a syscall for 32bit only that is passed through to the host syscall host_name
+#define REGISTER_SYSCALL_PASSTHROUGH_X32(name, host_name, argc)                                                               \
+  do {                                                                                                                        \
+    FEX::HLE::x32::RegisterSyscall(Handler, x32::SYSCALL_x86_##name, #name, SyscallPassthrough##argc<SYSCALL_DEF(host_name)>, \
+                                   SYSCALL_DEF(host_name));                                                                   \
+  } while (false)
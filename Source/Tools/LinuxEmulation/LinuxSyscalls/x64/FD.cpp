@@ -129,6 +129,9 @@ void RegisterFD(FEX::HLE::SyscallHandler* Handler) {
 
   REGISTER_SYSCALL_IMPL_X64(dup2, [](FEXCore::Core::CpuStateFrame* Frame, int oldfd, int newfd) -> uint64_t {
     uint64_t Result = ::dup2(oldfd, newfd);
+    if (Result != -1 && oldfd != newfd) {
+      FEX::HLE::_SyscallHandler->IoUrings.CloseFD(Frame->Thread, newfd);
+    }
     SYSCALL_ERRNO();
   });
 
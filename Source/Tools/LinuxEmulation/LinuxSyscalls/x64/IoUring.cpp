@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|syscalls-x86-64
+$end_info$
+*/
+
+#include "LinuxSyscalls/IoUring.h"
+#include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/x64/Syscalls.h"
+
+#include <cstdint>
+#include <linux/io_uring.h>
+
+namespace FEX::HLE::x64 {
+void RegisterIoUring(FEX::HLE::SyscallHandler* Handler) {
+  REGISTER_SYSCALL_IMPL_X64(io_uring_setup, [](FEXCore::Core::CpuStateFrame* Frame, uint32_t entries, io_uring_params* p) -> uint64_t {
+    return FEX::HLE::_SyscallHandler->IoUrings.Setup(Frame->Thread, entries, p);
+  });
+
+  REGISTER_SYSCALL_IMPL_X64(io_uring_enter,
+                            [](FEXCore::Core::CpuStateFrame* Frame, int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags,
+                               const void* argp, size_t argsz) -> uint64_t {
+                              auto& IoUrings = FEX::HLE::_SyscallHandler->IoUrings;
+                              return IoUrings.Enter(Frame->Thread, fd, to_submit, min_complete, flags, argp, argsz);
+                            });
+
+  REGISTER_SYSCALL_IMPL_X64(
+    io_uring_register, [](FEXCore::Core::CpuStateFrame* Frame, int fd, uint32_t opcode, void* arg, uint32_t nr_args) -> uint64_t {
+      return FEX::HLE::_SyscallHandler->IoUrings.Register(Frame->Thread, fd, opcode, arg, nr_args);
+    });
+}
+} // namespace FEX::HLE::x64
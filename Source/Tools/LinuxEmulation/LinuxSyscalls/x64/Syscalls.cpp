@@ -37,6 +37,7 @@ void x64SyscallHandler::RegisterSyscallHandlers() {
   FEX::HLE::x64::RegisterEpoll(this);
   FEX::HLE::x64::RegisterFD(this);
   FEX::HLE::x64::RegisterInfo(this);
+  FEX::HLE::x64::RegisterIoUring(this);
   FEX::HLE::x64::RegisterMemory(this);
   FEX::HLE::x64::RegisterSemaphore(this);
   FEX::HLE::x64::RegisterSignals(this);
@@ -47,13 +47,14 @@ public:
 #ifdef DEBUG_STRACE
                           const fextl::string& TraceFormatString,
 #endif
-                          void* SyscallHandler, int ArgumentCount) override {
+                          void* SyscallHandler, int ArgumentCount, int32_t HostSyscallNumber) override {
     auto& Def = Definitions.at(SyscallNumber);
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
     LOGMAN_THROW_A_FMT(Def.Ptr == reinterpret_cast<void*>(&UnimplementedSyscall), "Oops overwriting sysall problem, {}", SyscallNumber);
 #endif
     Def.Ptr = SyscallHandler;
     Def.NumArgs = ArgumentCount;
+    Def.HostSyscallNumber = HostSyscallNumber;
 #ifdef DEBUG_STRACE
     Def.StraceFmt = TraceFormatString;
 #endif
@@ -76,7 +77,8 @@ CreateHandler(FEXCore::Context::Context* ctx, FEX::HLE::SignalDelegator* _Signal
 // Deduces return, args... from the function passed
 // Does not work with lambas, because they are objects with operator (), not functions
 template<typename R, typename... Args>
-void RegisterSyscall(SyscallHandler* Handler, int SyscallNumber, const char* Name, R (*fn)(FEXCore::Core::CpuStateFrame* Frame, Args...)) {
+void RegisterSyscall(SyscallHandler* Handler, int SyscallNumber, const char* Name, R (*fn)(FEXCore::Core::CpuStateFrame* Frame, Args...),
+                     int32_t HostSyscallNumber = -1) {
 #ifdef DEBUG_STRACE
   auto TraceFormatString = fextl::string(Name) + "(" + CollectArgsFmtString<Args...>() + ") = {}";
 #endif
@@ -84,20 +86,21 @@ void RegisterSyscall(SyscallHandler* Handler, int SyscallNumber, const char* Nam
 #ifdef DEBUG_STRACE
                               TraceFormatString,
 #endif
-                              reinterpret_cast<void*>(fn), sizeof...(Args));
+                              reinterpret_cast<void*>(fn), sizeof...(Args), HostSyscallNumber);
 }
 
 // Generic RegisterSyscall for lambdas
 // Non-capturing lambdas can be cast to function pointers, but this does not happen on argument matching
 // This is some glue logic that will cast a lambda and call the base RegisterSyscall implementation
 template<class F>
-void RegisterSyscall(SyscallHandler* _Handler, int num, const char* name, F f) {
-  RegisterSyscall(_Handler, num, name, +f);
+void RegisterSyscall(SyscallHandler* _Handler, int num, const char* name, F f, int32_t HostSyscallNumber = -1) {
+  RegisterSyscall(_Handler, num, name, +f, HostSyscallNumber);
 }
 
 void RegisterEpoll(FEX::HLE::SyscallHandler* Handler);
 void RegisterFD(FEX::HLE::SyscallHandler* Handler);
 void RegisterInfo(FEX::HLE::SyscallHandler* Handler);
+void RegisterIoUring(FEX::HLE::SyscallHandler* Handler);
 void RegisterMemory(FEX::HLE::SyscallHandler* Handler);
 void RegisterNotImplemented(FEX::HLE::SyscallHandler* Handler);
 void RegisterPassthrough(FEX::HLE::SyscallHandler* Handler);
@@ -113,3 +116,10 @@ void RegisterTime(FEX::HLE::SyscallHandler* Handler);
   do {                                                                                 \
     FEX::HLE::x64::RegisterSyscall(Handler, x64::SYSCALL_x64_##name, #name, (lambda)); \
   } while (false)
+
+// Registers a syscall for 64bit only that is passed through to the host syscall of the same name
+#define REGISTER_SYSCALL_PASSTHROUGH_X64(name, argc)                                                                     \
+  do {                                                                                                                   \
+    FEX::HLE::x64::RegisterSyscall(Handler, x64::SYSCALL_x64_##name, #name, SyscallPassthrough##argc<SYSCALL_DEF(name)>, \
+                                   SYSCALL_DEF(name));                                                                   \
+  } while (false)
@@ -234,8 +234,7 @@ void ImageTracker::LoadAOTImages(MappedImageInfo& ImageInfo) {
   }
 
   auto ID = FEXCore::CodeMap::GetBaseFilename(ImageInfo.Info, false);
-  const uint64_t CodeCacheConfigId = 0; // TODO
-  const auto AnsiPath = fmt::format("\\??\\{}cache\\{}-{:016x}", FEX::Config::GetCacheDirectory(), ID, CodeCacheConfigId);
+  const auto AnsiPath = fmt::format("\\??\\{}cache\\{}-{:016x}", FEX::Config::GetCacheDirectory(), ID, CTX.GetCodeCache().GetConfigId());
 
   IO_STATUS_BLOCK IOSB;
   ScopedUnicodeString CurrentFileName(AnsiPath.c_str());
@@ -870,7 +870,7 @@ bool BTCpuResetToConsistentStateImpl(EXCEPTION_POINTERS* Ptrs) {
   auto* Exception = Ptrs->ExceptionRecord;
   auto TLS = GetTLS();
   auto Thread = TLS.ThreadState();
-  FEXCORE_PROFILE_ACCUMULATION(Thread, AccumulatedSignalTime);
+  FEXCORE_PROFILE_ACCUMULATION_HISTOGRAM(Thread, AccumulatedSignalTime, SignalTimeHistogram);
 
   if (Exception->ExceptionCode == EXCEPTION_ACCESS_VIOLATION) {
     const auto FaultAddress = static_cast<uint64_t>(Exception->ExceptionInformation[1]);
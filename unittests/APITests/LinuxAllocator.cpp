@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: MIT
+#include <catch2/catch_all.hpp>
+#include "LinuxSyscalls/LinuxAllocator.h"
+
+#include <FEXCore/Utils/TypeDefines.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <sys/mman.h>
+
+namespace {
+constexpr size_t LENGTH = 4 * FEXCore::Utils::FEX_PAGE_SIZE;
+constexpr int PROT = PROT_READ | PROT_WRITE;
+constexpr int FLAGS = MAP_PRIVATE | MAP_ANONYMOUS;
+
+bool IsError(void* Ptr) {
+  return reinterpret_cast<uintptr_t>(Ptr) >= static_cast<uintptr_t>(-4095);
+}
+
+bool Overlaps(void* A, void* B, size_t Length) {
+  const auto a = reinterpret_cast<uintptr_t>(A);
+  const auto b = reinterpret_cast<uintptr_t>(B);
+  return a < b + Length && b < a + Length;
+}
+} // anonymous namespace
+
+TEST_CASE("Below4GB") {
+  auto Allocator = FEX::HLE::Create32BitAllocator();
+
+  auto Ptr = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+  REQUIRE_FALSE(IsError(Ptr));
+  CHECK(reinterpret_cast<uintptr_t>(Ptr) + LENGTH <= 0x1'0000'0000ULL);
+  CHECK((reinterpret_cast<uintptr_t>(Ptr) & ~FEXCore::Utils::FEX_PAGE_MASK) == 0);
+
+  // The memory must actually be backed
+  static_cast<uint8_t*>(Ptr)[0] = 1;
+  static_cast<uint8_t*>(Ptr)[LENGTH - 1] = 1;
+  CHECK(Allocator->Munmap(Ptr, LENGTH) == 0);
+}
+
+TEST_CASE("Map32Bit") {
+  auto Allocator = FEX::HLE::Create32BitAllocator();
+
+  auto Ptr = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS | FEX::HLE::X86_64_MAP_32BIT, -1, 0);
+  REQUIRE_FALSE(IsError(Ptr));
+  CHECK(reinterpret_cast<uintptr_t>(Ptr) + LENGTH <= 0x8000'0000ULL);
+  CHECK(Allocator->Munmap(Ptr, LENGTH) == 0);
+}
+
+TEST_CASE("DistinctAllocations") {
+  auto Allocator = FEX::HLE::Create32BitAllocator();
+
+  void* Ptrs[8];
+  for (auto& Ptr : Ptrs) {
+    Ptr = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+    REQUIRE_FALSE(IsError(Ptr));
+  }
+
+  for (size_t i = 0; i < std::size(Ptrs); ++i) {
+    for (size_t j = i + 1; j < std::size(Ptrs); ++j) {
+      CHECK_FALSE(Overlaps(Ptrs[i], Ptrs[j], LENGTH));
+    }
+  }
+
+  for (auto Ptr : Ptrs) {
+    CHECK(Allocator->Munmap(Ptr, LENGTH) == 0);
+  }
+}
+
+TEST_CASE("ReuseHole") {
+  auto Allocator = FEX::HLE::Create32BitAllocator();
+
+  auto Upper = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+  auto Middle = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+  auto Lower = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+  REQUIRE_FALSE(IsError(Upper));
+  REQUIRE_FALSE(IsError(Middle));
+  REQUIRE_FALSE(IsError(Lower));
+
+  // Freeing the middle allocation leaves a hole that fits the next allocation of the same size exactly
+  REQUIRE(Allocator->Munmap(Middle, LENGTH) == 0);
+  auto Reused = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+  CHECK(Reused == Middle);
+
+  // Larger allocations don't fit in the hole
+  REQUIRE(Allocator->Munmap(Reused, LENGTH) == 0);
+  auto Larger = Allocator->Mmap(nullptr, LENGTH * 2, PROT, FLAGS, -1, 0);
+  REQUIRE_FALSE(IsError(Larger));
+  CHECK_FALSE(Overlaps(Larger, Middle, LENGTH * 2));
+
+  CHECK(Allocator->Munmap(Larger, LENGTH * 2) == 0);
+  CHECK(Allocator->Munmap(Upper, LENGTH) == 0);
+  CHECK(Allocator->Munmap(Lower, LENGTH) == 0);
+}
+
+TEST_CASE("ForeignMapping") {
+  auto Allocator = FEX::HLE::Create32BitAllocator();
+
+  // Find where the next allocation would go, then map something there behind the allocator's back
+  auto Probe = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+  REQUIRE_FALSE(IsError(Probe));
+  REQUIRE(Allocator->Munmap(Probe, LENGTH) == 0);
+
+  constexpr int FEX_MAP_FIXED_NOREPLACE = 0x100000;
+  auto Foreign = ::mmap(Probe, LENGTH, PROT, FLAGS | FEX_MAP_FIXED_NOREPLACE, -1, 0);
+  REQUIRE(Foreign == Probe);
+  static_cast<uint8_t*>(Foreign)[0] = 0xAA;
+
+  // The allocator must skip over the unknown mapping instead of failing or clobbering it
+  auto Ptr = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+  REQUIRE_FALSE(IsError(Ptr));
+  CHECK_FALSE(Overlaps(Ptr, Foreign, LENGTH));
+  CHECK(static_cast<uint8_t*>(Foreign)[0] == 0xAA);
+
+  // Once known, the range stays skipped
+  auto Next = Allocator->Mmap(nullptr, LENGTH, PROT, FLAGS, -1, 0);
+  REQUIRE_FALSE(IsError(Next));
+  CHECK_FALSE(Overlaps(Next, Foreign, LENGTH));
+
+  CHECK(Allocator->Munmap(Ptr, LENGTH) == 0);
+  CHECK(Allocator->Munmap(Next, LENGTH) == 0);
+  ::munmap(Foreign, LENGTH);
+}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+#include <catch2/catch_all.hpp>
+#include "LinuxSyscalls/RootFSLookupCache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+struct Fixture {
+  Fixture() {
+    REQUIRE(mkdtemp(RootFS) != nullptr);
+    std::filesystem::create_directories(std::filesystem::path(RootFS) / "usr/lib");
+    std::ofstream(std::filesystem::path(RootFS) / "usr/file");
+    std::filesystem::create_directory_symlink("usr", std::filesystem::path(RootFS) / "link");
+
+    RootFSFD = open(RootFS, O_DIRECTORY | O_PATH | O_CLOEXEC);
+    REQUIRE(RootFSFD != -1);
+    Cache.Enable(RootFSFD);
+  }
+
+  ~Fixture() {
+    close(RootFSFD);
+    std::filesystem::remove_all(RootFS);
+  }
+
+  char RootFS[64] = P_tmpdir "/rootfstestXXXXXX";
+  int RootFSFD;
+  FEX::HLE::RootFSLookupCache Cache;
+};
+} // anonymous namespace
+
+TEST_CASE("Disabled") {
+  FEX::HLE::RootFSLookupCache Cache;
+  CHECK_FALSE(Cache.IsMissing("nothere"));
+  CHECK_FALSE(Cache.IsMissing("nothere/either"));
+}
+
+TEST_CASE_METHOD(Fixture, "Existing") {
+  CHECK_FALSE(Cache.IsMissing("usr"));
+  CHECK_FALSE(Cache.IsMissing("usr/lib"));
+  CHECK_FALSE(Cache.IsMissing("usr/lib/"));
+  CHECK_FALSE(Cache.IsMissing("usr//lib"));
+  CHECK_FALSE(Cache.IsMissing("usr/file"));
+
+  // Asking again must give the same answer from the cache
+  CHECK_FALSE(Cache.IsMissing("usr/lib"));
+}
+
+TEST_CASE_METHOD(Fixture, "Missing") {
+  CHECK(Cache.IsMissing("nothere"));
+  CHECK(Cache.IsMissing("nothere/either"));
+  CHECK(Cache.IsMissing("usr/nothere"));
+  CHECK(Cache.IsMissing("usr/lib/nothere/either"));
+  CHECK(Cache.IsMissing("./nothere"));
+  CHECK(Cache.IsMissing("usr/./nothere"));
+}
+
+TEST_CASE_METHOD(Fixture, "WalkStops") {
+  // Anything beneath a file or symlink isn't resolved by the cache
+  CHECK_FALSE(Cache.IsMissing("usr/file/nothere"));
+  CHECK_FALSE(Cache.IsMissing("link/nothere"));
+
+  // Neither is anything after a parent directory reference, but a missing component before it still fails the lookup
+  CHECK_FALSE(Cache.IsMissing("usr/../nothere"));
+  CHECK(Cache.IsMissing("nothere/../usr"));
+}
+
+TEST_CASE_METHOD(Fixture, "NotInvalidated") {
+  // The cache is only used for read-only RootFS images, so a missing path stays missing once it's been seen
+  CHECK(Cache.IsMissing("later/file"));
+  std::filesystem::create_directory(std::filesystem::path(RootFS) / "later");
+  CHECK(Cache.IsMissing("later/file"));
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+#include <catch2/catch_all.hpp>
+#include "LinuxSyscalls/ScratchArena.h"
+#include "LinuxSyscalls/x32/Types.h"
+
+#include <cstdint>
+#include <sys/uio.h>
+
+using FEX::HLE::ScratchArena;
+
+TEST_CASE("ConvertIovec") {
+  ScratchArena Arena;
+  ScratchArena::Scope Scope(Arena);
+
+  const FEX::HLE::x32::iovec32 Guest[] = {
+    iovec {reinterpret_cast<void*>(0x1000), 0x10},
+    iovec {reinterpret_cast<void*>(0xffff'f000), 0xffff'ffff},
+    iovec {nullptr, 0},
+  };
+
+  auto Host = Scope.Convert<iovec>(Guest, std::size(Guest));
+  REQUIRE(reinterpret_cast<uintptr_t>(Host) % alignof(iovec) == 0);
+
+  CHECK(Host[0].iov_base == reinterpret_cast<void*>(0x1000));
+  CHECK(Host[0].iov_len == 0x10);
+  CHECK(Host[1].iov_base == reinterpret_cast<void*>(0xffff'f000));
+  CHECK(Host[1].iov_len == 0xffff'ffff);
+  CHECK(Host[2].iov_base == nullptr);
+  CHECK(Host[2].iov_len == 0);
+}
+
+TEST_CASE("NestedScopes") {
+  ScratchArena Arena;
+  ScratchArena::Scope Outer(Arena);
+  auto First = Outer.Allocate<uint8_t>(3);
+
+  uint64_t* Inner {};
+  {
+    ScratchArena::Scope Nested(Arena);
+    Inner = Nested.Allocate<uint64_t>(4);
+
+    // Allocations in the nested scope mustn't overlap the outer one and must still be aligned
+    CHECK(reinterpret_cast<uintptr_t>(Inner) % alignof(uint64_t) == 0);
+    CHECK(reinterpret_cast<uintptr_t>(Inner) >= reinterpret_cast<uintptr_t>(First + 3));
+  }
+
+  // Ending the nested scope releases its allocations for reuse
+  ScratchArena::Scope Nested(Arena);
+  CHECK(Nested.Allocate<uint64_t>(4) == Inner);
+}
+
+TEST_CASE("HeapFallback") {
+  ScratchArena Arena;
+  ScratchArena::Scope Scope(Arena);
+
+  auto Small = Scope.Allocate<uint8_t>(16);
+  auto Large = Scope.Allocate<uint8_t>(ScratchArena::SIZE + 1);
+  REQUIRE(Large != nullptr);
+
+  // The oversized allocation mustn't come out of the arena
+  CHECK((Large + ScratchArena::SIZE + 1 <= Small || Large >= Small + ScratchArena::SIZE));
+  Large[0] = 1;
+  Large[ScratchArena::SIZE] = 2;
+
+  // Later small allocations keep using the arena
+  auto Next = Scope.Allocate<uint8_t>(16);
+  CHECK(Next == Small + 16);
+}
+
+TEST_CASE("Exhaustion") {
+  ScratchArena Arena;
+  ScratchArena::Scope Scope(Arena);
+
+  auto Full = Scope.Allocate<uint8_t>(ScratchArena::SIZE);
+  auto Overflow = Scope.Allocate<uint32_t>(1);
+  REQUIRE(Overflow != nullptr);
+  CHECK((reinterpret_cast<uint8_t*>(Overflow) < Full || reinterpret_cast<uint8_t*>(Overflow) >= Full + ScratchArena::SIZE));
+  *Overflow = 0;
+}
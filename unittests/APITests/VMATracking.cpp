@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: MIT
+#include <catch2/catch_all.hpp>
+#include "LinuxSyscalls/SyscallsVMATracking.h"
+
+#include <mutex>
+#include <sys/mman.h>
+
+using namespace FEX::HLE::VMATracking;
+
+namespace {
+constexpr uintptr_t BASE = 0x10'0000;
+constexpr uintptr_t LENGTH = 0x4000;
+
+struct Fixture {
+  Fixture()
+    : Lock {Tracking.Mutex} {}
+
+  // Every modification must be visible to threads that cached a VMA from before it
+  template<typename F>
+  bool BumpsGeneration(F&& Modify) {
+    const auto Before = Tracking.Generation.load();
+    Modify();
+    return Tracking.Generation.load() != Before;
+  }
+
+  VMATracking Tracking;
+  std::unique_lock<FEXCore::ForkableSharedMutex> Lock;
+};
+} // anonymous namespace
+
+TEST_CASE_METHOD(Fixture, "Track") {
+  CHECK(BumpsGeneration([&] {
+    Tracking.TrackVMARange(nullptr, nullptr, BASE, 0, LENGTH, VMAFlags::fromFlags(MAP_PRIVATE), VMAProt::fromProt(PROT_READ | PROT_EXEC));
+  }));
+
+  auto Entry = Tracking.FindVMAEntry(BASE + LENGTH - 1);
+  REQUIRE(Entry != Tracking.VMAs.end());
+  CHECK(Entry->first == BASE);
+  CHECK(Entry->second.Length == LENGTH);
+  CHECK(Entry->second.Prot.Executable);
+}
+
+TEST_CASE_METHOD(Fixture, "Protect") {
+  Tracking.TrackVMARange(nullptr, nullptr, BASE, 0, LENGTH, VMAFlags::fromFlags(MAP_PRIVATE), VMAProt::fromProt(PROT_READ | PROT_EXEC));
+
+  // Splitting a VMA changes the range a cached copy of it covers
+  CHECK(BumpsGeneration([&] { Tracking.ChangeProtectionFlags(BASE + 0x1000, 0x1000, VMAProt::fromProt(PROT_READ | PROT_WRITE)); }));
+
+  auto Entry = Tracking.FindVMAEntry(BASE);
+  REQUIRE(Entry != Tracking.VMAs.end());
+  CHECK(Entry->second.Length == 0x1000);
+  CHECK(Entry->second.Prot.Executable);
+
+  Entry = Tracking.FindVMAEntry(BASE + 0x1000);
+  REQUIRE(Entry != Tracking.VMAs.end());
+  CHECK(Entry->first == BASE + 0x1000);
+  CHECK(Entry->second.Prot.Writable);
+  CHECK_FALSE(Entry->second.Prot.Executable);
+}
+
+TEST_CASE_METHOD(Fixture, "Delete") {
+  Tracking.TrackVMARange(nullptr, nullptr, BASE, 0, LENGTH, VMAFlags::fromFlags(MAP_PRIVATE), VMAProt::fromProt(PROT_READ | PROT_EXEC));
+
+  CHECK(BumpsGeneration([&] { Tracking.DeleteVMARange(nullptr, BASE, LENGTH); }));
+  CHECK(Tracking.FindVMAEntry(BASE) == Tracking.VMAs.end());
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <linux/openat2.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Minimal io_uring with a single submission in flight, so the open flags reach FEX exactly as written here
+struct Ring {
+  Ring() {
+    FD = ::syscall(SYS_io_uring_setup, 4, &Params);
+    if (FD == -1) {
+      return;
+    }
+
+    SQSize = Params.sq_off.array + Params.sq_entries * sizeof(uint32_t);
+    CQSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+    SQ = static_cast<uint8_t*>(::mmap(nullptr, SQSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_SQ_RING));
+    CQ = static_cast<uint8_t*>(::mmap(nullptr, CQSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_CQ_RING));
+    SQEs = static_cast<io_uring_sqe*>(::mmap(nullptr, Params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                                             MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_SQES));
+    REQUIRE(SQ != MAP_FAILED);
+    REQUIRE(CQ != MAP_FAILED);
+    REQUIRE(SQEs != MAP_FAILED);
+  }
+
+  ~Ring() {
+    if (FD != -1) {
+      ::munmap(SQEs, Params.sq_entries * sizeof(io_uring_sqe));
+      ::munmap(CQ, CQSize);
+      ::munmap(SQ, SQSize);
+      ::close(FD);
+    }
+  }
+
+  template<typename T>
+  std::atomic_ref<T> At(uint8_t* Base, uint32_t Offset) {
+    return std::atomic_ref<T>(*reinterpret_cast<T*>(Base + Offset));
+  }
+
+  // Returns the result of the completed SQE
+  int32_t Submit(const io_uring_sqe& SQE) {
+    const uint32_t Tail = At<uint32_t>(SQ, Params.sq_off.tail).load(std::memory_order_relaxed);
+    const uint32_t Index = Tail & At<uint32_t>(SQ, Params.sq_off.ring_mask).load(std::memory_order_relaxed);
+    SQEs[Index] = SQE;
+    reinterpret_cast<uint32_t*>(SQ + Params.sq_off.array)[Index] = Index;
+    At<uint32_t>(SQ, Params.sq_off.tail).store(Tail + 1, std::memory_order_release);
+
+    REQUIRE(::syscall(SYS_io_uring_enter, FD, 1, 1, IORING_ENTER_GETEVENTS, nullptr, 0) == 1);
+
+    const uint32_t Head = At<uint32_t>(CQ, Params.cq_off.head).load(std::memory_order_relaxed);
+    REQUIRE(At<uint32_t>(CQ, Params.cq_off.tail).load(std::memory_order_acquire) != Head);
+    const uint32_t CQIndex = Head & At<uint32_t>(CQ, Params.cq_off.ring_mask).load(std::memory_order_relaxed);
+    const int32_t Result = reinterpret_cast<io_uring_cqe*>(CQ + Params.cq_off.cqes)[CQIndex].res;
+    At<uint32_t>(CQ, Params.cq_off.head).store(Head + 1, std::memory_order_release);
+    return Result;
+  }
+
+  int32_t OpenAt(const std::string& Path, int Flags) {
+    io_uring_sqe SQE {};
+    SQE.opcode = IORING_OP_OPENAT;
+    SQE.fd = AT_FDCWD;
+    SQE.addr = reinterpret_cast<uint64_t>(Path.c_str());
+    SQE.open_flags = Flags;
+    return Submit(SQE);
+  }
+
+  int32_t OpenAt2(const std::string& Path, int Flags) {
+    open_how How {.flags = static_cast<uint64_t>(Flags)};
+    io_uring_sqe SQE {};
+    SQE.opcode = IORING_OP_OPENAT2;
+    SQE.fd = AT_FDCWD;
+    SQE.addr = reinterpret_cast<uint64_t>(Path.c_str());
+    SQE.addr2 = reinterpret_cast<uint64_t>(&How);
+    SQE.len = sizeof(How);
+    return Submit(SQE);
+  }
+
+  int FD;
+  io_uring_params Params {};
+  size_t SQSize {};
+  size_t CQSize {};
+  uint8_t* SQ {};
+  uint8_t* CQ {};
+  io_uring_sqe* SQEs {};
+};
+
+static void CheckDirectoryOpen(int32_t FD) {
+  REQUIRE(FD >= 0);
+  struct stat Buffer {};
+  CHECK(fstat(FD, &Buffer) == 0);
+  CHECK(S_ISDIR(Buffer.st_mode));
+  CHECK((fcntl(FD, F_GETFL) & O_DIRECT) == 0);
+  close(FD);
+}
+
+TEST_CASE("io_uring open flags") {
+  Ring Uring;
+  if (Uring.FD == -1) {
+    // Disabled by the host, through io_uring_disabled or seccomp
+    REQUIRE((errno == ENOSYS || errno == EPERM));
+    return;
+  }
+
+  char Dir[] = "/tmp/io_uring_openXXXXXX";
+  REQUIRE(mkdtemp(Dir) != nullptr);
+  const std::string Base = Dir;
+  const std::string File = Base + "/file";
+  const std::string Link = Base + "/link";
+  const int FileFD = open(File.c_str(), O_CREAT | O_WRONLY, 0600);
+  REQUIRE(FileFD >= 0);
+  close(FileFD);
+  REQUIRE(symlink(Base.c_str(), Link.c_str()) == 0);
+
+  constexpr int Flags = O_RDONLY | O_DIRECTORY | O_NOFOLLOW;
+
+  // Mixing up O_DIRECTORY with O_DIRECT and O_NOFOLLOW with O_LARGEFILE would open the directory behind the link
+  // and fail on the file for the wrong reason
+  CheckDirectoryOpen(Uring.OpenAt(Base, Flags));
+  CHECK(Uring.OpenAt(Link, Flags) == -ENOTDIR);
+  CHECK(Uring.OpenAt(Link, O_RDONLY | O_NOFOLLOW) == -ELOOP);
+  CHECK(Uring.OpenAt(File, Flags) == -ENOTDIR);
+
+  CheckDirectoryOpen(Uring.OpenAt2(Base, Flags));
+  CHECK(Uring.OpenAt2(Link, Flags) == -ENOTDIR);
+  CHECK(Uring.OpenAt2(Link, O_RDONLY | O_NOFOLLOW) == -ELOOP);
+  CHECK(Uring.OpenAt2(File, Flags) == -ENOTDIR);
+
+  unlink(Link.c_str());
+  unlink(File.c_str());
+  rmdir(Dir);
+}